@@ -0,0 +1,333 @@
+//
+// Betweenness centrality with Brandes' algorithm.
+//
+// The betweenness of a vertex v is the sum over all pairs of other vertices s,t of the fraction
+// of the shortest paths from s to t that pass through v. Brandes' algorithm finds it with one
+// search from each source s, which counts the shortest paths sigma(s,v) to every vertex and
+// records the order the vertices were settled in. The dependency of s on each vertex is then
+// accumulated in the reverse order:
+//    delta(s,v) = sum over edges v->w on a shortest path of sigma(s,v) / sigma(s,w) * (1 + delta(s,w))
+// and added to the betweenness of v. The edges on a shortest path are found again from the
+// distances (d(s,w) == d(s,v) + w(v,w)) rather than keeping a list of predecessors for every
+// vertex. betweenness_centrality uses a breadth-first search for unweighted graphs, in
+// O(|V||E|) time, and dijkstra_betweenness_centrality uses Dijkstra's algorithm for positive
+// edge weights, in O(|V||E| + |V|^2 log |V|) time.
+//
+// The searches from different sources are independent, so the ExecutionPolicy overloads run them
+// in parallel. Each task has a workspace with its own betweenness accumulator, and they're added
+// together at the end, so there's no contention on the result.
+//
+// For large graphs the betweenness can be approximated from a sample of num_pivots sources
+// chosen uniformly at random (Brandes & Pich), scaling the sum by |V| / num_pivots. The time is
+// proportional to the number of pivots.
+//
+// Each pair s,t is counted once for each direction, so the betweenness of undirected graphs is
+// twice the usual value.
+//
+
+#include <algorithm>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+
+#ifndef GRAPH_BETWEENNESS_CENTRALITY_HPP
+#  define GRAPH_BETWEENNESS_CENTRALITY_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of Brandes' algorithm.
+//!
+// clang-format off
+template <incidence_graph G, typename DistFnc, typename DistanceT, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class betweenness_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using distance_type  = DistanceT;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  static constexpr DistanceT null_distance = numeric_limits<DistanceT>::max();
+
+  //! The state of the search from one source, and the betweenness accumulated by a task.
+  class workspace {
+  public:
+    workspace(size_t const n, allocator_type alloc)
+          : distance_(n, null_distance, alloc)
+          , sigma_(n, 0.0, alloc)
+          , delta_(n, 0.0, alloc)
+          , order_(alloc)
+          , heap_(alloc)
+          , centrality_(n, 0.0, alloc) {}
+
+  private:
+    friend class betweenness_fn;
+    using heap_entry = pair<DistanceT, key_type>;
+
+    vector<DistanceT, typename allocator_traits<A>::template rebind_alloc<DistanceT>>   distance_;
+    vector<double, typename allocator_traits<A>::template rebind_alloc<double>>         sigma_; // shortest paths
+    vector<double, typename allocator_traits<A>::template rebind_alloc<double>>         delta_; // dependency
+    vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>     order_; // settled
+    vector<heap_entry, typename allocator_traits<A>::template rebind_alloc<heap_entry>> heap_;
+    vector<double, typename allocator_traits<A>::template rebind_alloc<double>>         centrality_;
+  };
+
+  //! weighted selects Dijkstra's algorithm; otherwise distance_fnc isn't used.
+  betweenness_fn(graph_type& g, DistFnc& distance_fnc, bool const weighted, allocator_type alloc = A())
+        : g_(g), distance_fnc_(distance_fnc), weighted_(weighted), alloc_(alloc) {}
+
+  //! Assign the betweenness of each vertex to centrality_iter[ukey], from all the sources or a
+  //! sample of num_pivots of them.
+  template <typename ExecutionPolicy, random_access_iterator CentralityIter>
+  void operator()(ExecutionPolicy&& policy, CentralityIter centrality_iter, size_t num_pivots, unsigned const seed) {
+    size_t const n = ranges::size(g_);
+    num_pivots     = min(num_pivots, n);
+    vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>> sources(n, alloc_);
+    iota(sources.begin(), sources.end(), key_type(0));
+    if (num_pivots < n) {
+      mt19937 gen(seed);
+      for (size_t i = 0; i < num_pivots; ++i) // partial Fisher-Yates shuffle
+        swap(sources[i], sources[uniform_int_distribution<size_t>(i, n - 1)(gen)]);
+    }
+    double const scale = num_pivots > 0 ? static_cast<double>(n) / static_cast<double>(num_pivots) : 0.0;
+
+    auto make_ws = [this, n]() { return workspace(n, alloc_); };
+    detail::workspace_pool<workspace, decltype(make_ws)> pool(make_ws);
+    detail::for_each_index(policy, size_t(0), num_pivots, [this, &pool, &sources, scale](size_t const i) {
+      auto ws = pool.acquire();
+      accumulate(*ws, sources[i], scale);
+    });
+
+    vector<workspace*> accumulators;
+    pool.for_each([&accumulators](workspace& ws) { accumulators.push_back(&ws); });
+    detail::for_each_index(policy, key_type(0), static_cast<key_type>(n), [&](key_type const ukey) {
+      double sum = 0.0;
+      for (workspace* ws : accumulators)
+        sum += ws->centrality_[ukey];
+      centrality_iter[static_cast<iter_difference_t<CentralityIter>>(ukey)] =
+            static_cast<iter_value_t<CentralityIter>>(sum);
+    });
+  }
+
+protected:
+  //! Search from source & add scale times its dependency on each vertex to ws.centrality_.
+  void accumulate(workspace& ws, key_type const source, double const scale) {
+    if (weighted_)
+      dijkstra(ws, source);
+    else
+      breadth_first(ws, source);
+
+    for (size_t i = ws.order_.size(); i-- > 0;) {
+      key_type const         vkey      = ws.order_[i];
+      double                 delta     = 0.0;
+      vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, vkey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const wkey = vertex_key(g_, uv, vkey);
+        if (ws.distance_[wkey] == next_distance(ws.distance_[vkey], *uv))
+          delta += ws.sigma_[vkey] / ws.sigma_[wkey] * (1.0 + ws.delta_[wkey]);
+      }
+      ws.delta_[vkey] = delta;
+      if (vkey != source)
+        ws.centrality_[vkey] += scale * delta;
+    }
+
+    for (key_type const vkey : ws.order_) {
+      ws.distance_[vkey] = null_distance;
+      ws.sigma_[vkey]    = 0.0;
+      ws.delta_[vkey]    = 0.0;
+    }
+    ws.order_.clear();
+  }
+
+  //! The distance to the target of uv through a vertex at distance d.
+  DistanceT next_distance(DistanceT const d, edge_value_t<G>& uv) {
+    return weighted_ ? static_cast<DistanceT>(d + distance_fnc_(uv)) : static_cast<DistanceT>(d + 1);
+  }
+
+  //! Count the shortest paths from source with a breadth-first search.
+  void breadth_first(workspace& ws, key_type const source) {
+    ws.distance_[source] = 0;
+    ws.sigma_[source]    = 1.0;
+    ws.order_.push_back(source);
+    for (size_t i = 0; i < ws.order_.size(); ++i) {
+      key_type const         vkey      = ws.order_[i];
+      DistanceT const        w_dist    = ws.distance_[vkey] + 1;
+      vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, vkey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const wkey = vertex_key(g_, uv, vkey);
+        if (ws.distance_[wkey] == null_distance) {
+          ws.distance_[wkey] = w_dist;
+          ws.order_.push_back(wkey);
+        }
+        if (ws.distance_[wkey] == w_dist)
+          ws.sigma_[wkey] += ws.sigma_[vkey];
+      }
+    }
+  }
+
+  //! Count the shortest paths from source with Dijkstra's algorithm. The vertices are added to
+  //! ws.order_ as they're settled.
+  void dijkstra(workspace& ws, key_type const source) {
+    auto greater_dist    = [](auto const& lhs, auto const& rhs) { return lhs.first > rhs.first; };
+    ws.distance_[source] = 0;
+    ws.sigma_[source]    = 1.0;
+    ws.heap_.push_back({DistanceT(0), source});
+    while (!ws.heap_.empty()) {
+      pop_heap(ws.heap_.begin(), ws.heap_.end(), greater_dist);
+      auto const [v_dist, vkey] = ws.heap_.back();
+      ws.heap_.pop_back();
+      if (v_dist > ws.distance_[vkey])
+        continue; // a stale entry
+      ws.order_.push_back(vkey);
+
+      vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, vkey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const  wkey   = vertex_key(g_, uv, vkey);
+        DistanceT const w_dist = next_distance(v_dist, *uv);
+        if (w_dist < ws.distance_[wkey]) {
+          ws.distance_[wkey] = w_dist;
+          ws.sigma_[wkey]    = ws.sigma_[vkey];
+          ws.heap_.push_back({w_dist, wkey});
+          push_heap(ws.heap_.begin(), ws.heap_.end(), greater_dist);
+        } else if (w_dist == ws.distance_[wkey]) {
+          ws.sigma_[wkey] += ws.sigma_[vkey];
+        }
+      }
+    }
+  }
+
+private:
+  graph_type&    g_;
+  DistFnc&       distance_fnc_;
+  bool           weighted_;
+  allocator_type alloc_;
+};
+
+
+//! Find the betweenness centrality of each vertex of an unweighted graph, in parallel over the
+//! sources.
+//!
+//! @param policy          The execution policy used.
+//! @param g               The graph
+//! @param centrality_iter The beginning of a random-access range of size(g) values, where
+//!                        centrality_iter[ukey] is assigned the betweenness of ukey.
+//! @param num_pivots      The number of sources to sample. The default is to use all vertices,
+//!                        which gives the exact betweenness.
+//! @param seed            The seed used to choose the sampled sources.
+//! @param alloc           The allocator to use for internal containers.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CentralityIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+void betweenness_centrality(ExecutionPolicy&& policy,
+                            G&                g,
+                            CentralityIter    centrality_iter,
+                            size_t const      num_pivots = numeric_limits<size_t>::max(),
+                            unsigned const    seed       = 0,
+                            A                 alloc      = A())
+// clang-format on
+{
+  auto unit_fnc = [](edge_value_t<G>&) -> size_t { return 1; };
+  betweenness_fn<G, decltype(unit_fnc), size_t, A> fn(g, unit_fnc, false, alloc);
+  fn(policy, centrality_iter, num_pivots, seed);
+}
+
+//! Find the betweenness centrality of each vertex of an unweighted graph.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CentralityIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+void betweenness_centrality(G&             g,
+                            CentralityIter centrality_iter,
+                            size_t const   num_pivots = numeric_limits<size_t>::max(),
+                            unsigned const seed       = 0,
+                            A              alloc      = A())
+// clang-format on
+{
+  betweenness_centrality(execution::seq, g, centrality_iter, num_pivots, seed, alloc);
+}
+
+//! Find the betweenness centrality of each vertex of a weighted graph, in parallel over the
+//! sources.
+//!
+//! @param policy          The execution policy used.
+//! @param g               The graph
+//! @param centrality_iter The beginning of a random-access range of size(g) values, where
+//!                        centrality_iter[ukey] is assigned the betweenness of ukey.
+//! @param distance_fnc    The weight function object used to determine the distance between
+//!                        vertices on an edge. Weights must be positive.
+//! @param num_pivots      The number of sources to sample. The default is to use all vertices,
+//!                        which gives the exact betweenness.
+//! @param seed            The seed used to choose the sampled sources.
+//! @param alloc           The allocator to use for internal containers.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CentralityIter,
+          typename               DistFnc,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void dijkstra_betweenness_centrality(ExecutionPolicy&& policy,
+                                     G&                g,
+                                     CentralityIter    centrality_iter,
+                                     DistFnc           distance_fnc,
+                                     size_t const      num_pivots = numeric_limits<size_t>::max(),
+                                     unsigned const    seed       = 0,
+                                     A                 alloc      = A())
+// clang-format on
+{
+  using distance_t = remove_cvref_t<invoke_result_t<DistFnc, edge_value_t<G>&>>;
+  betweenness_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, true, alloc);
+  fn(policy, centrality_iter, num_pivots, seed);
+}
+
+//! Find the betweenness centrality of each vertex of a weighted graph.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CentralityIter,
+          typename               DistFnc,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void dijkstra_betweenness_centrality(G&             g,
+                                     CentralityIter centrality_iter,
+                                     DistFnc        distance_fnc,
+                                     size_t const   num_pivots = numeric_limits<size_t>::max(),
+                                     unsigned const seed       = 0,
+                                     A              alloc      = A())
+// clang-format on
+{
+  dijkstra_betweenness_centrality(execution::seq, g, centrality_iter, distance_fnc, num_pivots, seed, alloc);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_BETWEENNESS_CENTRALITY_HPP
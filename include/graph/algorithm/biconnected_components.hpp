@@ -0,0 +1,272 @@
+//
+// Biconnected components, articulation points and bridges of undirected graphs.
+//
+// The Hopcroft-Tarjan algorithm is run as an iterative depth-first search with an explicit stack,
+// so the depth of the graph isn't limited by the call stack. Each vertex is given its discovery
+// time and the lowest discovery time reachable from its subtree with one back edge (low). When a
+// child c of u finishes with low[c] >= disc[u], u separates the subtree of c from the rest of the
+// graph: u is an articulation point (or the root, if it has more than one child), and the vertices
+// discovered since c form a biconnected component together with u. If low[c] > disc[u], the edge
+// u-c is a bridge.
+//
+// Instead of keeping a stack of edges, a stack of vertices is used and each vertex other than a
+// root is assigned the component of the tree edge to its parent. Every other edge u-v joins a
+// vertex to one of its ancestors, and is on a cycle with the tree edge to the deeper of the two,
+// so it's in the same component as that tree edge. The component of every edge is then found in a
+// single pass over the edges after the search, with O(|V|) space beyond the results.
+//
+// Results for edges are written to dense arrays with one element for each edge of each vertex, so
+// an undirected edge has two elements. The element for the i'th edge in edges(g,u) is at
+// offset(u) + i, where offset(u) is the total number of edges of the vertices before u.
+//
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "../graph.hpp"
+
+#ifndef GRAPH_BICONNECTED_COMPONENTS_HPP
+#  define GRAPH_BICONNECTED_COMPONENTS_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of the Hopcroft-Tarjan biconnected components algorithm.
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires undirected<G>
+class hopcroft_tarjan_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  static constexpr key_type null_key = numeric_limits<key_type>::max();
+
+  hopcroft_tarjan_fn(graph_type& g, allocator_type alloc = A())
+        : graph_(g)
+        , disc_(ranges::size(g), null_key, alloc)
+        , low_(ranges::size(g), null_key, alloc)
+        , parent_(ranges::size(g), null_key, alloc)
+        , tree_comp_(ranges::size(g), null_key, alloc)
+        , articulation_(ranges::size(g), false, alloc)
+        , vstack_(alloc)
+        , dfs_(alloc) {
+    for (key_type ukey = 0; ukey < static_cast<key_type>(ranges::size(graph_)); ++ukey)
+      if (disc_[ukey] == null_key)
+        search(ukey);
+  }
+
+  //! The number of biconnected components. A vertex without edges isn't in a component.
+  size_t components() const noexcept { return components_; }
+
+  bool is_articulation(key_type const ukey) const noexcept { return articulation_[ukey]; }
+
+  //! Call fnc(ukey, vkey, comp, is_bridge) for each edge of each vertex, in order of ukey and then
+  //! edges(g,ukey). comp is null_key for a self-loop.
+  template <typename EdgeFnc>
+  void for_each_edge(EdgeFnc&& fnc) {
+    for (key_type ukey = 0; ukey < static_cast<key_type>(ranges::size(graph_)); ++ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(graph_, find_vertex(graph_, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(graph_, uv, ukey);
+        if (vkey == ukey) {
+          fnc(ukey, vkey, null_key, false);
+          continue;
+        }
+        // the component of the tree edge to the deeper vertex
+        key_type const deep    = (disc_[ukey] > disc_[vkey]) ? ukey : vkey;
+        key_type const shallow = (deep == ukey) ? vkey : ukey;
+        fnc(ukey, vkey, tree_comp_[deep], parent_[deep] == shallow && low_[deep] > disc_[shallow]);
+      }
+    }
+  }
+
+protected:
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using bool_vector = vector<bool, typename allocator_traits<A>::template rebind_alloc<bool>>;
+
+  struct dfs_elem {
+    key_type                  ukey;
+    vertex_edge_iterator_t<G> uv;   // next edge to visit
+    vertex_edge_iterator_t<G> last; // end of the edges
+    bool                      parent_skipped = false;
+  };
+  using dfs_stack = vector<dfs_elem, typename allocator_traits<A>::template rebind_alloc<dfs_elem>>;
+
+  void push(key_type const ukey) {
+    disc_[ukey] = low_[ukey] = time_++;
+    vstack_.push_back(ukey);
+    vertex_edge_range_t<G> edges_rng = edges(graph_, find_vertex(graph_, ukey));
+    dfs_.push_back({ukey, ranges::begin(edges_rng), ranges::end(edges_rng)});
+  }
+
+  void search(key_type const root) {
+    size_t root_children = 0;
+    push(root);
+    while (!dfs_.empty()) {
+      dfs_elem& top = dfs_.back();
+      if (top.uv != top.last) {
+        key_type const ukey = top.ukey;
+        key_type const vkey = vertex_key(graph_, top.uv, ukey);
+        ++top.uv;
+        if (vkey == ukey)
+          continue; // self-loop
+        if (vkey == parent_[ukey] && !top.parent_skipped) {
+          top.parent_skipped = true; // the tree edge; a parallel edge to the parent is a back edge
+          continue;
+        }
+        if (disc_[vkey] == null_key) {
+          parent_[vkey] = ukey;
+          push(vkey); // invalidates top
+        } else {
+          low_[ukey] = min(low_[ukey], disc_[vkey]);
+        }
+        continue;
+      }
+
+      key_type const ukey = top.ukey;
+      dfs_.pop_back();
+      if (dfs_.empty())
+        break;
+      key_type const pkey = dfs_.back().ukey;
+      low_[pkey]          = min(low_[pkey], low_[ukey]);
+      if (low_[ukey] >= disc_[pkey]) {
+        // pkey separates the subtree of ukey
+        if (pkey != root)
+          articulation_[pkey] = true;
+        else if (++root_children > 1)
+          articulation_[root] = true;
+        key_type wkey;
+        do {
+          wkey = vstack_.back();
+          vstack_.pop_back();
+          tree_comp_[wkey] = static_cast<key_type>(components_);
+        } while (wkey != ukey);
+        ++components_;
+      }
+    }
+    vstack_.clear(); // the root
+  }
+
+private:
+  graph_type& graph_;
+  key_vector  disc_;      // discovery time
+  key_vector  low_;       // lowest discovery time reachable from the subtree with one back edge
+  key_vector  parent_;    // parent in the depth-first tree
+  key_vector  tree_comp_; // component of the tree edge to the parent
+  bool_vector articulation_;
+  key_vector  vstack_;
+  dfs_stack   dfs_;
+  key_type    time_       = 0;
+  size_t      components_ = 0;
+};
+
+
+//! Find the biconnected components of an undirected graph, assigning the component of each edge to
+//! a dense array.
+//!
+//! Complexity is O(|V| + |E|).
+//!
+//! @param g           The graph
+//! @param edge_component_iter
+//!                    The beginning of a random-access range with an element for each edge of
+//!                    each vertex, where the element for the i'th edge in edges(g,u) is at the
+//!                    total number of edges of the vertices before u, plus i. It's assigned the
+//!                    component of the edge, numbered from 0, or the maximum value of the type
+//!                    for a self-loop.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The number of biconnected components.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CompIter,
+          typename               A = allocator<char>>
+  requires undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CompIter>>
+size_t biconnected_components(G& g, CompIter edge_component_iter, A alloc = A())
+// clang-format on
+{
+  using comp_t = iter_value_t<CompIter>;
+  using fn_t   = hopcroft_tarjan_fn<G, A>;
+  fn_t fn(g, alloc);
+  fn.for_each_edge([&edge_component_iter](auto, auto, vertex_key_t<G> const comp, bool) {
+    *edge_component_iter = (comp == fn_t::null_key) ? numeric_limits<comp_t>::max() : static_cast<comp_t>(comp);
+    ++edge_component_iter;
+  });
+  return fn.components();
+}
+
+//! Find the articulation points of an undirected graph, whose removal disconnects the component
+//! they're in.
+//!
+//! Complexity is O(|V| + |E|).
+//!
+//! @param g                 The graph
+//! @param articulation_iter The beginning of a random-access range of size(g) values, where
+//!                          articulation_iter[ukey] is assigned true if ukey is an articulation
+//!                          point.
+//! @param alloc             The allocator to use for internal containers.
+//! @return                  The number of articulation points.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator ArtIter,
+          typename               A = allocator<char>>
+  requires undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+size_t articulation_points(G& g, ArtIter articulation_iter, A alloc = A())
+// clang-format on
+{
+  hopcroft_tarjan_fn<G, A> fn(g, alloc);
+  size_t                   count = 0;
+  for (vertex_key_t<G> ukey = 0; ukey < static_cast<vertex_key_t<G>>(ranges::size(g)); ++ukey) {
+    articulation_iter[static_cast<iter_difference_t<ArtIter>>(ukey)] = fn.is_articulation(ukey);
+    count += fn.is_articulation(ukey);
+  }
+  return count;
+}
+
+//! Find the bridges of an undirected graph, whose removal disconnects the component they're in.
+//!
+//! Complexity is O(|V| + |E|).
+//!
+//! @param g           The graph
+//! @param bridge_iter The beginning of a random-access range with an element for each edge of each
+//!                    vertex, in the same order as for biconnected_components. It's assigned true
+//!                    if the edge is a bridge.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The number of bridges, counting each undirected edge once.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator BridgeIter,
+          typename               A = allocator<char>>
+  requires undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+size_t bridges(G& g, BridgeIter bridge_iter, A alloc = A())
+// clang-format on
+{
+  hopcroft_tarjan_fn<G, A> fn(g, alloc);
+  size_t                   count = 0;
+  fn.for_each_edge([&bridge_iter, &count](auto, auto, auto, bool const is_bridge) {
+    *bridge_iter = is_bridge;
+    ++bridge_iter;
+    count += is_bridge;
+  });
+  return count / 2;
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_BICONNECTED_COMPONENTS_HPP
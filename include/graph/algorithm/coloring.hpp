@@ -0,0 +1,421 @@
+//
+// Vertex coloring.
+//
+// A coloring assigns a color to each vertex so that no two neighbors have the same color, e.g. to
+// find sets of vertices that can be updated concurrently without conflicts. Colorings are defined
+// on the underlying undirected graph: the direction of edges is ignored, and self-loops are
+// skipped. All the functions write a color in [0, count) for each vertex, where every color is
+// used, and return the number of colors. Each vertex is given the smallest color that isn't used
+// by the neighbors colored before it (first-fit), so no more than max_degree + 1 colors are used.
+//
+// greedy_coloring colors the vertices one at a time, in one of these orders:
+//  1. natural: in increasing order of key.
+//  2. largest_first: in decreasing order of degree (Welsh & Powell).
+//  3. smallest_last: the reverse of the order of repeatedly removing a vertex of smallest degree
+//     (Matula & Beck). Each vertex has at most k neighbors colored before it, where k is the
+//     degeneracy (the largest core number), so it uses at most k + 1 colors. The vertices are
+//     removed with the bucket algorithm, as in k_core.hpp, so it's O(|V| + |E|).
+//
+// jones_plassmann_coloring gives each vertex a priority: the log of its degree, with ties broken
+// by a fixed pseudo-random order of the keys (the largest-log-degree-first heuristic of
+// Hasenplaugh et al., which uses fewer colors than random priorities and has fewer rounds than
+// exact degrees). A vertex is colored once all its neighbors with a higher priority are colored,
+// so each round colors an independent set concurrently. Each vertex counts its uncolored neighbors
+// with a higher priority, and the last of them to be colored adds it to the next round, so it's
+// O(|V| + |E|) work. The result doesn't depend on the execution policy.
+//
+// speculative_coloring (Gebremedhin & Manne, as extended by Catalyurek et al.) colors all the
+// vertices concurrently, ignoring that neighbors may be colored at the same time, then finds the
+// neighbors given the same color. The vertex with the larger key of each conflicting pair is
+// colored again in the next round, until there are no conflicts. It has less synchronization
+// than jones_plassmann_coloring, and conflicts are rare when there are many more vertices than
+// threads, but the result depends on the thread timing.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "../detail/neighbor_lists.hpp"
+
+#ifndef GRAPH_COLORING_HPP
+#  define GRAPH_COLORING_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Identifies the order of the vertices for greedy_coloring.
+enum class coloring_order : int8_t {
+  natural,       // increasing order of key
+  largest_first, // decreasing order of degree
+  smallest_last  // the reverse of the order of removing a vertex of smallest degree
+};
+
+//! Internal implementation of vertex coloring.
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class coloring_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  coloring_fn(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+        : neighbors_(policy, g, alloc), color_(neighbors_.size(), alloc), alloc_(alloc) {
+    max_degree_ = transform_reduce(
+          policy, detail::index_iterator<key_type>(0), detail::index_iterator<key_type>(neighbors_.size()),
+          key_type(0), [](key_type const a, key_type const b) { return max(a, b); },
+          [this](key_type const ukey) { return neighbors_.degree(ukey); });
+  }
+
+  //! Color the vertices one at a time in the order given, writing the color of each vertex to
+  //! color_iter[ukey].
+  //! @return The number of colors.
+  template <random_access_iterator ColorIter>
+  key_type operator()(ColorIter color_iter, coloring_order const order) {
+    fill(color_.begin(), color_.end(), none);
+    palette p(max_degree_, alloc_);
+    for (key_type const ukey : ordering(order))
+      color_[ukey] = p.first_free(neighbors_[ukey], color_);
+    return output(execution::seq, color_iter);
+  }
+
+  //! Color the vertices in rounds of independent sets, in order of priority.
+  //! @return The number of colors.
+  template <typename ExecutionPolicy, random_access_iterator ColorIter>
+  key_type jones_plassmann(ExecutionPolicy&& policy, ColorIter color_iter) {
+    key_type const n = neighbors_.size();
+    key_vector     waiting(n, alloc_); // the uncolored neighbors with a higher priority
+    key_vector     frontier(n, alloc_);
+    key_vector     next(n, alloc_);
+    size_t         frontier_size = 0;
+    fill(policy, color_.begin(), color_.end(), none);
+    detail::for_each_index(policy, key_type(0), n, [&](key_type const ukey) {
+      key_type count = 0;
+      for (key_type const vkey : neighbors_[ukey])
+        count += precedes(vkey, ukey);
+      waiting[ukey] = count;
+      if (count == 0)
+        frontier[atomic_ref<size_t>(frontier_size).fetch_add(1, memory_order_relaxed)] = ukey;
+    });
+
+    auto make_ws = [this]() { return palette(max_degree_, alloc_); };
+    detail::workspace_pool<palette, decltype(make_ws)> pool(make_ws);
+    while (frontier_size > 0) {
+      size_t next_size = 0;
+      detail::for_each_block(policy, size_t(0), frontier_size, [&](size_t const first, size_t const last) {
+        auto p = pool.acquire();
+        for (size_t i = first; i < last; ++i) {
+          key_type const ukey = frontier[i];
+          color_[ukey]        = p->first_free(neighbors_[ukey], color_);
+          for (key_type const vkey : neighbors_[ukey])
+            if (precedes(ukey, vkey) && atomic_ref<key_type>(waiting[vkey]).fetch_sub(1, memory_order_relaxed) == 1)
+              next[atomic_ref<size_t>(next_size).fetch_add(1, memory_order_relaxed)] = vkey;
+        }
+      });
+      swap(frontier, next);
+      frontier_size = next_size;
+    }
+    return output(policy, color_iter);
+  }
+
+  //! Color the vertices concurrently, then color again the vertices in conflict with a neighbor
+  //! that has a smaller key, until there are no conflicts.
+  //! @return The number of colors.
+  template <typename ExecutionPolicy, random_access_iterator ColorIter>
+  key_type speculative(ExecutionPolicy&& policy, ColorIter color_iter) {
+    key_type const n = neighbors_.size();
+    key_vector     work(n, alloc_);
+    key_vector     next(n, alloc_);
+    size_t         work_size = n;
+    iota(work.begin(), work.end(), key_type(0));
+    fill(policy, color_.begin(), color_.end(), none);
+
+    auto make_ws = [this]() { return palette(max_degree_, alloc_); };
+    detail::workspace_pool<palette, decltype(make_ws)> pool(make_ws);
+    while (work_size > 0) {
+      detail::for_each_block(policy, size_t(0), work_size, [&](size_t const first, size_t const last) {
+        auto p = pool.acquire();
+        for (size_t i = first; i < last; ++i)
+          detail::atomic_store(color_[work[i]], p->first_free(neighbors_[work[i]], color_));
+      });
+
+      size_t next_size = 0;
+      detail::for_each_index(policy, size_t(0), work_size, [&](size_t const i) {
+        key_type const ukey = work[i];
+        for (key_type const vkey : neighbors_[ukey]) {
+          if (vkey >= ukey)
+            break; // the neighbors are in increasing order
+          if (color_[vkey] == color_[ukey]) {
+            next[atomic_ref<size_t>(next_size).fetch_add(1, memory_order_relaxed)] = ukey;
+            break;
+          }
+        }
+      });
+      swap(work, next);
+      work_size = next_size;
+    }
+    return output(policy, color_iter);
+  }
+
+protected:
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+
+  static constexpr key_type none = numeric_limits<key_type>::max(); // not colored
+
+  //! The colors of the neighbors of a vertex. Colors are marked with a stamp that's changed for
+  //! each vertex, so the marks don't need to be cleared.
+  struct palette {
+    size_vector mark;
+    size_t      stamp = 0;
+
+    palette(key_type const max_degree, allocator_type alloc) : mark(static_cast<size_t>(max_degree) + 1, 0, alloc) {}
+
+    //! The smallest color that isn't the color of a neighbor.
+    key_type first_free(span<key_type const> const neighbors, key_vector& color) {
+      ++stamp;
+      for (key_type const vkey : neighbors) {
+        key_type const c = detail::atomic_load(color[vkey]);
+        if (c < mark.size())
+          mark[c] = stamp;
+      }
+      key_type c = 0;
+      while (mark[c] == stamp)
+        ++c;
+      return c;
+    }
+  };
+
+  //! True if ukey has a higher priority than vkey for jones_plassmann.
+  bool precedes(key_type const ukey, key_type const vkey) const noexcept {
+    auto const lu = bit_width(static_cast<size_t>(neighbors_.degree(ukey)));
+    auto const lv = bit_width(static_cast<size_t>(neighbors_.degree(vkey)));
+    if (lu != lv)
+      return lu > lv;
+    uint64_t const hu = detail::mix_bits(static_cast<uint64_t>(ukey));
+    uint64_t const hv = detail::mix_bits(static_cast<uint64_t>(vkey));
+    return hu != hv ? hu > hv : ukey < vkey;
+  }
+
+  //! The vertices in the order they're colored by greedy coloring.
+  key_vector ordering(coloring_order const order) const {
+    key_type const n = neighbors_.size();
+    key_vector     vert(n, alloc_);
+    iota(vert.begin(), vert.end(), key_type(0));
+    if (order == coloring_order::largest_first) {
+      stable_sort(vert.begin(), vert.end(), [this](key_type const ukey, key_type const vkey) {
+        return neighbors_.degree(ukey) > neighbors_.degree(vkey);
+      });
+    } else if (order == coloring_order::smallest_last) {
+      smallest_last(vert);
+    }
+    return vert;
+  }
+
+  //! Order the vertices by repeatedly removing a vertex of smallest degree, then reverse it.
+  void smallest_last(key_vector& vert) const {
+    key_type const n = neighbors_.size();
+    key_vector     degree(n, alloc_); // the degree among the vertices that haven't been removed
+    for (key_type ukey = 0; ukey < n; ++ukey)
+      degree[ukey] = neighbors_.degree(ukey);
+
+    // bin[d] is the start of the vertices of degree d in vert; pos is the position of each vertex
+    size_vector bin(static_cast<size_t>(max_degree_) + 1, 0, alloc_);
+    for (key_type const d : degree)
+      ++bin[d];
+    exclusive_scan(bin.begin(), bin.end(), bin.begin(), size_t(0));
+    size_vector pos(n, alloc_);
+    for (key_type ukey = 0; ukey < n; ++ukey) {
+      pos[ukey]       = bin[degree[ukey]]++;
+      vert[pos[ukey]] = ukey;
+    }
+    shift_right(bin.begin(), bin.end(), 1);
+    bin[0] = 0;
+
+    // vert[i] has the smallest degree of vert[i..n), and its neighbors move to the bucket below,
+    // which starts at i + 1 (unlike the bucket algorithm for cores, degrees may go below it)
+    for (size_t i = 0; i < n; ++i) {
+      key_type const vkey = vert[i];
+      key_type const d    = degree[vkey];
+      bin[d]              = i + 1;
+      if (d > 0)
+        bin[d - 1] = i + 1;
+      for (key_type const ukey : neighbors_[vkey]) {
+        if (pos[ukey] > i) {
+          // swap ukey with the first vertex of its bucket, then move the bucket's start past it
+          key_type const du   = degree[ukey];
+          size_t const   pw   = bin[du];
+          key_type const wkey = vert[pw];
+          if (ukey != wkey) {
+            swap(vert[pos[ukey]], vert[pw]);
+            swap(pos[ukey], pos[wkey]);
+          }
+          ++bin[du];
+          --degree[ukey];
+        }
+      }
+    }
+    reverse(vert.begin(), vert.end());
+  }
+
+  //! Renumber the colors used to [0, count) and write them to color_iter[0..n).
+  //! @return The number of colors.
+  template <typename ExecutionPolicy, random_access_iterator ColorIter>
+  key_type output(ExecutionPolicy&& policy, ColorIter color_iter) {
+    key_type const n = neighbors_.size();
+    key_vector     number(static_cast<size_t>(max_degree_) + 1, 0, alloc_);
+    detail::for_each_index(policy, key_type(0), n, [this, &number](key_type const ukey) {
+      detail::atomic_store(number[color_[ukey]], key_type(1)); // the color is used
+    });
+    inclusive_scan(policy, number.begin(), number.end(), number.begin());
+    detail::for_each_index(policy, key_type(0), n, [this, &number, &color_iter](key_type const ukey) {
+      color_iter[static_cast<iter_difference_t<ColorIter>>(ukey)] =
+            static_cast<iter_value_t<ColorIter>>(number[color_[ukey]] - 1);
+    });
+    return number.back();
+  }
+
+private:
+  detail::neighbor_lists<G, A> neighbors_;
+  key_vector                   color_;
+  key_type                     max_degree_ = 0;
+  allocator_type               alloc_;
+};
+
+
+//! Color the vertices of a graph greedily, ignoring the direction of edges.
+//!
+//! Complexity is O(|V| + |E|) after the distinct neighbors of each vertex are found, plus
+//! O(|V| log |V|) for largest_first.
+//!
+//! @param g          The graph
+//! @param color_iter The beginning of a random-access range of size(g) values, where
+//!                   color_iter[ukey] is assigned the color of ukey in [0, count).
+//! @param order      The order the vertices are colored in.
+//! @param alloc      The allocator to use for internal containers.
+//! @return           The number of colors.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator ColorIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<ColorIter>>
+vertex_key_t<G> greedy_coloring(G&                   g,
+                                ColorIter            color_iter,
+                                coloring_order const order = coloring_order::smallest_last,
+                                A                    alloc = A())
+// clang-format on
+{
+  coloring_fn<G, A> fn(execution::seq, g, alloc);
+  return fn(color_iter, order);
+}
+
+//! Color the vertices of a graph with the Jones-Plassmann algorithm, ignoring the direction of
+//! edges.
+//!
+//! @param policy     The execution policy used.
+//! @param g          The graph
+//! @param color_iter The beginning of a random-access range of size(g) values, where
+//!                   color_iter[ukey] is assigned the color of ukey in [0, count).
+//! @param alloc      The allocator to use for internal containers.
+//! @return           The number of colors.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator ColorIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<ColorIter>>
+vertex_key_t<G> jones_plassmann_coloring(ExecutionPolicy&& policy, G& g, ColorIter color_iter, A alloc = A())
+// clang-format on
+{
+  coloring_fn<G, A> fn(policy, g, alloc);
+  return fn.jones_plassmann(policy, color_iter);
+}
+
+//! Color the vertices of a graph with the Jones-Plassmann algorithm, ignoring the direction of
+//! edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator ColorIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<ColorIter>>
+vertex_key_t<G> jones_plassmann_coloring(G& g, ColorIter color_iter, A alloc = A())
+// clang-format on
+{
+  return jones_plassmann_coloring(execution::seq, g, color_iter, alloc);
+}
+
+//! Color the vertices of a graph speculatively, resolving conflicts in later rounds, ignoring the
+//! direction of edges.
+//!
+//! @param policy     The execution policy used.
+//! @param g          The graph
+//! @param color_iter The beginning of a random-access range of size(g) values, where
+//!                   color_iter[ukey] is assigned the color of ukey in [0, count).
+//! @param alloc      The allocator to use for internal containers.
+//! @return           The number of colors.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator ColorIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<ColorIter>>
+vertex_key_t<G> speculative_coloring(ExecutionPolicy&& policy, G& g, ColorIter color_iter, A alloc = A())
+// clang-format on
+{
+  coloring_fn<G, A> fn(policy, g, alloc);
+  return fn.speculative(policy, color_iter);
+}
+
+//! Color the vertices of a graph speculatively, resolving conflicts in later rounds, ignoring the
+//! direction of edges. Serially, there are no conflicts and it's greedy coloring in natural order.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator ColorIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<ColorIter>>
+vertex_key_t<G> speculative_coloring(G& g, ColorIter color_iter, A alloc = A())
+// clang-format on
+{
+  return speculative_coloring(execution::seq, g, color_iter, alloc);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_COLORING_HPP
@@ -0,0 +1,654 @@
+//
+// Community detection with label propagation and Louvain modularity optimization.
+//
+// Communities are found in the underlying undirected graph: the direction of edges is ignored.
+// Both algorithms write a dense community number in [0, count) for each vertex and return the
+// number of communities.
+//
+// Label propagation (Raghavan, Albert & Kumara) starts with every vertex in its own community and
+// repeatedly moves each vertex to the community that's most frequent among its distinct
+// neighbors, until no vertex changes or the maximum number of iterations is reached. Ties are
+// broken by a fixed pseudo-random order of the communities (a hash of the number), since always
+// taking the lowest number lets one community flood across sparse cuts.
+//  1. label_propagation is asynchronous: a vertex sees the communities its neighbors were moved to
+//     earlier in the same iteration, which converges quickly. A vertex keeps its community when
+//     it's one of the most frequent. The ExecutionPolicy overload updates the vertices
+//     concurrently, so the result depends on the thread timing.
+//  2. synchronous_label_propagation computes the new communities of all the vertices from those
+//     of the previous iteration, so the result doesn't depend on the execution policy. A vertex
+//     counts as one of its own neighbors, and the order of the ties is the same for every
+//     vertex, which stops pairs of neighbors swapping communities on every iteration.
+//
+// louvain_communities (Blondel et al.) maximizes the modularity of the communities, using edge
+// weights. Each level has a local moving phase, where each vertex is moved to the neighboring
+// community with the largest modularity gain, until the modularity improves by less than the
+// tolerance. The communities are then coarsened into the vertices of the next level, with the
+// edges between them summed into weighted edges and the edges inside them into self-loops, and
+// the next level starts from there. It stops when a level moves no vertices. The ExecutionPolicy
+// overload moves the vertices concurrently, as in Grappolo: the total degree of each community is
+// updated atomically, and a vertex on its own only moves to another single-vertex community with
+// a lower number, so that pairs of vertices don't swap back & forth.
+//
+// The levels are kept as compressed sparse rows (offsets, targets & weights) built in parallel,
+// the first from the graph and the rest from the level before it.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "../detail/neighbor_lists.hpp"
+
+#ifndef GRAPH_COMMUNITY_HPP
+#  define GRAPH_COMMUNITY_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+namespace detail {
+  //! Renumber the values of labels[0..n) to dense numbers [0, count) in order of the first
+  //! vertex with each value, and write them to out_iter[0..n).
+  //! @return The number of distinct values.
+  template <typename ExecutionPolicy, typename KeyT, typename OutIter, typename A>
+  KeyT renumber_labels(ExecutionPolicy&& policy, vector<KeyT, A> const& labels, OutIter out_iter) {
+    KeyT const      n = static_cast<KeyT>(labels.size());
+    vector<KeyT, A> first(n, n, labels.get_allocator()); // the first vertex with each label
+    for_each_index(policy, KeyT(0), n, [&labels, &first](KeyT const ukey) { atomic_min(first[labels[ukey]], ukey); });
+    vector<KeyT, A> number(n, 0, labels.get_allocator());
+    for_each_index(policy, KeyT(0), n, [&labels, &first, &number](KeyT const ukey) {
+      number[ukey] = first[labels[ukey]] == ukey;
+    });
+    inclusive_scan(policy, number.begin(), number.end(), number.begin());
+    for_each_index(policy, KeyT(0), n, [&labels, &first, &number, &out_iter](KeyT const ukey) {
+      out_iter[static_cast<std::iter_difference_t<OutIter>>(ukey)] =
+            static_cast<std::iter_value_t<OutIter>>(number[first[labels[ukey]]] - 1);
+    });
+    return n > 0 ? number[n - 1] : KeyT(0);
+  }
+} // namespace detail
+
+
+//! Internal implementation of label propagation.
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class label_propagation_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  label_propagation_fn(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+        : neighbors_(policy, g, alloc), label_(neighbors_.size(), alloc), next_(alloc), alloc_(alloc) {}
+
+  //! Propagate the labels, writing the dense community of each vertex to community_iter[ukey].
+  //! @return The number of communities.
+  template <typename ExecutionPolicy, random_access_iterator CommunityIter>
+  key_type operator()(ExecutionPolicy&& policy,
+                      CommunityIter     community_iter,
+                      bool const        synchronous,
+                      size_t const      max_iterations) {
+    key_type const n = neighbors_.size();
+    iota(label_.begin(), label_.end(), key_type(0));
+    if (synchronous)
+      next_.resize(n);
+
+    auto make_ws = [this]() { return key_vector(alloc_); };
+    detail::workspace_pool<key_vector, decltype(make_ws)> pool(make_ws);
+    for (size_t iteration = 0; iteration < max_iterations; ++iteration) {
+      size_t changed = 0;
+      detail::for_each_block(policy, key_type(0), n, [&](key_type const first, key_type const last) {
+        auto   buffer        = pool.acquire();
+        size_t block_changed = 0;
+        for (key_type ukey = first; ukey < last; ++ukey) {
+          key_type const cur  = detail::atomic_load(label_[ukey]);
+          key_type const best = most_frequent(ukey, cur, *buffer, synchronous);
+          if (synchronous)
+            next_[ukey] = best;
+          else if (best != cur)
+            detail::atomic_store(label_[ukey], best);
+          block_changed += best != cur;
+        }
+        atomic_ref<size_t>(changed).fetch_add(block_changed, memory_order_relaxed);
+      });
+      if (synchronous)
+        swap(label_, next_);
+      if (changed == 0)
+        break;
+    }
+    return detail::renumber_labels(policy, label_, community_iter);
+  }
+
+protected:
+  using key_vector = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+
+  //! The most frequent label of the neighbors of ukey, and ukey itself when synchronous.
+  key_type most_frequent(key_type const ukey, key_type const cur, key_vector& buffer, bool const synchronous) {
+    span<key_type const> const neighbors = neighbors_[ukey];
+    if (neighbors.empty())
+      return cur;
+    buffer.clear();
+    for (key_type const vkey : neighbors)
+      buffer.push_back(detail::atomic_load(label_[vkey]));
+    if (synchronous)
+      buffer.push_back(cur);
+    sort(buffer.begin(), buffer.end());
+
+    key_type best = cur, best_count = 0;
+    for (size_t i = 0, j = 0; i < buffer.size(); i = j) {
+      for (j = i + 1; j < buffer.size() && buffer[j] == buffer[i]; ++j)
+        ;
+      key_type const count  = static_cast<key_type>(j - i);
+      bool           better = count > best_count;
+      if (count == best_count && synchronous)
+        better = priority(buffer[i]) > priority(best);
+      else if (count == best_count) // keep cur if it's one of the most frequent
+        better = best != cur && (buffer[i] == cur || priority(buffer[i]) > priority(best));
+      if (better) {
+        best       = buffer[i];
+        best_count = count;
+      }
+    }
+    return best;
+  }
+
+  //! The order of labels for breaking ties.
+  static uint64_t priority(key_type const label) noexcept { return detail::mix_bits(static_cast<uint64_t>(label)); }
+
+private:
+  detail::neighbor_lists<G, A> neighbors_;
+  key_vector                   label_;
+  key_vector                   next_; // the labels of the next iteration when synchronous
+  allocator_type               alloc_;
+};
+
+
+//! Internal implementation of the Louvain algorithm.
+//!
+// clang-format off
+template <incidence_graph G, typename WeightFnc, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class louvain_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  louvain_fn(graph_type& g, WeightFnc& weight_fnc, allocator_type alloc = A())
+        : g_(g), weight_fnc_(weight_fnc), alloc_(alloc) {}
+
+  //! Find the communities, writing the dense community of each vertex to community_iter[ukey].
+  //! @return The number of communities.
+  template <typename ExecutionPolicy, random_access_iterator CommunityIter>
+  key_type operator()(ExecutionPolicy&& policy, CommunityIter community_iter, double const tolerance) {
+    key_type const n = static_cast<key_type>(ranges::size(g_));
+    level_graph    level(alloc_);
+    build(policy, level);
+
+    auto make_ws = [this, n]() { return workspace(n, alloc_); };
+    detail::workspace_pool<workspace, decltype(make_ws)> pool(make_ws);
+    key_vector membership(n, alloc_); // the vertex of the current level that holds each vertex
+    key_vector community(alloc_);
+    key_vector number(alloc_);
+    iota(membership.begin(), membership.end(), key_type(0));
+    while (move_vertices(policy, level, community, pool, tolerance)) {
+      number.resize(community.size());
+      key_type const count = detail::renumber_labels(policy, community, number.begin());
+      detail::for_each_index(policy, key_type(0), n, [&membership, &number](key_type const ukey) {
+        membership[ukey] = number[membership[ukey]];
+      });
+      level_graph next(alloc_);
+      coarsen(policy, level, number, count, next, pool);
+      if (count == level.size())
+        break;
+      level = move(next);
+    }
+    detail::for_each_index(policy, key_type(0), n, [&membership, &community_iter](key_type const ukey) {
+      community_iter[static_cast<iter_difference_t<CommunityIter>>(ukey)] =
+            static_cast<iter_value_t<CommunityIter>>(membership[ukey]);
+    });
+    return level.size();
+  }
+
+protected:
+  using key_vector    = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector   = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+  using weight_vector = vector<double, typename allocator_traits<A>::template rebind_alloc<double>>;
+  using flag_vector   = vector<bool, typename allocator_traits<A>::template rebind_alloc<bool>>;
+
+  //! The weighted, symmetric graph of a level, as compressed sparse rows. degree[ukey] is the sum
+  //! of the weights of the row, where a self-loop counts twice.
+  struct level_graph {
+    size_vector   offsets;
+    key_vector    targets;
+    weight_vector weights;
+    weight_vector degree;
+
+    explicit level_graph(allocator_type alloc) : offsets(1, 0, alloc), targets(alloc), weights(alloc), degree(alloc) {}
+    key_type size() const noexcept { return static_cast<key_type>(offsets.size() - 1); }
+  };
+
+  //! The sum of the weights to each neighboring community of a vertex.
+  struct workspace {
+    weight_vector weight;
+    flag_vector   seen;
+    key_vector    touched;
+
+    workspace(key_type const n, allocator_type alloc) : weight(n, 0.0, alloc), seen(n, false, alloc), touched(alloc) {}
+
+    void add(key_type const c, double const w) {
+      if (!seen[c]) {
+        seen[c] = true;
+        touched.push_back(c);
+      }
+      weight[c] += w;
+    }
+    void reset() {
+      for (key_type const c : touched) {
+        weight[c] = 0.0;
+        seen[c]   = false;
+      }
+      touched.clear();
+    }
+  };
+
+  //! Build the first level from the graph: each edge u->v adds its weight to u-v & v-u, and the
+  //! parallel edges are summed.
+  template <typename ExecutionPolicy>
+  void build(ExecutionPolicy&& policy, level_graph& level) {
+    key_type const n = static_cast<key_type>(ranges::size(g_));
+    size_vector    offsets(static_cast<size_t>(n) + 1, 0, alloc_);
+    detail::for_each_index(policy, key_type(0), n, [this, &offsets](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        atomic_ref<size_t>(offsets[ukey + 1]).fetch_add(1, memory_order_relaxed);
+        atomic_ref<size_t>(offsets[vertex_key(g_, uv, ukey) + 1]).fetch_add(1, memory_order_relaxed);
+      }
+    });
+    inclusive_scan(policy, offsets.begin() + 1, offsets.end(), offsets.begin() + 1);
+
+    using arc = pair<key_type, double>;
+    vector<arc, typename allocator_traits<A>::template rebind_alloc<arc>> arcs(offsets[n], alloc_);
+    size_vector next(offsets.begin(), offsets.end() - 1, alloc_);
+    detail::for_each_index(policy, key_type(0), n, [this, &arcs, &next](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(g_, uv, ukey);
+        double const   w    = static_cast<double>(weight_fnc_(*uv));
+        arcs[atomic_ref<size_t>(next[ukey]).fetch_add(1, memory_order_relaxed)] = {vkey, w};
+        arcs[atomic_ref<size_t>(next[vkey]).fetch_add(1, memory_order_relaxed)] = {ukey, w};
+      }
+    });
+
+    // sort each row & sum the parallel arcs in place, then compact the rows
+    size_vector count(static_cast<size_t>(n) + 1, 0, alloc_);
+    detail::for_each_index(policy, key_type(0), n, [&arcs, &offsets, &count](key_type const ukey) {
+      auto first = arcs.begin() + static_cast<ptrdiff_t>(offsets[ukey]);
+      auto last  = arcs.begin() + static_cast<ptrdiff_t>(offsets[ukey + 1]);
+      sort(first, last, [](arc const& lhs, arc const& rhs) { return lhs.first < rhs.first; });
+      auto out = first;
+      for (auto it = first; it != last; ++it) {
+        if (out != first && prev(out)->first == it->first)
+          prev(out)->second += it->second;
+        else
+          *out++ = *it;
+      }
+      count[ukey + 1] = static_cast<size_t>(out - first);
+    });
+    inclusive_scan(policy, count.begin() + 1, count.end(), count.begin() + 1);
+
+    level.offsets = move(count);
+    level.targets.resize(level.offsets[n]);
+    level.weights.resize(level.offsets[n]);
+    level.degree.resize(n);
+    detail::for_each_index(policy, key_type(0), n, [&level, &arcs, &offsets](key_type const ukey) {
+      double degree = 0.0;
+      for (size_t i = 0; i < level.offsets[ukey + 1] - level.offsets[ukey]; ++i) {
+        level.targets[level.offsets[ukey] + i] = arcs[offsets[ukey] + i].first;
+        level.weights[level.offsets[ukey] + i] = arcs[offsets[ukey] + i].second;
+        degree += arcs[offsets[ukey] + i].second;
+      }
+      level.degree[ukey] = degree;
+    });
+  }
+
+  //! The local moving phase. community[ukey] is assigned the community of each vertex of level.
+  //! @return true if any vertex was moved.
+  template <typename ExecutionPolicy, typename Pool>
+  bool move_vertices(ExecutionPolicy&&  policy,
+                     level_graph const& level,
+                     key_vector&        community,
+                     Pool&              pool,
+                     double const       tolerance) {
+    key_type const n = level.size();
+    community.resize(n);
+    iota(community.begin(), community.end(), key_type(0));
+    weight_vector total(level.degree); // the total degree of each community
+    key_vector    size(n, 1, alloc_);
+    double const  m2 = reduce(policy, level.degree.begin(), level.degree.end(), 0.0);
+    if (m2 <= 0.0)
+      return false;
+
+    bool   moved_any = false;
+    double quality   = modularity(policy, level, community, total, m2);
+    for (;;) {
+      size_t moved = 0;
+      detail::for_each_block(policy, key_type(0), n, [&](key_type const first, key_type const last) {
+        auto   ws          = pool.acquire();
+        size_t block_moved = 0;
+        for (key_type ukey = first; ukey < last; ++ukey)
+          block_moved += move_vertex(level, community, total, size, m2, ukey, *ws);
+        atomic_ref<size_t>(moved).fetch_add(block_moved, memory_order_relaxed);
+      });
+      if (moved == 0)
+        break;
+      moved_any           = true;
+      double const before = quality;
+      quality             = modularity(policy, level, community, total, m2);
+      if (quality - before < tolerance)
+        break;
+    }
+    return moved_any;
+  }
+
+  //! Move ukey to the neighboring community with the largest modularity gain, unless it gains as
+  //! much by staying.
+  //! @return true if ukey was moved.
+  static bool move_vertex(level_graph const& level,
+                          key_vector&        community,
+                          weight_vector&     total,
+                          key_vector&        size,
+                          double const       m2,
+                          key_type const     ukey,
+                          workspace&         ws) {
+    key_type const from = detail::atomic_load(community[ukey]);
+    for (size_t i = level.offsets[ukey]; i < level.offsets[ukey + 1]; ++i)
+      if (level.targets[i] != ukey)
+        ws.add(detail::atomic_load(community[level.targets[i]]), level.weights[i]);
+
+    // the gain of joining each community, after leaving from; staying wins ties
+    double const k         = level.degree[ukey];
+    double const from_tot  = detail::atomic_load(total[from]) - k;
+    key_type     best      = from;
+    double       best_gain = ws.weight[from] - k * from_tot / m2;
+    for (key_type const c : ws.touched) {
+      double const gain = ws.weight[c] - k * detail::atomic_load(total[c]) / m2;
+      if (c != from && (gain > best_gain || (gain == best_gain && best != from && c < best))) {
+        best      = c;
+        best_gain = gain;
+      }
+    }
+    ws.reset();
+
+    bool const singletons = detail::atomic_load(size[from]) == 1 && detail::atomic_load(size[best]) == 1;
+    if (best != from && !(singletons && best > from)) {
+      atomic_ref<double>(total[from]).fetch_sub(k, memory_order_relaxed);
+      atomic_ref<double>(total[best]).fetch_add(k, memory_order_relaxed);
+      atomic_ref<key_type>(size[from]).fetch_sub(1, memory_order_relaxed);
+      atomic_ref<key_type>(size[best]).fetch_add(1, memory_order_relaxed);
+      detail::atomic_store(community[ukey], best);
+      return true;
+    }
+    return false;
+  }
+
+  //! The modularity of the communities of level.
+  template <typename ExecutionPolicy>
+  static double modularity(ExecutionPolicy&&    policy,
+                           level_graph const&   level,
+                           key_vector const&    community,
+                           weight_vector const& total,
+                           double const         m2) {
+    auto inside_fnc = [&level, &community](key_type const ukey) {
+      double sum = 0.0;
+      for (size_t i = level.offsets[ukey]; i < level.offsets[ukey + 1]; ++i)
+        if (community[level.targets[i]] == community[ukey])
+          sum += level.weights[i];
+      return sum;
+    };
+    double const inside   = transform_reduce(policy, detail::index_iterator<key_type>(0),
+                                             detail::index_iterator<key_type>(level.size()), 0.0, plus<double>(),
+                                             inside_fnc);
+    double const expected = transform_reduce(policy, total.begin(), total.end(), 0.0, plus<double>(),
+                                             [m2](double const tot) { return tot / m2 * (tot / m2); });
+    return inside / m2 - expected;
+  }
+
+  //! Make the communities into the vertices of next, where number[ukey] is the community of each
+  //! vertex of level in [0, count).
+  template <typename ExecutionPolicy, typename Pool>
+  void coarsen(ExecutionPolicy&&  policy,
+               level_graph const& level,
+               key_vector const&  number,
+               key_type const     count,
+               level_graph&       next,
+               Pool&              pool) {
+    key_type const n = level.size();
+
+    // the vertices of each community, by a counting sort
+    size_vector first(static_cast<size_t>(count) + 1, 0, alloc_);
+    for (key_type ukey = 0; ukey < n; ++ukey)
+      ++first[number[ukey] + 1];
+    inclusive_scan(policy, first.begin() + 1, first.end(), first.begin() + 1);
+    key_vector  members(n, alloc_);
+    size_vector pos(first.begin(), first.end() - 1, alloc_);
+    for (key_type ukey = 0; ukey < n; ++ukey)
+      members[pos[number[ukey]]++] = ukey;
+
+    // count the neighboring communities of each community, then fill the rows
+    next.offsets.assign(static_cast<size_t>(count) + 1, 0);
+    detail::for_each_block(policy, key_type(0), count, [&](key_type const cfirst, key_type const clast) {
+      auto ws = pool.acquire();
+      for (key_type c = cfirst; c < clast; ++c) {
+        gather(level, number, members, first, c, *ws);
+        next.offsets[c + 1] = ws->touched.size();
+        ws->reset();
+      }
+    });
+    inclusive_scan(policy, next.offsets.begin() + 1, next.offsets.end(), next.offsets.begin() + 1);
+    next.targets.resize(next.offsets[count]);
+    next.weights.resize(next.offsets[count]);
+    next.degree.resize(count);
+    detail::for_each_block(policy, key_type(0), count, [&](key_type const cfirst, key_type const clast) {
+      auto ws = pool.acquire();
+      for (key_type c = cfirst; c < clast; ++c) {
+        gather(level, number, members, first, c, *ws);
+        double degree = 0.0;
+        size_t i      = next.offsets[c];
+        for (key_type const d : ws->touched) {
+          next.targets[i]   = d;
+          next.weights[i++] = ws->weight[d];
+          degree += ws->weight[d];
+        }
+        next.degree[c] = degree;
+        ws->reset();
+      }
+    });
+  }
+
+  //! Sum the weights from the vertices of community c to each community.
+  static void gather(level_graph const& level,
+                     key_vector const&  number,
+                     key_vector const&  members,
+                     size_vector const& first,
+                     key_type const     c,
+                     workspace&         ws) {
+    for (size_t m = first[c]; m < first[c + 1]; ++m) {
+      key_type const ukey = members[m];
+      for (size_t i = level.offsets[ukey]; i < level.offsets[ukey + 1]; ++i)
+        ws.add(number[level.targets[i]], level.weights[i]);
+    }
+  }
+
+private:
+  graph_type&    g_;
+  WeightFnc&     weight_fnc_;
+  allocator_type alloc_;
+};
+
+
+//! Find communities by asynchronous label propagation, ignoring the direction of edges.
+//!
+//! @param policy         The execution policy used.
+//! @param g              The graph
+//! @param community_iter The beginning of a random-access range of size(g) values, where
+//!                       community_iter[ukey] is assigned the community of ukey in [0, count).
+//! @param max_iterations The maximum number of times each vertex is updated.
+//! @param alloc          The allocator to use for internal containers.
+//! @return               The number of communities.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CommunityIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+vertex_key_t<G> label_propagation(ExecutionPolicy&& policy,
+                                  G&                g,
+                                  CommunityIter     community_iter,
+                                  size_t const      max_iterations = 100,
+                                  A                 alloc          = A())
+// clang-format on
+{
+  label_propagation_fn<G, A> fn(policy, g, alloc);
+  return fn(policy, community_iter, false, max_iterations);
+}
+
+//! Find communities by asynchronous label propagation, ignoring the direction of edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CommunityIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+vertex_key_t<G>
+label_propagation(G& g, CommunityIter community_iter, size_t const max_iterations = 100, A alloc = A())
+// clang-format on
+{
+  return label_propagation(execution::seq, g, community_iter, max_iterations, alloc);
+}
+
+//! Find communities by synchronous label propagation, ignoring the direction of edges.
+//!
+//! @param policy         The execution policy used.
+//! @param g              The graph
+//! @param community_iter The beginning of a random-access range of size(g) values, where
+//!                       community_iter[ukey] is assigned the community of ukey in [0, count).
+//! @param max_iterations The maximum number of iterations.
+//! @param alloc          The allocator to use for internal containers.
+//! @return               The number of communities.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CommunityIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+vertex_key_t<G> synchronous_label_propagation(ExecutionPolicy&& policy,
+                                              G&                g,
+                                              CommunityIter     community_iter,
+                                              size_t const      max_iterations = 100,
+                                              A                 alloc          = A())
+// clang-format on
+{
+  label_propagation_fn<G, A> fn(policy, g, alloc);
+  return fn(policy, community_iter, true, max_iterations);
+}
+
+//! Find communities by synchronous label propagation, ignoring the direction of edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CommunityIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+vertex_key_t<G>
+synchronous_label_propagation(G& g, CommunityIter community_iter, size_t const max_iterations = 100, A alloc = A())
+// clang-format on
+{
+  return synchronous_label_propagation(execution::seq, g, community_iter, max_iterations, alloc);
+}
+
+//! Find communities that maximize modularity with the Louvain algorithm, ignoring the direction
+//! of edges.
+//!
+//! @param policy         The execution policy used.
+//! @param g              The graph
+//! @param community_iter The beginning of a random-access range of size(g) values, where
+//!                       community_iter[ukey] is assigned the community of ukey in [0, count).
+//! @param weight_fnc     The weight function object, called with the value of an edge. Weights
+//!                       must be non-negative.
+//! @param tolerance      The smallest improvement of modularity for another pass over the
+//!                       vertices of a level.
+//! @param alloc          The allocator to use for internal containers.
+//! @return               The number of communities.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CommunityIter,
+          typename               WeightFnc,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<WeightFnc, edge_value_t<G>&>>
+vertex_key_t<G> louvain_communities(ExecutionPolicy&& policy,
+                                    G&                g,
+                                    CommunityIter     community_iter,
+                                    WeightFnc         weight_fnc,
+                                    double const      tolerance = 1e-6,
+                                    A                 alloc     = A())
+// clang-format on
+{
+  louvain_fn<G, WeightFnc, A> fn(g, weight_fnc, alloc);
+  return fn(policy, community_iter, tolerance);
+}
+
+//! Find communities that maximize modularity with the Louvain algorithm, ignoring the direction
+//! of edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CommunityIter,
+          typename               WeightFnc,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<WeightFnc, edge_value_t<G>&>>
+vertex_key_t<G> louvain_communities(
+      G& g, CommunityIter community_iter, WeightFnc weight_fnc, double const tolerance = 1e-6, A alloc = A())
+// clang-format on
+{
+  return louvain_communities(execution::seq, g, community_iter, weight_fnc, tolerance, alloc);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_COMMUNITY_HPP
@@ -3,6 +3,13 @@
 //
 
 #include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <stack>
 #include <vector>
 
 #ifndef GRAPH_COMPONENTS_HPP
@@ -53,7 +60,7 @@ protected:
   using visited_type  = vector<bool, visited_alloc>;
 
 public:
-  con_comp_fn(graph_type& g, A alloc) : graph_(g), alloc_(alloc), stack_(alloc), visited_(alloc) {}
+  con_comp_fn(graph_type& g, A alloc) : graph_(g), alloc_(alloc), stack_(alloc), visited_(ranges::size(g), alloc) {}
 
   graph_type&       graph() { return graph_; }
   const graph_type& graph() const { return graph_; }
@@ -76,9 +83,10 @@ protected:
     while (!stack_.empty()) {
       vertex_iterator_t<G> u = stack_.top();
       stack_.pop();
-      for (vertex_edge_iterator_t<G> v = begin(graph_, u); v != end(graph_, u); ++u) {
-        vertex_key_t<G> v_key = vertex_key(graph_, v, u);
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges(graph_, u)); uv != ranges::end(edges(graph_, u)); ++uv) {
+        vertex_key_t<G> v_key = vertex_key(graph_, uv, u);
         if (!visited_[v_key]) {
+          vertex_iterator_t<G> v = vertex(graph_, uv, u);
           stack_.push(v);
           visited_[v_key] = true;
           *result_iter    = component_type(curr_comp_, v);
@@ -101,7 +109,7 @@ template <incidence_graph G,
           typename        OutIter, 
           integral        CompT = uint32_t, 
           typename        A     = allocator<char>>
-  requires directed<G> && 
+  requires undirected<G> && 
            ranges::random_access_range<vertex_range_t<G>> && 
            integral<vertex_key_t<G>> &&
            output_iterator<OutIter, component<G, CompT>> 
@@ -111,7 +119,7 @@ void connected_components(G&                   g,
                           A                    alloc = A())
 // clang-format on
 {
-  con_comp_fn cc(g, alloc);
+  con_comp_fn<G, OutIter, CompT, A> cc(g, alloc);
   cc(start, result_iter);
 }
 
@@ -130,16 +138,185 @@ void connected_components(G&                g,
                           A                 alloc = A())
 // clang-format on
 {
-  con_comp_fn cc(g, alloc);
+  con_comp_fn<G, OutIter, CompT, A> cc(g, alloc);
   cc(rng, result_iter);
 }
 
+//---------------------------------------------------------------------------------------
+// Parallel Connected Components (Afforest, for undirected graphs)
+//
+// Each vertex holds the key of its parent in a forest, starting as itself, and an edge is
+// processed by linking the roots of its two vertices, where the larger root is hooked onto the
+// smaller with a compare-and-swap. The parents are kept directly in the caller's component array,
+// so no other memory is needed. After all edges are linked, every vertex is compressed to point to
+// its root, which is the smallest vertex key in its component.
+//
+// Afforest (Sutton et al.) avoids linking most edges. The first few edges of every vertex are
+// linked in rounds, which is usually enough to form most of the largest component. The largest
+// component is found by sampling, and the remaining edges are only linked for vertices outside of
+// it; an edge from a vertex in it to one outside is linked when the other vertex is processed,
+// which requires each edge to be in the edges of both vertices.
+//
+// clang-format off
+template <incidence_graph G, random_access_iterator CompIter>
+  requires undirected<G> && integral<iter_value_t<CompIter>>
+class afforest_fn
+// clang-format on
+{
+public:
+  using graph_type            = G;
+  using component_number_type = iter_value_t<CompIter>;
+  using key_type              = vertex_key_t<G>;
+
+  afforest_fn(graph_type& g, CompIter component_iter) : graph_(g), comp_(component_iter) {}
+
+  template <typename ExecutionPolicy>
+  void operator()(ExecutionPolicy&& policy, size_t const neighbor_rounds) {
+    key_type const n = static_cast<key_type>(ranges::size(graph_));
+    detail::for_each_index(policy, key_type(0), n,
+                           [this](key_type const ukey) { parent(ukey) = static_cast<component_number_type>(ukey); });
+
+    // link the first neighbor_rounds edges of each vertex, one at a time
+    for (size_t r = 0; r < neighbor_rounds; ++r) {
+      detail::for_each_index(policy, key_type(0), n, [this, r](key_type const ukey) {
+        vertex_iterator_t<G>      u         = find_vertex(graph_, ukey);
+        vertex_edge_range_t<G>    edges_rng = edges(graph_, u);
+        vertex_edge_iterator_t<G> uv        = ranges::begin(edges_rng);
+        for (size_t i = 0; i < r && uv != ranges::end(edges_rng); ++i)
+          ++uv;
+        if (uv != ranges::end(edges_rng))
+          link(ukey, vertex_key(graph_, uv, ukey));
+      });
+      compress(policy, n);
+    }
+
+    // link the remaining edges of vertices outside the largest component
+    component_number_type const largest = sample_largest(n);
+    detail::for_each_index(policy, key_type(0), n, [this, largest, neighbor_rounds](key_type const ukey) {
+      if (detail::atomic_load(parent(ukey)) == largest)
+        return;
+      vertex_iterator_t<G>      u         = find_vertex(graph_, ukey);
+      vertex_edge_range_t<G>    edges_rng = edges(graph_, u);
+      vertex_edge_iterator_t<G> uv        = ranges::begin(edges_rng);
+      for (size_t i = 0; i < neighbor_rounds && uv != ranges::end(edges_rng); ++i)
+        ++uv;
+      for (; uv != ranges::end(edges_rng); ++uv)
+        link(ukey, vertex_key(graph_, uv, ukey));
+    });
+    compress(policy, n);
+  }
+
+protected:
+  //! The parent of a vertex, identified by its key or component number.
+  template <integral K>
+  component_number_type& parent(K const ukey) {
+    return comp_[static_cast<iter_difference_t<CompIter>>(ukey)];
+  }
+
+  //! Join the trees of ukey and vkey by hooking the larger root onto the smaller. A root is only
+  //! changed when it's still a root, so concurrent links never create a cycle.
+  void link(key_type const ukey, key_type const vkey) {
+    component_number_type p1 = detail::atomic_load(parent(ukey));
+    component_number_type p2 = detail::atomic_load(parent(vkey));
+    while (p1 != p2) {
+      component_number_type const high   = max(p1, p2);
+      component_number_type const low    = min(p1, p2);
+      component_number_type const p_high = detail::atomic_load(parent(high));
+      if (p_high == low || (p_high == high && detail::atomic_compare_exchange(parent(high), high, low)))
+        break;
+      p1 = detail::atomic_load(parent(detail::atomic_load(parent(high))));
+      p2 = detail::atomic_load(parent(low));
+    }
+  }
+
+  //! Point every vertex directly at its root.
+  template <typename ExecutionPolicy>
+  void compress(ExecutionPolicy&& policy, key_type const n) {
+    detail::for_each_index(policy, key_type(0), n, [this](key_type const ukey) {
+      component_number_type p = detail::atomic_load(parent(ukey));
+      for (component_number_type pp; p != (pp = detail::atomic_load(parent(p)));)
+        p = pp;
+      detail::atomic_store(parent(ukey), p);
+    });
+  }
+
+  //! The most frequent root in a random sample of vertices.
+  component_number_type sample_largest(key_type const n) {
+    constexpr size_t              num_samples = 1024;
+    vector<component_number_type> samples;
+    if (n == 0)
+      return component_number_type(0);
+    samples.reserve(num_samples);
+    mt19937                          gen(27491095); // fixed seed for repeatable results
+    uniform_int_distribution<size_t> dist(0, static_cast<size_t>(n) - 1);
+    for (size_t i = 0; i < num_samples; ++i)
+      samples.push_back(parent(static_cast<key_type>(dist(gen))));
+
+    ranges::sort(samples);
+    component_number_type largest     = samples.front();
+    size_t                largest_cnt = 0;
+    for (auto first = samples.begin(); first != samples.end();) {
+      auto last = find_if(first, samples.end(), [first](component_number_type c) { return c != *first; });
+      if (static_cast<size_t>(last - first) > largest_cnt) {
+        largest     = *first;
+        largest_cnt = static_cast<size_t>(last - first);
+      }
+      first = last;
+    }
+    return largest;
+  }
+
+protected:
+  graph_type& graph_;
+  CompIter    comp_;
+};
+
+//! Find the connected components of an undirected graph in parallel using the Afforest algorithm.
+//!
+//! @param policy      The execution policy used.
+//! @param g           The graph. Each edge must be in the edges of both of its vertices.
+//! @param component_iter
+//!                    The beginning of a random-access range of size(g) values, where
+//!                    component_iter[ukey] is assigned the component of ukey. The component is
+//!                    the smallest vertex key in the component.
+//! @param neighbor_rounds
+//!                    The number of edges of each vertex that are linked before the largest
+//!                    component is sampled. 2 is usually enough to form most of it.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CompIter>
+  requires execution_policy<ExecutionPolicy> &&
+           undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CompIter>> &&
+           is_lvalue_reference_v<iter_reference_t<CompIter>>
+void connected_components(ExecutionPolicy&& policy,
+                          G&                g,
+                          CompIter          component_iter,
+                          size_t const      neighbor_rounds = 2)
+// clang-format on
+{
+  afforest_fn<G, CompIter> cc(g, component_iter);
+  cc(policy, neighbor_rounds);
+}
+
 //---------------------------------------------------------------------------------------
 // Strongly Connected Components (Tarjen's algorithm for directed graphs)
 //
+// The depth-first search is iterative, with an explicit stack of edge iterators, so graphs of any
+// depth can be used. The discovery index and low-link of each vertex are kept in flat arrays
+// indexed by vertex key. A vertex is on the component stack while it has been discovered and its
+// low-link isn't assigned(), which is set when its component is complete.
+//
+// Components are numbered in the order they're completed, which is a reverse topological order
+// of the condensed graph.
+//
 // clang-format off
-template <incidence_graph G, typename OutIter, integral CompT = uint32_t, typename A = allocator<char>>
-  requires directed<G> && output_iterator<OutIter, component<G, CompT>>
+template <incidence_graph G, integral CompT = uint32_t, typename A = allocator<char>>
+  requires directed<G>
 class tarjen_scc_fn
 // clang-format on
 {
@@ -148,88 +325,124 @@ public:
   using allocator_type        = A;
   using component_number_type = CompT;
   using component_type        = component<graph_type, component_number_type>;
+  using key_type              = vertex_key_t<G>;
 
 public:
   tarjen_scc_fn(graph_type& g, allocator_type alloc = A())
         : graph_(g)
         , alloc_(alloc)
+        , index_(ranges::size(g), undiscovered(), alloc)
+        , low_(ranges::size(g), undiscovered(), alloc)
         , stack_(alloc)
-        , visited_(ranges::size(g), alloc)
-        , in_stack_(ranges::size(g), alloc) {}
+        , dfs_(alloc) {}
 
-  void operator()(vertex_iterator_t<G> start, OutIter result_iter) { eval_scc(start, result_iter); }
+  //! Output the components of the vertices reachable from start.
+  template <output_iterator<component_type> OutIter>
+  void operator()(vertex_iterator_t<G> start, OutIter result_iter) {
+    eval_scc(vertex_key(graph_, start), output_fnc(result_iter));
+  }
 
+  //! Output the components of the vertices reachable from the vertices in rng.
+  template <output_iterator<component_type> OutIter>
   void operator()(vertex_range_t<G> rng, OutIter result_iter) {
+    auto output = output_fnc(result_iter);
     for (vertex_iterator_t<G> it = begin(rng); it != end(rng); ++it)
-      eval_scc(it, result_iter);
+      eval_scc(vertex_key(graph_, it), output);
+  }
+
+  //! Assign the component of every vertex to component_iter[vkey].
+  //! @return The number of components.
+  template <random_access_iterator CompIter>
+  CompT operator()(CompIter component_iter) {
+    auto assign = [&component_iter](key_type const vkey, CompT const comp) {
+      component_iter[static_cast<iter_difference_t<CompIter>>(vkey)] = static_cast<iter_value_t<CompIter>>(comp);
+    };
+    for (key_type ukey = 0; ukey < static_cast<key_type>(ranges::size(graph_)); ++ukey)
+      eval_scc(ukey, assign);
+    return curr_comp_;
   }
 
 protected:
-  struct visit_elem {
-    CompT discovered = undiscovered();
-    CompT low        = undiscovered();
+  using key_alloc  = typename allocator_traits<A>::template rebind_alloc<key_type>;
+  using key_vector = vector<key_type, key_alloc>;
 
-    visit_elem()                  = default;
-    visit_elem(const visit_elem&) = default;
-    visit_elem& operator=(const visit_elem&) = default;
+  struct dfs_elem {
+    key_type                  ukey;
+    vertex_edge_iterator_t<G> uv;   // next edge to visit
+    vertex_edge_iterator_t<G> last; // end of the edges
   };
-  using visited_alloc = typename allocator_traits<A>::template rebind_alloc<visit_elem>;
-  using visited_type  = vector<visit_elem, visited_alloc>;
-
-  using stack_elem  = vertex_iterator_t<G>;
-  using stack_alloc = typename allocator_traits<A>::template rebind_alloc<stack_elem>;
-  using stack_type  = stack<stack_elem, deque<stack_elem, stack_alloc>>;
-
-  using in_stack_alloc = typename allocator_traits<A>::template rebind_alloc<bool>;
-  using in_stack_type  = vector<bool, in_stack_alloc>;
+  using dfs_alloc = typename allocator_traits<A>::template rebind_alloc<dfs_elem>;
+  using dfs_stack = vector<dfs_elem, dfs_alloc>;
 
 protected:
-  constexpr static CompT undiscovered() { return numeric_limits<CompT>::max(); }
+  constexpr static key_type undiscovered() { return numeric_limits<key_type>::max(); }
+  constexpr static key_type assigned() { return numeric_limits<key_type>::max(); }
+
+  template <typename OutIter>
+  auto output_fnc(OutIter& result_iter) {
+    return [this, &result_iter](key_type const vkey, CompT const comp) {
+      *result_iter = component_type(comp, find_vertex(graph_, vkey));
+      ++result_iter;
+    };
+  }
+
+  void discover(key_type const ukey) {
+    index_[ukey] = low_[ukey] = next_seq_++;
+    stack_.push_back(ukey);
+    vertex_edge_range_t<G> edges_rng = edges(graph_, find_vertex(graph_, ukey));
+    dfs_.push_back({ukey, ranges::begin(edges_rng), ranges::end(edges_rng)});
+  }
 
-  void eval_scc(vertex_iterator_t<G> u, OutIter result_iter) {
-    component_number_type const u_key = static_cast<component_number_type>(vertex_key(graph_, u));
-    if (visited_[u_key].discovered != undiscovered())
+  //! Find the components of the vertices reachable from seed that haven't been visited yet,
+  //! calling assign_fnc(vkey, component_number) for each vertex when its component is complete.
+  template <typename AssignFnc>
+  void eval_scc(key_type const seed, AssignFnc&& assign_fnc) {
+    if (index_[seed] != undiscovered())
       return;
 
-    visited_[u_key].discovered = visited_[u_key].low = next_seq_++;
-    stack_.push(u);
-    in_stack_[u_key] = true;
-
-    for (vertex_edge_iterator_t<G> uv = ranges::begin(edges(graph_, u)); uv != ranges::end(edges(graph_, u)); ++uv) {
-      vertex_key_t<G> v_key = vertex_key(graph_, uv, u);
-      if (visited_[v_key].discovered == undiscovered()) {
-        eval_scc(vertex(graph_, uv, u), result_iter);
-        visited_[v_key].low = std::min(visited_[v_key].low, visited_[u_key].low);
-      } else if (in_stack_[v_key])
-        visited_[v_key].low = std::min(visited_[v_key].low, visited_[u_key].discovered);
-    }
+    discover(seed);
+    while (!dfs_.empty()) {
+      dfs_elem& top = dfs_.back();
+      if (top.uv != top.last) {
+        key_type const ukey = top.ukey;
+        key_type const vkey = vertex_key(graph_, top.uv, ukey);
+        ++top.uv;
+        if (index_[vkey] == undiscovered())
+          discover(vkey); // invalidates top
+        else if (low_[vkey] != assigned()) // on the stack
+          low_[ukey] = min(low_[ukey], index_[vkey]);
+        continue;
+      }
 
-    if (visited_[u_key].low == visited_[u_key].discovered) {
-      using result_type = component<G, CompT>;
-      while (stack_.top() != u) {
-        vertex_iterator_t<G> v     = stack_.top();
-        vertex_key_t<G>      v_key = vertex_key(graph_, v);
-        in_stack_[v_key]           = false;
-        *result_iter               = result_type(curr_comp_, v);
-        stack_.pop();
+      // all edges of u have been visited
+      key_type const ukey = top.ukey;
+      dfs_.pop_back();
+      if (low_[ukey] == index_[ukey]) {
+        // u is the root of a component; it & the vertices above it on the stack are in it
+        key_type vkey;
+        do {
+          vkey = stack_.back();
+          stack_.pop_back();
+          low_[vkey] = assigned();
+          assign_fnc(vkey, curr_comp_);
+        } while (vkey != ukey);
+        ++curr_comp_;
+      } else {
+        key_type const parent_key = dfs_.back().ukey; // u isn't a root, so it has a parent
+        low_[parent_key]          = min(low_[parent_key], low_[ukey]);
       }
-      vertex_iterator_t<G> v     = stack_.top();
-      vertex_key_t<G>      v_key = vertex_key(graph_, v);
-      in_stack_[v_key]           = false;
-      *result_iter               = result_type(curr_comp_, v);
-      stack_.pop();
-      ++curr_comp_;
     }
   }
 
 protected:
-  graph_type&           graph_;
-  allocator_type        alloc_;
-  stack_type            stack_;
-  visited_type          visited_;
-  in_stack_type         in_stack_;
-  component_number_type next_seq_  = 0; // next discovery sequence
-  component_number_type curr_comp_ = 0;
+  graph_type&    graph_;
+  allocator_type alloc_;
+  key_vector     index_;         // discovery sequence
+  key_vector     low_;           // low-link; assigned() once the component is known
+  key_vector     stack_;         // vertices in components that aren't complete
+  dfs_stack      dfs_;           // the depth-first search path
+  key_type       next_seq_  = 0; // next discovery sequence
+  CompT          curr_comp_ = 0;
 };
 
 // clang-format off
@@ -247,7 +460,7 @@ void strongly_connected_components(G&                   g,
                                    A                    alloc = A())
 // clang-format on
 {
-  tarjen_scc_fn<G, OutIter, CompT, A> scc(g, alloc);
+  tarjen_scc_fn<G, CompT, A> scc(g, alloc);
   scc(start, result_iter);
 }
 
@@ -266,10 +479,454 @@ void strongly_connected_components(G&                g,
                                    A alloc           = A())
 // clang-format on
 {
-  tarjen_scc_fn<G, OutIter, CompT, A> scc(g, alloc);
+  tarjen_scc_fn<G, CompT, A> scc(g, alloc);
   scc(rng, result_iter);
 }
 
+//! Find the strongly connected components of all vertices, assigning the component number of
+//! each vertex to a dense array.
+//!
+//! @param g           The graph
+//! @param component_iter
+//!                    The beginning of a random-access range of size(g) values, where
+//!                    component_iter[ukey] is assigned the component of ukey. Components are
+//!                    numbered from 0 in reverse topological order of the condensed graph.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The number of components.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CompIter,
+          typename               A = allocator<char>>
+  requires directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CompIter>>
+size_t strongly_connected_components(G& g, CompIter component_iter, A alloc = A())
+// clang-format on
+{
+  tarjen_scc_fn<G, iter_value_t<CompIter>, A> scc(g, alloc);
+  return static_cast<size_t>(scc(component_iter));
+}
+
+
+//---------------------------------------------------------------------------------------
+// Parallel Strongly Connected Components (Forward-Backward with trimming, for directed graphs)
+//
+// The outgoing and incoming edges are first copied into compressed arrays of vertex keys so both
+// directions can be traversed. Components are then found in three steps, each using parallel
+// level-synchronous searches where the vertices of a level are expanded concurrently:
+//
+// 1. Trimming. A vertex without incoming or outgoing edges from vertices that remain is a
+//    component by itself. Removing it may leave its neighbors without edges, so vertices are
+//    peeled in waves by decrementing their neighbors' edge counts until none are left to remove.
+//    This removes all vertices that aren't in or between cycles, in linear time.
+// 2. Forward-Backward. A pivot with many edges is likely to be in the largest component. The
+//    vertices that are reachable from it (forward) and that reach it (backward) are its component.
+// 3. Coloring. Each remaining vertex starts with its key as its color and the largest color is
+//    propagated forward. Each vertex whose color is its own key is a root, and the vertices with
+//    the same color that reach it are its component. This repeats until all vertices are assigned.
+//
+// Components are numbered in order of the smallest vertex key in them.
+//
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires directed<G>
+class fw_bw_scc_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+public:
+  fw_bw_scc_fn(graph_type& g, allocator_type alloc = A())
+        : graph_(g)
+        , alloc_(alloc)
+        , out_offsets_(alloc)
+        , out_keys_(alloc)
+        , in_offsets_(alloc)
+        , in_keys_(alloc)
+        , in_count_(alloc)
+        , out_count_(alloc)
+        , label_(alloc)
+        , color_(alloc)
+        , mark_(alloc)
+        , frontier_(alloc)
+        , next_(alloc) {}
+
+  //! Assign the component of every vertex to component_iter[vkey].
+  //! @return The number of components.
+  template <typename ExecutionPolicy, random_access_iterator CompIter>
+  size_t operator()(ExecutionPolicy&& policy, CompIter component_iter) {
+    init(policy);
+    trim(policy);
+    forward_backward(policy);
+    coloring(policy);
+    return number(policy, component_iter);
+  }
+
+protected:
+  using key_alloc   = typename allocator_traits<A>::template rebind_alloc<key_type>;
+  using key_vector  = vector<key_type, key_alloc>;
+  using size_alloc  = typename allocator_traits<A>::template rebind_alloc<size_t>;
+  using size_vector = vector<size_t, size_alloc>;
+  using mark_alloc  = typename allocator_traits<A>::template rebind_alloc<uint8_t>;
+  using mark_vector = vector<uint8_t, mark_alloc>;
+
+  constexpr static key_type unassigned() { return numeric_limits<key_type>::max(); }
+
+  bool is_assigned(key_type const ukey) { return detail::atomic_load(label_[ukey]) != unassigned(); }
+
+  //! Copy the outgoing & incoming edges into compressed arrays.
+  template <typename ExecutionPolicy>
+  void init(ExecutionPolicy&& policy) {
+    n_ = static_cast<key_type>(ranges::size(graph_));
+    out_offsets_.assign(static_cast<size_t>(n_) + 1, 0);
+    in_offsets_.assign(static_cast<size_t>(n_) + 1, 0);
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) {
+      out_offsets_[ukey + 1] = static_cast<size_t>(ranges::distance(edges(graph_, find_vertex(graph_, ukey))));
+    });
+    inclusive_scan(policy, out_offsets_.begin() + 1, out_offsets_.end(), out_offsets_.begin() + 1);
+
+    out_keys_.resize(out_offsets_[n_]);
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) {
+      size_t                 i         = out_offsets_[ukey];
+      vertex_edge_range_t<G> edges_rng = edges(graph_, find_vertex(graph_, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(graph_, uv, ukey);
+        out_keys_[i++]      = vkey;
+        atomic_ref<size_t>(in_offsets_[vkey + 1]).fetch_add(1, memory_order_relaxed);
+      }
+    });
+    inclusive_scan(policy, in_offsets_.begin() + 1, in_offsets_.end(), in_offsets_.begin() + 1);
+
+    in_keys_.resize(in_offsets_[n_]);
+    in_count_.assign(in_offsets_.begin(), in_offsets_.end() - 1); // next position for each vertex
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) {
+      for (size_t i = out_offsets_[ukey]; i < out_offsets_[ukey + 1]; ++i)
+        in_keys_[atomic_ref<size_t>(in_count_[out_keys_[i]]).fetch_add(1, memory_order_relaxed)] = ukey;
+    });
+
+    out_count_.resize(n_);
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) {
+      in_count_[ukey]  = in_offsets_[ukey + 1] - in_offsets_[ukey];
+      out_count_[ukey] = out_offsets_[ukey + 1] - out_offsets_[ukey];
+    });
+
+    label_.assign(n_, unassigned());
+    color_.resize(n_);
+    mark_.assign(n_, 0);
+    frontier_.resize(n_);
+    next_.resize(n_);
+  }
+
+  //! Expand the vertices in frontier_[0..size) in parallel, calling expand_fnc(ukey, push) for
+  //! each, where push(vkey) adds vkey to the next level. This repeats until a level is empty.
+  //! level_fnc(ukey) is called for each vertex of a level before it's expanded.
+  template <typename ExecutionPolicy, typename ExpandFnc, typename LevelFnc>
+  void search(ExecutionPolicy&& policy, size_t size, ExpandFnc&& expand_fnc, LevelFnc&& level_fnc) {
+    auto push = [this](key_type const vkey) {
+      next_[atomic_ref<size_t>(next_size_).fetch_add(1, memory_order_relaxed)] = vkey;
+    };
+    while (size > 0) {
+      next_size_ = 0;
+      detail::for_each_index(policy, size_t(0), size, [this, &level_fnc](size_t const i) { level_fnc(frontier_[i]); });
+      detail::for_each_index(policy, size_t(0), size,
+                             [this, &expand_fnc, &push](size_t const i) { expand_fnc(frontier_[i], push); });
+      swap(frontier_, next_);
+      size = next_size_;
+    }
+  }
+
+  template <typename ExecutionPolicy, typename ExpandFnc>
+  void search(ExecutionPolicy&& policy, size_t size, ExpandFnc&& expand_fnc) {
+    search(policy, size, expand_fnc, [](key_type) {});
+  }
+
+  //! Assign each vertex that isn't in a cycle to a component by itself.
+  template <typename ExecutionPolicy>
+  void trim(ExecutionPolicy&& policy) {
+    size_t size = 0;
+    detail::for_each_index(policy, key_type(0), n_, [this, &size](key_type const ukey) {
+      if (in_count_[ukey] == 0 || out_count_[ukey] == 0) {
+        label_[ukey] = ukey;
+        frontier_[atomic_ref<size_t>(size).fetch_add(1, memory_order_relaxed)] = ukey;
+      }
+    });
+
+    // removing u removes an incoming edge from each vertex after it, & an outgoing edge from each
+    // vertex before it
+    search(policy, size, [this](key_type const ukey, auto&& push) {
+      auto remove = [this, &push](key_type const vkey) {
+        if (detail::atomic_compare_exchange(label_[vkey], unassigned(), vkey))
+          push(vkey);
+      };
+      for (size_t i = out_offsets_[ukey]; i < out_offsets_[ukey + 1]; ++i)
+        if (atomic_ref<size_t>(in_count_[out_keys_[i]]).fetch_sub(1, memory_order_relaxed) == 1)
+          remove(out_keys_[i]);
+      for (size_t i = in_offsets_[ukey]; i < in_offsets_[ukey + 1]; ++i)
+        if (atomic_ref<size_t>(out_count_[in_keys_[i]]).fetch_sub(1, memory_order_relaxed) == 1)
+          remove(in_keys_[i]);
+    });
+  }
+
+  //! Find the component of the vertex with the most remaining edges.
+  template <typename ExecutionPolicy>
+  void forward_backward(ExecutionPolicy&& policy) {
+    key_type pivot      = unassigned();
+    size_t   pivot_degr = 0;
+    for (key_type ukey = 0; ukey < n_; ++ukey) {
+      size_t const degr = in_count_[ukey] * out_count_[ukey];
+      if (label_[ukey] == unassigned() && (pivot == unassigned() || degr > pivot_degr)) {
+        pivot      = ukey;
+        pivot_degr = degr;
+      }
+    }
+    if (pivot == unassigned())
+      return;
+
+    // mark the vertices reachable from the pivot
+    mark_[pivot] = 1;
+    frontier_[0] = pivot;
+    search(policy, 1, [this](key_type const ukey, auto&& push) {
+      for (size_t i = out_offsets_[ukey]; i < out_offsets_[ukey + 1]; ++i) {
+        key_type const vkey = out_keys_[i];
+        if (!is_assigned(vkey) && detail::atomic_compare_exchange(mark_[vkey], uint8_t(0), uint8_t(1)))
+          push(vkey);
+      }
+    });
+
+    // the marked vertices that reach the pivot are in its component
+    label_[pivot] = pivot;
+    frontier_[0]  = pivot;
+    search(policy, 1, [this, pivot](key_type const ukey, auto&& push) {
+      for (size_t i = in_offsets_[ukey]; i < in_offsets_[ukey + 1]; ++i) {
+        key_type const vkey = in_keys_[i];
+        if (detail::atomic_load(mark_[vkey]) && detail::atomic_compare_exchange(label_[vkey], unassigned(), pivot))
+          push(vkey);
+      }
+    });
+  }
+
+  //! Assign the remaining vertices to components by propagating colors.
+  template <typename ExecutionPolicy>
+  void coloring(ExecutionPolicy&& policy) {
+    for (;;) {
+      size_t size = 0;
+      detail::for_each_index(policy, key_type(0), n_, [this, &size](key_type const ukey) {
+        if (label_[ukey] == unassigned()) {
+          color_[ukey] = ukey;
+          frontier_[atomic_ref<size_t>(size).fetch_add(1, memory_order_relaxed)] = ukey;
+        }
+      });
+      if (size == 0)
+        break;
+
+      // propagate the largest color forward; a vertex is marked while it's in the next level
+      search(
+            policy, size,
+            [this](key_type const ukey, auto&& push) {
+              key_type const color = detail::atomic_load(color_[ukey]);
+              for (size_t i = out_offsets_[ukey]; i < out_offsets_[ukey + 1]; ++i) {
+                key_type const vkey = out_keys_[i];
+                if (!is_assigned(vkey) && detail::atomic_max(color_[vkey], color) &&
+                    detail::atomic_compare_exchange(mark_[vkey], uint8_t(0), uint8_t(1)))
+                  push(vkey);
+              }
+            },
+            [this](key_type const ukey) { mark_[ukey] = 0; });
+
+      // the vertices of the same color that reach a root, whose color is its own key, are its
+      // component
+      size = 0;
+      detail::for_each_index(policy, key_type(0), n_, [this, &size](key_type const ukey) {
+        if (label_[ukey] == unassigned() && color_[ukey] == ukey) {
+          label_[ukey] = ukey;
+          frontier_[atomic_ref<size_t>(size).fetch_add(1, memory_order_relaxed)] = ukey;
+        }
+      });
+      search(policy, size, [this](key_type const ukey, auto&& push) {
+        key_type const color = color_[ukey];
+        for (size_t i = in_offsets_[ukey]; i < in_offsets_[ukey + 1]; ++i) {
+          key_type const vkey = in_keys_[i];
+          if (color_[vkey] == color && detail::atomic_compare_exchange(label_[vkey], unassigned(), color))
+            push(vkey);
+        }
+      });
+    }
+  }
+
+  //! Number the components in order of their smallest vertex key.
+  //! @return The number of components.
+  template <typename ExecutionPolicy, random_access_iterator CompIter>
+  size_t number(ExecutionPolicy&& policy, CompIter component_iter) {
+    if (n_ == 0)
+      return 0;
+    // color_ holds the smallest key of each component, indexed by label
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) { color_[ukey] = unassigned(); });
+    detail::for_each_index(policy, key_type(0), n_,
+                           [this](key_type const ukey) { detail::atomic_min(color_[label_[ukey]], ukey); });
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) {
+      frontier_[ukey] = (color_[label_[ukey]] == ukey) ? key_type(1) : key_type(0);
+    });
+    exclusive_scan(policy, frontier_.begin(), frontier_.end(), next_.begin(), key_type(0));
+    detail::for_each_index(policy, key_type(0), n_, [this, &component_iter](key_type const ukey) {
+      component_iter[static_cast<iter_difference_t<CompIter>>(ukey)] =
+            static_cast<iter_value_t<CompIter>>(next_[color_[label_[ukey]]]);
+    });
+    return static_cast<size_t>(next_[n_ - 1] + frontier_[n_ - 1]);
+  }
+
+protected:
+  graph_type&    graph_;
+  allocator_type alloc_;
+  key_type       n_ = 0;
+  size_vector    out_offsets_; // out_keys_[out_offsets_[u]..out_offsets_[u+1]) are the targets of u
+  key_vector     out_keys_;
+  size_vector    in_offsets_; // in_keys_[in_offsets_[u]..in_offsets_[u+1]) are the sources of u
+  key_vector     in_keys_;
+  size_vector    in_count_;  // incoming edges from vertices that haven't been trimmed
+  size_vector    out_count_; // outgoing edges to vertices that haven't been trimmed
+  key_vector     label_;     // a vertex in the component, or unassigned()
+  key_vector     color_;
+  mark_vector    mark_;
+  key_vector     frontier_;
+  key_vector     next_;
+  size_t         next_size_ = 0;
+};
+
+//! Find the strongly connected components of all vertices in parallel, assigning the component
+//! number of each vertex to a dense array. The components are the same as those found by the
+//! other strongly_connected_components functions, but are numbered differently.
+//!
+//! @param policy      The execution policy used.
+//! @param g           The graph
+//! @param component_iter
+//!                    The beginning of a random-access range of size(g) values, where
+//!                    component_iter[ukey] is assigned the component of ukey. Components are
+//!                    numbered from 0 in order of the smallest vertex key in them.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The number of components.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CompIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CompIter>>
+size_t strongly_connected_components(ExecutionPolicy&& policy, G& g, CompIter component_iter, A alloc = A())
+// clang-format on
+{
+  fw_bw_scc_fn<G, A> scc(g, alloc);
+  return scc(policy, component_iter);
+}
+
+
+//---------------------------------------------------------------------------------------
+// Condensation (for directed graphs)
+//
+// The DAG of the strongly connected components of a graph, with an edge from one component to
+// another when there's an edge between vertices in them. Components are numbered by Tarjan's
+// algorithm, which completes a component only after every component reachable from it, so each
+// edge of the condensation goes from a larger component number to a smaller one and visiting the
+// components in increasing order is a reverse topological order.
+//
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires directed<G>
+class condensation
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+  using key_vector     = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using offset_vector  = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+  using key_range      = ranges::subrange<typename key_vector::const_iterator>;
+
+  condensation(graph_type& g, allocator_type alloc = A())
+        : component_(ranges::size(g), key_type(0), alloc)
+        , member_offsets_(alloc)
+        , members_(alloc)
+        , successor_offsets_(alloc)
+        , successors_(alloc)
+        , cyclic_(alloc) {
+    tarjen_scc_fn<G, key_type, A> scc(g, alloc);
+    size_t const                  ncomp = static_cast<size_t>(scc(component_.begin()));
+
+    // group the vertices by component
+    member_offsets_.assign(ncomp + 1, 0);
+    for (key_type const comp : component_)
+      ++member_offsets_[comp + 1];
+    inclusive_scan(member_offsets_.begin(), member_offsets_.end(), member_offsets_.begin());
+    members_.resize(component_.size());
+    offset_vector next(member_offsets_.begin(), member_offsets_.end() - 1, alloc);
+    for (key_type ukey = 0; ukey < static_cast<key_type>(component_.size()); ++ukey)
+      members_[next[component_[ukey]]++] = ukey;
+
+    // the distinct components at the other end of the edges leaving each component
+    successor_offsets_.reserve(ncomp + 1);
+    successor_offsets_.push_back(0);
+    cyclic_.assign(ncomp, false);
+    for (key_type comp = 0; comp < static_cast<key_type>(ncomp); ++comp) {
+      size_t const first = successors_.size();
+      for (key_type const ukey : members(comp)) {
+        vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+        for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+          key_type const vkey = vertex_key(g, uv, ukey);
+          if (component_[vkey] != comp)
+            successors_.push_back(component_[vkey]);
+          else if (vkey == ukey)
+            cyclic_[comp] = true; // self-loop
+        }
+      }
+      sort(successors_.begin() + static_cast<ptrdiff_t>(first), successors_.end());
+      successors_.erase(unique(successors_.begin() + static_cast<ptrdiff_t>(first), successors_.end()),
+                        successors_.end());
+      successor_offsets_.push_back(successors_.size());
+      if (members(comp).size() > 1)
+        cyclic_[comp] = true;
+    }
+  }
+
+  //! The number of vertices
+  size_t size() const noexcept { return component_.size(); }
+  //! The number of components
+  size_t components() const noexcept { return cyclic_.size(); }
+  //! The component that ukey is in
+  key_type component(key_type ukey) const noexcept { return component_[ukey]; }
+
+  //! The vertices in a component, in increasing key order.
+  key_range members(key_type comp) const noexcept {
+    return {members_.begin() + static_cast<ptrdiff_t>(member_offsets_[comp]),
+            members_.begin() + static_cast<ptrdiff_t>(member_offsets_[comp + 1])};
+  }
+  //! The components that have an edge from comp, in increasing order. They're all less than comp.
+  key_range successors(key_type comp) const noexcept {
+    return {successors_.begin() + static_cast<ptrdiff_t>(successor_offsets_[comp]),
+            successors_.begin() + static_cast<ptrdiff_t>(successor_offsets_[comp + 1])};
+  }
+  //! True if there's a path of one or more edges from comp to itself, that is, it has more than
+  //! one vertex or a self-loop.
+  bool is_cyclic(key_type comp) const noexcept { return cyclic_[comp]; }
+
+private:
+  using bool_vector = vector<bool, typename allocator_traits<A>::template rebind_alloc<bool>>;
+
+  key_vector    component_;
+  offset_vector member_offsets_;
+  key_vector    members_;
+  offset_vector successor_offsets_;
+  key_vector    successors_;
+  bool_vector   cyclic_;
+};
 
 } // namespace std::graph
 
@@ -0,0 +1,713 @@
+//
+// Contraction Hierarchies for fast point-to-point shortest distance & path queries on a static
+// graph with non-negative edge weights, such as a road network.
+//
+// Preprocessing contracts the vertices one at a time in order of increasing importance. When
+// vertex v is contracted, a shortcut edge u->w is added for each pair of neighbors where u->v->w
+// may be the only shortest path between them. This is determined by a local Dijkstra search from u
+// that ignores v (a witness search), limited to witness_limit settled vertices. The importance of a
+// vertex is estimated by its edge difference (shortcuts added less edges removed) plus the number
+// of its neighbors that have already been contracted and its level in the hierarchy, and is
+// updated lazily.
+//
+// For each vertex, the hierarchy keeps the edges to the vertices contracted after it in two compact
+// CSR arrays: upward edges v->w that are searched forward from the source, and downward edges w->v
+// (stored on v) that are searched backward from the target. A query is a bidirectional Dijkstra
+// that only goes up the hierarchy, with stall-on-demand, so only a small number of vertices are
+// settled regardless of the size of the graph. Paths are unpacked by recursively replacing each
+// shortcut with the two edges through its middle vertex.
+//
+// The ExecutionPolicy overload of build_contraction_hierarchy contracts an independent set of
+// vertices with a locally minimal priority in each round, running the witness searches and
+// priority updates in parallel. The contraction order differs from the sequential build, but the
+// distances returned by queries are the same.
+//
+// Queries are run with a contraction_hierarchy_query, which holds the search buffers and resets
+// only the entries touched by the previous query. A query object isn't thread-safe; use one per
+// thread on a shared hierarchy.
+//
+// NOTES
+//  Vertices keep their original keys in the hierarchy. Renumbering them by rank would improve the
+//  memory locality of queries at the cost of translating keys for the caller.
+//
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+
+#ifndef GRAPH_CONTRACTION_HIERARCHIES_HPP
+#  define GRAPH_CONTRACTION_HIERARCHIES_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+template <incidence_graph G, typename DistFnc, typename DistanceT, typename A>
+class contraction_hierarchy_fn;
+
+
+//! The preprocessed hierarchy created by build_contraction_hierarchy. The upward & downward edges
+//! of each vertex are kept in CSR form. Use a contraction_hierarchy_query to find the shortest
+//! distances & paths.
+//!
+template <integral KeyT, typename DistanceT, typename A = allocator<char>>
+class contraction_hierarchy {
+public:
+  using key_type       = KeyT;
+  using distance_type  = DistanceT;
+  using allocator_type = A;
+
+  static constexpr key_type null_key = numeric_limits<key_type>::max();
+
+  //! An edge in the hierarchy. key is the vertex at the other end of the edge. middle is the vertex
+  //! that a shortcut bypasses, or null_key for an edge from the original graph.
+  struct ch_edge {
+    key_type  key      = null_key;
+    key_type  middle   = null_key;
+    DistanceT distance = DistanceT();
+  };
+
+  using key_vector    = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using offset_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+  using edge_vector   = vector<ch_edge, typename allocator_traits<A>::template rebind_alloc<ch_edge>>;
+  using edge_range    = ranges::subrange<typename edge_vector::const_iterator>;
+
+  contraction_hierarchy(allocator_type alloc = allocator_type())
+        : rank_(alloc), up_offsets_(alloc), up_edges_(alloc), down_offsets_(alloc), down_edges_(alloc) {}
+
+  //! The number of vertices
+  size_t size() const noexcept { return rank_.size(); }
+  //! The number of shortcut edges that were added
+  size_t shortcuts() const noexcept { return shortcuts_; }
+  //! The order that ukey was contracted in, where 0 is the first (least important) vertex.
+  key_type rank(key_type ukey) const noexcept { return rank_[ukey]; }
+
+  //! Edges ukey->key where key has a higher rank than ukey.
+  edge_range up_edges(key_type ukey) const noexcept {
+    return {up_edges_.begin() + up_offsets_[ukey], up_edges_.begin() + up_offsets_[ukey + 1]};
+  }
+  //! Edges key->ukey where key has a higher rank than ukey.
+  edge_range down_edges(key_type ukey) const noexcept {
+    return {down_edges_.begin() + down_offsets_[ukey], down_edges_.begin() + down_offsets_[ukey + 1]};
+  }
+
+  //! Find the hierarchy edge ukey->vkey, which must exist.
+  ch_edge const& find_edge(key_type ukey, key_type vkey) const noexcept {
+    if (rank_[vkey] > rank_[ukey])
+      return *ranges::find(up_edges(ukey), vkey, &ch_edge::key);
+    return *ranges::find(down_edges(vkey), ukey, &ch_edge::key);
+  }
+
+  //! Write the vertices on the path for edge ukey->vkey to result_iter, replacing shortcuts with
+  //! the edges they bypass. ukey isn't written.
+  template <typename OutIter>
+  OutIter unpack_edge(key_type ukey, key_type vkey, OutIter result_iter) const {
+    vector<pair<key_type, key_type>> stk; // edges to unpack, next on top
+    stk.push_back({ukey, vkey});
+    while (!stk.empty()) {
+      auto [u, v] = stk.back();
+      stk.pop_back();
+      ch_edge const& uv = find_edge(u, v);
+      if (uv.middle == null_key) {
+        *result_iter = v;
+        ++result_iter;
+      } else {
+        stk.push_back({uv.middle, v});
+        stk.push_back({u, uv.middle});
+      }
+    }
+    return result_iter;
+  }
+
+private:
+  key_vector    rank_;
+  offset_vector up_offsets_;
+  edge_vector   up_edges_;
+  offset_vector down_offsets_;
+  edge_vector   down_edges_;
+  size_t        shortcuts_ = 0;
+
+  template <incidence_graph G, typename DistFnc, typename DT, typename AA>
+  friend class contraction_hierarchy_fn;
+};
+
+
+//! Finds shortest distances & paths on a contraction_hierarchy. The search buffers are sized to
+//! the number of vertices when constructed and are reused by each query.
+//!
+template <integral KeyT, typename DistanceT, typename A = allocator<char>>
+class contraction_hierarchy_query {
+public:
+  using hierarchy_t    = contraction_hierarchy<KeyT, DistanceT, A>;
+  using key_type       = KeyT;
+  using distance_type  = DistanceT;
+  using allocator_type = A;
+  using ch_edge        = typename hierarchy_t::ch_edge;
+
+  static constexpr key_type  null_key      = hierarchy_t::null_key;
+  static constexpr DistanceT null_distance = numeric_limits<DistanceT>::max();
+
+  contraction_hierarchy_query(hierarchy_t const& ch, allocator_type alloc = allocator_type())
+        : ch_(ch), fwd_(ch.size(), alloc), bwd_(ch.size(), alloc) {}
+
+  //! Find the shortest distance from source to target.
+  //! @return The distance, or numeric_limits<DistanceT>::max() if target isn't reachable.
+  DistanceT distance(key_type const source, key_type const target) {
+    search(source, target);
+    return best_;
+  }
+
+  //! Find the shortest path from source to target. The vertex keys on the path, from source to
+  //! target, are written to result_iter. Nothing is written if target isn't reachable.
+  //! @return The distance, or numeric_limits<DistanceT>::max() if target isn't reachable.
+  template <typename OutIter>
+  DistanceT path(key_type const source, key_type const target, OutIter result_iter) {
+    search(source, target);
+    if (meet_ == null_key)
+      return best_;
+
+    // source --> meet on the upward edges found by the forward search
+    vector<key_type> up_path;
+    for (key_type vkey = meet_; vkey != source; vkey = fwd_.pred[vkey])
+      up_path.push_back(vkey);
+    up_path.push_back(source);
+
+    *result_iter = source;
+    ++result_iter;
+    for (size_t i = up_path.size() - 1; i > 0; --i)
+      result_iter = ch_.unpack_edge(up_path[i], up_path[i - 1], result_iter);
+
+    // meet --> target on the downward edges found by the backward search
+    for (key_type ukey = meet_; ukey != target; ukey = bwd_.pred[ukey])
+      result_iter = ch_.unpack_edge(ukey, bwd_.pred[ukey], result_iter);
+    return best_;
+  }
+
+  //! Search the upward edges from source, calling settle_fnc(ukey, distance) for each vertex
+  //! settled that isn't stalled. Combined with backward_search, this is the building block for
+  //! bucket-based many-to-many distances.
+  template <typename SettleFnc>
+  void forward_search(key_type const source, SettleFnc&& settle_fnc) {
+    fwd_.reset();
+    fwd_.reach(source, 0, source);
+    while (!fwd_.heap.empty())
+      step<true>(fwd_, settle_fnc);
+  }
+
+  //! Search the downward edges backward from target, calling settle_fnc(ukey, distance) for each
+  //! vertex settled that isn't stalled, where distance is from ukey to target.
+  template <typename SettleFnc>
+  void backward_search(key_type const target, SettleFnc&& settle_fnc) {
+    bwd_.reset();
+    bwd_.reach(target, 0, target);
+    while (!bwd_.heap.empty())
+      step<false>(bwd_, settle_fnc);
+  }
+
+protected:
+  struct search_dir {
+    using dist_alloc = typename allocator_traits<A>::template rebind_alloc<DistanceT>;
+    using key_alloc  = typename allocator_traits<A>::template rebind_alloc<key_type>;
+    using heap_entry = pair<DistanceT, key_type>;
+    using heap_alloc = typename allocator_traits<A>::template rebind_alloc<heap_entry>;
+
+    search_dir(size_t n, allocator_type alloc)
+          : dist(n, null_distance, alloc), pred(n, null_key, alloc), touched(alloc), heap(alloc) {}
+
+    void reset() {
+      for (key_type ukey : touched)
+        dist[ukey] = null_distance;
+      touched.clear();
+      heap.clear();
+    }
+    void reach(key_type const ukey, DistanceT const d, key_type const pred_key) {
+      if (dist[ukey] == null_distance)
+        touched.push_back(ukey);
+      dist[ukey] = d;
+      pred[ukey] = pred_key;
+      heap.push_back({d, ukey});
+      push_heap(heap.begin(), heap.end(), greater<heap_entry>());
+    }
+    bool active(DistanceT const best) const { return !heap.empty() && heap.front().first < best; }
+
+    vector<DistanceT, dist_alloc>  dist;
+    vector<key_type, key_alloc>    pred;
+    vector<key_type, key_alloc>    touched;
+    vector<heap_entry, heap_alloc> heap; // min-heap of {distance, key}
+  };
+
+  void search(key_type const source, key_type const target) {
+    fwd_.reset();
+    bwd_.reset();
+    best_ = null_distance;
+    meet_ = null_key;
+
+    fwd_.reach(source, 0, source);
+    bwd_.reach(target, 0, target);
+    // a direction is done when its closest vertex is no closer than the best path found
+    for (bool fwd_active = true, bwd_active = true; fwd_active || bwd_active;) {
+      if (fwd_active && (!bwd_active || fwd_.heap.front().first <= bwd_.heap.front().first))
+        step<true>(fwd_, [this](key_type ukey, DistanceT u_dist) { meet(ukey, u_dist, bwd_); });
+      else
+        step<false>(bwd_, [this](key_type ukey, DistanceT u_dist) { meet(ukey, u_dist, fwd_); });
+      fwd_active = fwd_.active(best_);
+      bwd_active = bwd_.active(best_);
+    }
+  }
+
+  void meet(key_type const ukey, DistanceT const u_dist, search_dir const& other) {
+    if (other.dist[ukey] != null_distance && u_dist + other.dist[ukey] < best_) {
+      best_ = u_dist + other.dist[ukey];
+      meet_ = ukey;
+    }
+  }
+
+  //! Settle the closest vertex in the search direction. The forward search follows the upward
+  //! edges and the backward search follows the downward edges. A vertex is stalled, and its edges
+  //! aren't relaxed, when it can be reached with a shorter distance through a higher vertex.
+  //! settle_fnc(ukey, distance) is called for the vertex if it isn't stalled.
+  template <bool Forward, typename SettleFnc>
+  void step(search_dir& dir, SettleFnc&& settle_fnc) {
+    pop_heap(dir.heap.begin(), dir.heap.end(), greater<typename search_dir::heap_entry>());
+    auto [u_dist, ukey] = dir.heap.back();
+    dir.heap.pop_back();
+    if (u_dist != dir.dist[ukey])
+      return; // stale entry
+
+    for (ch_edge const& wu : Forward ? ch_.down_edges(ukey) : ch_.up_edges(ukey))
+      if (dir.dist[wu.key] != null_distance && dir.dist[wu.key] + wu.distance < u_dist)
+        return; // stalled
+    settle_fnc(ukey, u_dist);
+
+    for (ch_edge const& uv : Forward ? ch_.up_edges(ukey) : ch_.down_edges(ukey)) {
+      DistanceT const v_dist = u_dist + uv.distance;
+      if (v_dist < dir.dist[uv.key])
+        dir.reach(uv.key, v_dist, ukey);
+    }
+  }
+
+private:
+  hierarchy_t const& ch_;
+  search_dir         fwd_;
+  search_dir         bwd_;
+  DistanceT          best_ = null_distance;
+  key_type           meet_ = null_key;
+};
+
+
+//! Internal implementation of the contraction hierarchy preprocessing.
+//!
+template <incidence_graph G, typename DistFnc, typename DistanceT, typename A = allocator<char>>
+class contraction_hierarchy_fn {
+public:
+  using graph_t        = G;
+  using distance_fnc_t = DistFnc;
+  using allocator_t    = A;
+  using key_t          = vertex_key_t<G>;
+  using hierarchy_t    = contraction_hierarchy<key_t, DistanceT, A>;
+  using ch_edge        = typename hierarchy_t::ch_edge;
+
+  static constexpr key_t     null_key      = hierarchy_t::null_key;
+  static constexpr DistanceT null_distance = numeric_limits<DistanceT>::max();
+
+  contraction_hierarchy_fn(graph_t& g, DistFnc distance_fnc, size_t const witness_limit, allocator_t alloc)
+        : g_(g), distance_fnc_(distance_fnc), witness_limit_(witness_limit), alloc_(alloc) {}
+
+  //! Contract the vertices one at a time in priority order.
+  hierarchy_t build() {
+    init();
+    witness_search ws(size());
+
+    using prio_entry = pair<ptrdiff_t, key_t>;
+    vector<prio_entry> q;
+    auto               q_push = [&q](ptrdiff_t const prio, key_t const ukey) {
+      q.push_back({prio, ukey});
+      push_heap(q.begin(), q.end(), greater<prio_entry>());
+    };
+    for (key_t ukey = 0; ukey < static_cast<key_t>(size()); ++ukey)
+      q_push(priority_[ukey] = simulate(ws, ukey, nullptr), ukey);
+
+    shortcut_list shortcuts;
+    vector<key_t> neighbors;
+    while (!q.empty()) {
+      pop_heap(q.begin(), q.end(), greater<prio_entry>());
+      auto [prio, ukey] = q.back();
+      q.pop_back();
+      if (state_[ukey] == contracted || prio != priority_[ukey])
+        continue; // stale entry
+
+      // lazy update: if the priority has increased past the next vertex, try again later
+      shortcuts.clear();
+      ptrdiff_t const cur_prio = simulate(ws, ukey, &shortcuts);
+      if (cur_prio > prio && !q.empty() && cur_prio > q.front().first) {
+        q_push(priority_[ukey] = cur_prio, ukey);
+        continue;
+      }
+
+      neighbors.clear();
+      contract(ukey, shortcuts, neighbors);
+      for (key_t vkey : neighbors)
+        q_push(priority_[vkey] = simulate(ws, vkey, nullptr), vkey);
+    }
+    return finish();
+  }
+
+  //! Contract an independent set of vertices with a locally minimal priority on each round,
+  //! running the witness searches & priority updates in parallel.
+  template <typename ExecutionPolicy>
+  hierarchy_t build(ExecutionPolicy&& policy) {
+    init();
+    auto make_ws = [this]() { return witness_search(size()); };
+    detail::workspace_pool<witness_search, decltype(make_ws)> pool(make_ws);
+
+    detail::for_each_index(policy, key_t(0), static_cast<key_t>(size()), [&](key_t const ukey) {
+      auto ws         = pool.acquire();
+      priority_[ukey] = simulate(*ws, ukey, nullptr);
+    });
+
+    vector<key_t>         remaining(size());
+    vector<key_t>         selected, neighbors;
+    vector<shortcut_list> shortcuts;
+    vector<char>          updated(size(), false);
+    iota(remaining.begin(), remaining.end(), key_t(0));
+    while (!remaining.empty()) {
+      // select the vertices with a lower priority than all of their neighbors
+      detail::for_each_index(policy, size_t(0), remaining.size(), [&](size_t const i) {
+        key_t const ukey = remaining[i];
+        if (locally_minimal(ukey))
+          state_[ukey] = contracting;
+      });
+      selected.clear();
+      ranges::copy_if(remaining, back_inserter(selected), [this](key_t ukey) { return state_[ukey] == contracting; });
+
+      // find the shortcuts, ignoring all vertices being contracted in the witness searches
+      if (shortcuts.size() < selected.size())
+        shortcuts.resize(selected.size());
+      detail::for_each_index(policy, size_t(0), selected.size(), [&](size_t const i) {
+        auto ws = pool.acquire();
+        shortcuts[i].clear();
+        simulate(*ws, selected[i], &shortcuts[i]);
+      });
+
+      // contracting modifies the neighbors' edges, so it's done sequentially
+      neighbors.clear();
+      for (size_t i = 0; i < selected.size(); ++i)
+        contract(selected[i], shortcuts[i], neighbors);
+      erase_if(remaining, [this](key_t ukey) { return state_[ukey] == contracted; });
+
+      // update the priorities of the neighbors of the contracted vertices
+      erase_if(neighbors, [&updated](key_t vkey) { return exchange(updated[vkey], true); });
+      detail::for_each_index(policy, size_t(0), neighbors.size(), [&](size_t const i) {
+        auto ws                 = pool.acquire();
+        priority_[neighbors[i]] = simulate(*ws, neighbors[i], nullptr);
+        updated[neighbors[i]]   = false;
+      });
+    }
+    return finish();
+  }
+
+protected:
+  enum vertex_state : char {
+    active,      // not contracted yet
+    contracting, // being contracted in the current round
+    contracted
+  };
+
+  struct shortcut {
+    key_t     ukey;
+    key_t     vkey;
+    key_t     middle;
+    DistanceT distance;
+  };
+  using shortcut_list = vector<shortcut>;
+  using edge_list     = vector<ch_edge>;
+
+  //! Buffers for a witness search, reset sparsely after each search.
+  struct witness_search {
+    using heap_entry = pair<DistanceT, key_t>;
+
+    witness_search(size_t n) : dist(n, null_distance), target(n, false) {}
+
+    void reset() {
+      for (key_t ukey : touched)
+        dist[ukey] = null_distance;
+      touched.clear();
+      heap.clear();
+    }
+
+    vector<DistanceT>  dist;
+    vector<char>       target; // out-neighbors of the vertex being contracted, other than the source
+    vector<key_t>      touched;
+    vector<heap_entry> heap; // min-heap of {distance, key}
+  };
+
+  size_t size() const noexcept { return out_.size(); }
+
+  //! Copy the edges from the graph into the adjacency lists used for contraction. Self-loops are
+  //! ignored and only the shortest of parallel edges is kept.
+  void init() {
+    size_t const n = ranges::size(g_);
+    out_.assign(n, edge_list());
+    in_.assign(n, edge_list());
+    up_.assign(n, edge_list());
+    down_.assign(n, edge_list());
+    state_.assign(n, active);
+    priority_.assign(n, 0);
+    deleted_neighbors_.assign(n, 0);
+    level_.assign(n, 0);
+    rank_.assign(n, null_key);
+    next_rank_ = 0;
+
+    for (vertex_iterator_t<G> u = begin(g_); u != end(g_); ++u) {
+      key_t const            ukey      = vertex_key(g_, u);
+      vertex_edge_range_t<G> edges_rng = edges(g_, u);
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_t const vkey = vertex_key(g_, uv, ukey);
+        if (vkey != ukey)
+          add_edge({ukey, vkey, null_key, distance_fnc_(*uv)});
+      }
+    }
+  }
+
+  //! Add edge ukey->vkey, or shorten it if it already exists.
+  void add_edge(shortcut const& sc) {
+    auto uv = ranges::find(out_[sc.ukey], sc.vkey, &ch_edge::key);
+    if (uv == out_[sc.ukey].end()) {
+      out_[sc.ukey].push_back({sc.vkey, sc.middle, sc.distance});
+      in_[sc.vkey].push_back({sc.ukey, sc.middle, sc.distance});
+    } else if (sc.distance < uv->distance) {
+      auto vu = ranges::find(in_[sc.vkey], sc.ukey, &ch_edge::key);
+      *uv     = {sc.vkey, sc.middle, sc.distance};
+      *vu     = {sc.ukey, sc.middle, sc.distance};
+    }
+  }
+
+  static void remove_edge(edge_list& edges_list, key_t const vkey) {
+    auto uv = ranges::find(edges_list, vkey, &ch_edge::key);
+    *uv     = edges_list.back();
+    edges_list.pop_back();
+  }
+
+  //! Find the shortcuts needed to contract vkey, appending them to shortcuts if it isn't null.
+  //! @return The priority of vkey, lower values are contracted first.
+  ptrdiff_t simulate(witness_search& ws, key_t const vkey, shortcut_list* shortcuts) {
+    ptrdiff_t added = 0;
+    for (ch_edge const& uv : in_[vkey]) {
+      DistanceT max_vw  = 0;
+      size_t    targets = 0;
+      for (ch_edge const& vw : out_[vkey]) {
+        if (vw.key != uv.key) {
+          max_vw            = max(max_vw, vw.distance);
+          ws.target[vw.key] = true;
+          ++targets;
+        }
+      }
+      if (targets == 0)
+        continue; // no out-edges to anything but u
+
+      find_witnesses(ws, uv.key, vkey, uv.distance + max_vw, targets);
+      for (ch_edge const& vw : out_[vkey]) {
+        if (vw.key == uv.key)
+          continue;
+        DistanceT const uw_dist = uv.distance + vw.distance;
+        if (ws.dist[vw.key] > uw_dist) {
+          ++added;
+          if (shortcuts)
+            shortcuts->push_back({uv.key, vw.key, vkey, uw_dist});
+        }
+        ws.target[vw.key] = false;
+      }
+      ws.reset();
+    }
+    // the edge difference is weighted to favor vertices that keep the remaining graph sparse
+    ptrdiff_t const removed = static_cast<ptrdiff_t>(in_[vkey].size() + out_[vkey].size());
+    return 4 * (added - removed) + static_cast<ptrdiff_t>(deleted_neighbors_[vkey] + level_[vkey]);
+  }
+
+  //! Dijkstra from ukey, ignoring vkey and vertices being contracted, until all targets are settled,
+  //! max_dist is exceeded or witness_limit vertices are settled.
+  void find_witnesses(
+        witness_search& ws, key_t const ukey, key_t const vkey, DistanceT const max_dist, size_t targets) {
+    using heap_entry = typename witness_search::heap_entry;
+    auto reach       = [&ws](key_t const wkey, DistanceT const w_dist) {
+      if (ws.dist[wkey] == null_distance)
+        ws.touched.push_back(wkey);
+      ws.dist[wkey] = w_dist;
+      ws.heap.push_back({w_dist, wkey});
+      push_heap(ws.heap.begin(), ws.heap.end(), greater<heap_entry>());
+    };
+
+    reach(ukey, 0);
+    for (size_t settled = 0; !ws.heap.empty() && settled < witness_limit_;) {
+      pop_heap(ws.heap.begin(), ws.heap.end(), greater<heap_entry>());
+      auto [x_dist, xkey] = ws.heap.back();
+      ws.heap.pop_back();
+      if (x_dist != ws.dist[xkey])
+        continue; // stale entry
+      if (x_dist > max_dist || (ws.target[xkey] && --targets == 0))
+        break;
+      ++settled;
+      for (ch_edge const& xy : out_[xkey]) {
+        if (xy.key == vkey || state_[xy.key] != active)
+          continue;
+        DistanceT const y_dist = x_dist + xy.distance;
+        if (y_dist < ws.dist[xy.key])
+          reach(xy.key, y_dist);
+      }
+    }
+  }
+
+  //! A vertex is locally minimal when its {priority, key} is less than all of its neighbors.
+  bool locally_minimal(key_t const ukey) const {
+    auto lower = [this, ukey](ch_edge const& uv) {
+      return pair(priority_[ukey], ukey) < pair(priority_[uv.key], uv.key);
+    };
+    return ranges::all_of(out_[ukey], lower) && ranges::all_of(in_[ukey], lower);
+  }
+
+  //! Move the edges of ukey to the hierarchy, remove them from its neighbors and add the shortcuts.
+  //! The neighbors of ukey are appended to neighbors.
+  void contract(key_t const ukey, shortcut_list const& shortcuts, vector<key_t>& neighbors) {
+    rank_[ukey]  = next_rank_++;
+    state_[ukey] = contracted;
+    for (ch_edge const& uv : out_[ukey]) {
+      remove_edge(in_[uv.key], ukey);
+      ++deleted_neighbors_[uv.key];
+      level_[uv.key] = max(level_[uv.key], level_[ukey] + 1);
+      neighbors.push_back(uv.key);
+    }
+    for (ch_edge const& vu : in_[ukey]) {
+      remove_edge(out_[vu.key], ukey);
+      ++deleted_neighbors_[vu.key];
+      level_[vu.key] = max(level_[vu.key], level_[ukey] + 1);
+      neighbors.push_back(vu.key);
+    }
+    up_[ukey].swap(out_[ukey]);
+    down_[ukey].swap(in_[ukey]);
+    edge_list().swap(out_[ukey]);
+    edge_list().swap(in_[ukey]);
+
+    for (shortcut const& sc : shortcuts)
+      add_edge(sc);
+  }
+
+  //! Copy the edges into the CSR arrays of the hierarchy.
+  hierarchy_t finish() {
+    hierarchy_t ch(alloc_);
+    ch.rank_.assign(rank_.begin(), rank_.end());
+
+    auto to_csr = [this, &ch](vector<edge_list>& lists, auto& offsets, auto& csr_edges) {
+      offsets.resize(size() + 1);
+      offsets[0] = 0;
+      for (key_t ukey = 0; ukey < static_cast<key_t>(size()); ++ukey)
+        offsets[ukey + 1] = offsets[ukey] + lists[ukey].size();
+      csr_edges.reserve(offsets.back());
+      for (edge_list& uv_list : lists) {
+        for (ch_edge const& uv : uv_list)
+          ch.shortcuts_ += (uv.middle != null_key);
+        csr_edges.insert(csr_edges.end(), uv_list.begin(), uv_list.end());
+        edge_list().swap(uv_list);
+      }
+    };
+    to_csr(up_, ch.up_offsets_, ch.up_edges_);
+    to_csr(down_, ch.down_offsets_, ch.down_edges_);
+    return ch;
+  }
+
+private:
+  graph_t&       g_;
+  distance_fnc_t distance_fnc_;
+  size_t         witness_limit_;
+  allocator_t    alloc_;
+
+  vector<edge_list>    out_, in_;  // edges between vertices that haven't been contracted
+  vector<edge_list>    up_, down_; // edges of contracted vertices to vertices contracted after them
+  vector<vertex_state> state_;
+  vector<ptrdiff_t>    priority_;
+  vector<size_t>       deleted_neighbors_;
+  vector<size_t>       level_; // 1 + the highest level of the contracted neighbors
+  vector<key_t>        rank_;
+  key_t                next_rank_ = 0;
+};
+
+
+//! Build a contraction hierarchy for shortest distance & path queries between pairs of vertices.
+//!
+//! @param g           The graph
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1. Weights must
+//!                    be non-negative.
+//! @param witness_limit
+//!                    The maximum number of vertices settled by a witness search. Larger values
+//!                    avoid unnecessary shortcuts at the cost of preprocessing time.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The hierarchy, used with a contraction_hierarchy_query.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        DistFnc,
+          typename        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+auto build_contraction_hierarchy(
+      G&           g,
+      DistFnc      distance_fnc  = [](edge_value_t<G>&) -> size_t { return 1; },
+      size_t const witness_limit = 500,
+      A            alloc         = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  contraction_hierarchy_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, witness_limit, alloc);
+  return fn.build();
+}
+
+
+//! Build a contraction hierarchy for shortest distance & path queries between pairs of vertices,
+//! contracting independent sets of vertices in parallel.
+//!
+//! @param policy      The execution policy used for the witness searches & priority updates.
+//! @param g           The graph
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1. Weights must
+//!                    be non-negative.
+//! @param witness_limit
+//!                    The maximum number of vertices settled by a witness search. Larger values
+//!                    avoid unnecessary shortcuts at the cost of preprocessing time.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The hierarchy, used with a contraction_hierarchy_query.
+//
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G,
+          typename        DistFnc,
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+auto build_contraction_hierarchy(
+      ExecutionPolicy&& policy,
+      G&                g,
+      DistFnc           distance_fnc  = [](edge_value_t<G>&) -> size_t { return 1; },
+      size_t const      witness_limit = 500,
+      A                 alloc         = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  contraction_hierarchy_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, witness_limit, alloc);
+  return fn.build(policy);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_CONTRACTION_HIERARCHIES_HPP
@@ -0,0 +1,372 @@
+//
+// Many-to-many shortest distances between a set of sources and a set of targets, written to a
+// dense, row-major |S| x |T| matrix where the distance from sources[i] to targets[j] is at
+// result[i * |T| + j]. Unreachable targets have a distance of numeric_limits<DistanceT>::max().
+//
+// On a graph, a Dijkstra search is run from each source using a dijkstra_workspace that's reused
+// between searches, resetting only the vertices reached by the previous one. Each search stops as
+// soon as all of the targets have been settled instead of exploring the whole graph. The
+// ExecutionPolicy overload runs the searches for the sources in parallel, using one workspace per
+// concurrent task.
+//
+// On a contraction_hierarchy, the bucket-based algorithm is used. A backward upward search is run
+// from each target, adding {target index, distance} to a bucket on each vertex it settles. Then a
+// forward upward search is run from each source, and the buckets on the vertices it settles are
+// scanned to update the source's row. The upward search spaces are small, so the cost is close
+// to |S| + |T| searches plus the bucket scans, rather than |S| x |T| queries. The ExecutionPolicy
+// overload runs the backward searches in parallel and then the forward searches in parallel; each
+// forward search writes to its own row so no synchronization is needed.
+//
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "shortest_paths.hpp"
+#include "contraction_hierarchies.hpp"
+
+#ifndef GRAPH_DISTANCE_TABLE_HPP
+#  define GRAPH_DISTANCE_TABLE_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of the many-to-many distance table on a graph.
+//!
+template <incidence_graph G, typename DistFnc, typename DistanceT, typename A = allocator<char>>
+class distance_table_fn {
+public:
+  using graph_t        = G;
+  using distance_fnc_t = DistFnc;
+  using allocator_t    = A;
+  using key_t          = vertex_key_t<G>;
+  using workspace_t    = dijkstra_workspace<key_t, DistanceT, A>;
+
+  distance_table_fn(graph_t& g, DistFnc distance_fnc, allocator_t alloc)
+        : g_(g), distance_fnc_(distance_fnc), alloc_(alloc) {}
+
+  template <typename SourceRng, typename TargetRng, typename OutIter>
+  void shortest_distances(SourceRng const& sources, TargetRng const& targets, OutIter result) {
+    mark_targets(targets);
+    workspace_t ws(ranges::size(g_), alloc_);
+    for (size_t i = 0; i < ranges::size(sources); ++i)
+      find_row(ws, sources, targets, i, result);
+  }
+
+  template <typename ExecutionPolicy, typename SourceRng, typename TargetRng, typename OutIter>
+  void shortest_distances(ExecutionPolicy&& policy, SourceRng const& sources, TargetRng const& targets, OutIter result) {
+    mark_targets(targets);
+    auto make_ws = [this]() { return workspace_t(ranges::size(g_), alloc_); };
+    detail::workspace_pool<workspace_t, decltype(make_ws)> pool(make_ws);
+    detail::for_each_index(policy, size_t(0), static_cast<size_t>(ranges::size(sources)), [&](size_t const i) {
+      auto ws = pool.acquire();
+      find_row(*ws, sources, targets, i, result);
+    });
+  }
+
+protected:
+  template <typename TargetRng>
+  void mark_targets(TargetRng const& targets) {
+    is_target_.assign(ranges::size(g_), false);
+    target_cnt_ = 0;
+    for (key_t tkey : targets)
+      if (!exchange(is_target_[tkey], true))
+        ++target_cnt_;
+  }
+
+  //! Search from sources[i] until all targets are settled and write row i of the result.
+  template <typename SourceRng, typename TargetRng, typename OutIter>
+  void find_row(workspace_t& ws, SourceRng const& sources, TargetRng const& targets, size_t const i, OutIter result) {
+    if (target_cnt_ == 0)
+      return;
+    size_t remaining = target_cnt_;
+    ws.search(g_, static_cast<key_t>(ranges::begin(sources)[i]), distance_fnc_,
+              [this, &remaining](key_t ukey, DistanceT) { return !is_target_[ukey] || --remaining > 0; });
+
+    size_t const nt  = static_cast<size_t>(ranges::size(targets));
+    OutIter      row = result + static_cast<iter_difference_t<OutIter>>(i * nt);
+    for (size_t j = 0; j < nt; ++j)
+      row[static_cast<iter_difference_t<OutIter>>(j)] = ws.distance(static_cast<key_t>(ranges::begin(targets)[j]));
+  }
+
+private:
+  graph_t&       g_;
+  distance_fnc_t distance_fnc_;
+  allocator_t    alloc_;
+  vector<char>   is_target_;
+  size_t         target_cnt_ = 0;
+};
+
+
+//! Internal implementation of the many-to-many distance table on a contraction hierarchy.
+//!
+template <integral KeyT, typename DistanceT, typename A = allocator<char>>
+class ch_distance_table_fn {
+public:
+  using hierarchy_t = contraction_hierarchy<KeyT, DistanceT, A>;
+  using query_t     = contraction_hierarchy_query<KeyT, DistanceT, A>;
+  using allocator_t = A;
+
+  static constexpr DistanceT null_distance = numeric_limits<DistanceT>::max();
+
+  ch_distance_table_fn(hierarchy_t const& ch, allocator_t alloc) : ch_(ch), alloc_(alloc) {}
+
+  template <typename SourceRng, typename TargetRng, typename OutIter>
+  void shortest_distances(SourceRng const& sources, TargetRng const& targets, OutIter result) {
+    size_t const        nt = static_cast<size_t>(ranges::size(targets));
+    query_t             query(ch_, alloc_);
+    vector<bucket_list> target_buckets(nt);
+    for (size_t j = 0; j < nt; ++j)
+      backward(query, targets, j, target_buckets[j]);
+    fill_buckets(target_buckets);
+
+    for (size_t i = 0; i < ranges::size(sources); ++i)
+      forward(query, sources, i, nt, result);
+  }
+
+  template <typename ExecutionPolicy, typename SourceRng, typename TargetRng, typename OutIter>
+  void shortest_distances(ExecutionPolicy&& policy, SourceRng const& sources, TargetRng const& targets, OutIter result) {
+    size_t const nt      = static_cast<size_t>(ranges::size(targets));
+    auto         make_qy = [this]() { return query_t(ch_, alloc_); };
+    detail::workspace_pool<query_t, decltype(make_qy)> pool(make_qy);
+
+    vector<bucket_list> target_buckets(nt);
+    detail::for_each_index(policy, size_t(0), nt, [&](size_t const j) {
+      auto query = pool.acquire();
+      backward(*query, targets, j, target_buckets[j]);
+    });
+    fill_buckets(target_buckets);
+
+    detail::for_each_index(policy, size_t(0), static_cast<size_t>(ranges::size(sources)), [&](size_t const i) {
+      auto query = pool.acquire();
+      forward(*query, sources, i, nt, result);
+    });
+  }
+
+protected:
+  struct bucket_entry {
+    KeyT      key;    // vertex settled by the backward search
+    size_t    target; // index of the target in targets
+    DistanceT distance;
+  };
+  using bucket_list = vector<bucket_entry>;
+
+  //! The backward search from targets[j], recording the vertices settled.
+  template <typename TargetRng>
+  void backward(query_t& query, TargetRng const& targets, size_t const j, bucket_list& settled) {
+    query.backward_search(static_cast<KeyT>(ranges::begin(targets)[j]),
+                          [&settled, j](KeyT ukey, DistanceT u_dist) { settled.push_back({ukey, j, u_dist}); });
+  }
+
+  //! Move the vertices settled by the backward searches into CSR buckets, ordered by vertex.
+  void fill_buckets(vector<bucket_list>& target_buckets) {
+    offsets_.assign(ch_.size() + 1, 0);
+    for (bucket_list const& settled : target_buckets)
+      for (bucket_entry const& entry : settled)
+        ++offsets_[entry.key + 1];
+    for (size_t ukey = 0; ukey < ch_.size(); ++ukey)
+      offsets_[ukey + 1] += offsets_[ukey];
+
+    buckets_.resize(offsets_.back());
+    vector<size_t> pos(offsets_.begin(), offsets_.end() - 1);
+    for (bucket_list& settled : target_buckets) {
+      for (bucket_entry const& entry : settled)
+        buckets_[pos[entry.key]++] = entry;
+      bucket_list().swap(settled);
+    }
+  }
+
+  //! The forward search from sources[i], scanning the buckets of the vertices settled to find row i.
+  template <typename SourceRng, typename OutIter>
+  void forward(query_t& query, SourceRng const& sources, size_t const i, size_t const nt, OutIter result) {
+    OutIter row = result + static_cast<iter_difference_t<OutIter>>(i * nt);
+    for (size_t j = 0; j < nt; ++j)
+      row[static_cast<iter_difference_t<OutIter>>(j)] = null_distance;
+
+    query.forward_search(static_cast<KeyT>(ranges::begin(sources)[i]), [this, row](KeyT ukey, DistanceT u_dist) {
+      for (size_t b = offsets_[ukey]; b < offsets_[ukey + 1]; ++b) {
+        bucket_entry const& entry = buckets_[b];
+        auto&&              dist  = row[static_cast<iter_difference_t<OutIter>>(entry.target)];
+        if (u_dist + entry.distance < dist)
+          dist = u_dist + entry.distance;
+      }
+    });
+  }
+
+private:
+  hierarchy_t const&   ch_;
+  allocator_t          alloc_;
+  vector<size_t>       offsets_; // buckets_[offsets_[ukey]..offsets_[ukey+1]) are the entries for ukey
+  vector<bucket_entry> buckets_;
+};
+
+
+//! Find the shortest distances from each source to each target using a Dijkstra search from
+//! each source that stops when all targets are settled.
+//!
+//! @param g           The graph
+//! @param sources     The keys of the source vertices.
+//! @param targets     The keys of the target vertices.
+//! @param result      The beginning of a row-major |sources| x |targets| matrix that the
+//!                    distances are written to. result[i * size(targets) + j] is the distance
+//!                    from sources[i] to targets[j], or numeric_limits<DistanceT>::max() if
+//!                    targets[j] isn't reachable.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1. Weights must
+//!                    be non-negative.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <incidence_graph                 G,
+          ranges::random_access_range     SourceRng,
+          ranges::random_access_range     TargetRng,
+          random_access_iterator          OutIter,
+          typename                        DistFnc,
+          typename                        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           convertible_to<ranges::range_value_t<SourceRng>, vertex_key_t<G>> &&
+           convertible_to<ranges::range_value_t<TargetRng>, vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void shortest_distance_table(
+      G&               g,
+      SourceRng const& sources,
+      TargetRng const& targets,
+      OutIter          result,
+      DistFnc          distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  distance_table_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  fn.shortest_distances(sources, targets, result);
+}
+
+
+//! Find the shortest distances from each source to each target using a Dijkstra search from
+//! each source that stops when all targets are settled, with the sources searched in parallel.
+//!
+//! @param policy      The execution policy used to search from the sources.
+//! @param g           The graph
+//! @param sources     The keys of the source vertices.
+//! @param targets     The keys of the target vertices.
+//! @param result      The beginning of a row-major |sources| x |targets| matrix that the
+//!                    distances are written to. result[i * size(targets) + j] is the distance
+//!                    from sources[i] to targets[j], or numeric_limits<DistanceT>::max() if
+//!                    targets[j] isn't reachable.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1. Weights must
+//!                    be non-negative.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <typename                        ExecutionPolicy,
+          incidence_graph                 G,
+          ranges::random_access_range     SourceRng,
+          ranges::random_access_range     TargetRng,
+          random_access_iterator          OutIter,
+          typename                        DistFnc,
+          typename                        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           convertible_to<ranges::range_value_t<SourceRng>, vertex_key_t<G>> &&
+           convertible_to<ranges::range_value_t<TargetRng>, vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void shortest_distance_table(
+      ExecutionPolicy&& policy,
+      G&                g,
+      SourceRng const&  sources,
+      TargetRng const&  targets,
+      OutIter           result,
+      DistFnc           distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                 alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  distance_table_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  fn.shortest_distances(policy, sources, targets, result);
+}
+
+
+//! Find the shortest distances from each source to each target on a contraction hierarchy using
+//! the bucket-based many-to-many algorithm.
+//!
+//! @param ch          The contraction hierarchy created by build_contraction_hierarchy.
+//! @param sources     The keys of the source vertices.
+//! @param targets     The keys of the target vertices.
+//! @param result      The beginning of a row-major |sources| x |targets| matrix that the
+//!                    distances are written to. result[i * size(targets) + j] is the distance
+//!                    from sources[i] to targets[j], or numeric_limits<DistanceT>::max() if
+//!                    targets[j] isn't reachable.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <integral                    KeyT,
+          typename                    DistanceT,
+          typename                    A,
+          ranges::random_access_range SourceRng,
+          ranges::random_access_range TargetRng,
+          random_access_iterator      OutIter>
+  requires convertible_to<ranges::range_value_t<SourceRng>, KeyT> &&
+           convertible_to<ranges::range_value_t<TargetRng>, KeyT>
+void shortest_distance_table(
+      contraction_hierarchy<KeyT, DistanceT, A> const& ch,
+      SourceRng const&                                 sources,
+      TargetRng const&                                 targets,
+      OutIter                                          result,
+      A                                                alloc = A())
+// clang-format on
+{
+  ch_distance_table_fn<KeyT, DistanceT, A> fn(ch, alloc);
+  fn.shortest_distances(sources, targets, result);
+}
+
+
+//! Find the shortest distances from each source to each target on a contraction hierarchy using
+//! the bucket-based many-to-many algorithm, with the searches run in parallel.
+//!
+//! @param policy      The execution policy used for the backward & forward searches.
+//! @param ch          The contraction hierarchy created by build_contraction_hierarchy.
+//! @param sources     The keys of the source vertices.
+//! @param targets     The keys of the target vertices.
+//! @param result      The beginning of a row-major |sources| x |targets| matrix that the
+//!                    distances are written to. result[i * size(targets) + j] is the distance
+//!                    from sources[i] to targets[j], or numeric_limits<DistanceT>::max() if
+//!                    targets[j] isn't reachable.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <typename                    ExecutionPolicy,
+          integral                    KeyT,
+          typename                    DistanceT,
+          typename                    A,
+          ranges::random_access_range SourceRng,
+          ranges::random_access_range TargetRng,
+          random_access_iterator      OutIter>
+  requires execution_policy<ExecutionPolicy> &&
+           convertible_to<ranges::range_value_t<SourceRng>, KeyT> &&
+           convertible_to<ranges::range_value_t<TargetRng>, KeyT>
+void shortest_distance_table(
+      ExecutionPolicy&&                                policy,
+      contraction_hierarchy<KeyT, DistanceT, A> const& ch,
+      SourceRng const&                                 sources,
+      TargetRng const&                                 targets,
+      OutIter                                          result,
+      A                                                alloc = A())
+// clang-format on
+{
+  ch_distance_table_fn<KeyT, DistanceT, A> fn(ch, alloc);
+  fn.shortest_distances(policy, sources, targets, result);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_DISTANCE_TABLE_HPP
@@ -0,0 +1,307 @@
+//
+// Incremental connected components for graphs where edges are added over time.
+//
+// disjoint_set is a union-find structure using union by size and path compression, so finding
+// the component of a vertex, checking if two vertices are in the same component and getting the
+// size of a component are near-constant time. It can be seeded from the edges of a graph with
+// make_disjoint_set and then fed new edges one at a time, or in batches, as they arrive.
+//
+// concurrent_disjoint_set allows unions and finds from multiple threads at once without locks.
+// The parent of a root is changed with a compare-and-swap that only succeeds if it's still a
+// root, with the larger root always linked under the smaller so concurrent unions can't form a
+// cycle. Finds use path splitting, where each vertex on the path is pointed to its grandparent
+// with a compare-and-swap. The size of a component is moved to the new root after each union;
+// sizes are exact once all unions in progress have finished.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+
+#ifndef GRAPH_INCREMENTAL_COMPONENTS_HPP
+#  define GRAPH_INCREMENTAL_COMPONENTS_HPP
+
+namespace std::graph {
+
+//! A union-find structure for maintaining connected components of vertices 0..size()-1 as edges
+//! are added.
+//!
+template <integral KeyT = uint32_t, typename A = allocator<KeyT>>
+class disjoint_set {
+public:
+  using key_type       = KeyT;
+  using allocator_type = A;
+  using key_vector     = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+
+  disjoint_set(size_t const n = 0, allocator_type alloc = allocator_type()) : parent_(alloc), size_(alloc) {
+    resize(n);
+  }
+
+  //! The number of vertices.
+  size_t size() const noexcept { return parent_.size(); }
+  //! The number of components.
+  size_t components() const noexcept { return components_; }
+
+  //! Add vertices, each in its own component, so there are n vertices. Vertices are never removed.
+  void resize(size_t const n) {
+    if (n <= parent_.size())
+      return;
+    size_t const first = parent_.size();
+    parent_.resize(n);
+    iota(parent_.begin() + static_cast<ptrdiff_t>(first), parent_.end(), static_cast<key_type>(first));
+    size_.resize(n, key_type(1));
+    components_ += n - first;
+  }
+
+  //! The root of the component that ukey is in. The path to the root is compressed.
+  key_type find(key_type ukey) {
+    key_type root = ukey;
+    while (parent_[root] != root)
+      root = parent_[root];
+    while (parent_[ukey] != root) {
+      key_type const next = parent_[ukey];
+      parent_[ukey]       = root;
+      ukey                = next;
+    }
+    return root;
+  }
+
+  //! Join the components of ukey and vkey, for the edge between them.
+  //! @return true if they were in different components.
+  bool unite(key_type const ukey, key_type const vkey) {
+    key_type u_root = find(ukey);
+    key_type v_root = find(vkey);
+    if (u_root == v_root)
+      return false;
+    if (size_[u_root] < size_[v_root])
+      swap(u_root, v_root);
+    parent_[v_root] = u_root; // the smaller component goes under the larger
+    size_[u_root] += size_[v_root];
+    --components_;
+    return true;
+  }
+
+  //! Join the components of the vertices for each edge in the range.
+  //!
+  //! @param rng      The edges.
+  //! @param ekey_fnc Returns the vertex keys of an edge in the range as a pair or tuple.
+  //! @return         The number of unions that joined different components.
+  template <ranges::input_range ERng, typename EKeyFnc = identity>
+  size_t unite(ERng&& rng, EKeyFnc ekey_fnc = EKeyFnc()) {
+    size_t joined = 0;
+    for (auto&& e : rng) {
+      auto&& [ukey, vkey] = ekey_fnc(e);
+      joined += unite(static_cast<key_type>(ukey), static_cast<key_type>(vkey));
+    }
+    return joined;
+  }
+
+  bool same_component(key_type const ukey, key_type const vkey) { return find(ukey) == find(vkey); }
+
+  //! The number of vertices in the component that ukey is in.
+  size_t component_size(key_type const ukey) { return size_[find(ukey)]; }
+
+private:
+  key_vector parent_;
+  key_vector size_; // only valid for roots
+  size_t     components_ = 0;
+};
+
+
+//! A union-find structure that allows lock-free unions and finds from multiple threads.
+//!
+//! resize() isn't thread-safe. component_size() and components() are exact when no unions are in
+//! progress.
+//!
+template <integral KeyT = uint32_t, typename A = allocator<KeyT>>
+class concurrent_disjoint_set {
+public:
+  using key_type       = KeyT;
+  using allocator_type = A;
+  using key_vector     = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+
+  concurrent_disjoint_set(size_t const n = 0, allocator_type alloc = allocator_type()) : parent_(alloc), size_(alloc) {
+    resize(n);
+  }
+
+  size_t size() const noexcept { return parent_.size(); }
+  size_t components() const noexcept { return atomic_ref<size_t>(const_cast<size_t&>(components_)).load(); }
+
+  //! Add vertices, each in its own component, so there are n vertices. Vertices are never removed.
+  //! This must not be called while other threads are using the structure.
+  void resize(size_t const n) {
+    if (n <= parent_.size())
+      return;
+    size_t const first = parent_.size();
+    parent_.resize(n);
+    iota(parent_.begin() + static_cast<ptrdiff_t>(first), parent_.end(), static_cast<key_type>(first));
+    size_.resize(n, key_type(1));
+    components_ += n - first;
+  }
+
+  //! The root of the component that ukey is in, at the time the root is reached. Each vertex on
+  //! the path is pointed to its grandparent.
+  key_type find(key_type ukey) noexcept {
+    key_type parent = load(parent_[ukey]);
+    while (parent != ukey) {
+      key_type const grandparent = load(parent_[parent]);
+      if (grandparent != parent)
+        detail::atomic_compare_exchange(parent_[ukey], parent, grandparent);
+      ukey   = parent;
+      parent = grandparent;
+    }
+    return ukey;
+  }
+
+  //! Join the components of ukey and vkey, for the edge between them.
+  //! @return true if they were in different components.
+  bool unite(key_type const ukey, key_type const vkey) noexcept {
+    for (;;) {
+      key_type low  = find(ukey);
+      key_type high = find(vkey);
+      if (low == high)
+        return false;
+      if (high < low)
+        swap(low, high);
+      if (atomic_ref<key_type>(parent_[high]).compare_exchange_strong(high, low)) {
+        move_size(high);
+        atomic_ref<size_t>(components_).fetch_sub(1);
+        return true;
+      }
+      // high was linked by another thread; try again with the new roots
+    }
+  }
+
+  //! Join the components of the vertices for each edge in the range.
+  //!
+  //! @param rng      The edges.
+  //! @param ekey_fnc Returns the vertex keys of an edge in the range as a pair or tuple.
+  //! @return         The number of unions that joined different components.
+  template <ranges::input_range ERng, typename EKeyFnc = identity>
+  size_t unite(ERng&& rng, EKeyFnc ekey_fnc = EKeyFnc()) {
+    size_t joined = 0;
+    for (auto&& e : rng) {
+      auto&& [ukey, vkey] = ekey_fnc(e);
+      joined += unite(static_cast<key_type>(ukey), static_cast<key_type>(vkey));
+    }
+    return joined;
+  }
+
+  //! Join the components of the vertices for each edge in the range, in parallel.
+  // clang-format off
+  template <typename ExecutionPolicy, ranges::random_access_range ERng, typename EKeyFnc = identity>
+    requires execution_policy<ExecutionPolicy>
+  size_t unite(ExecutionPolicy&& policy, ERng&& rng, EKeyFnc ekey_fnc = EKeyFnc())
+  // clang-format on
+  {
+    size_t joined = 0;
+    std::for_each(policy, ranges::begin(rng), ranges::end(rng), [this, &ekey_fnc, &joined](auto&& e) {
+      auto&& [ukey, vkey] = ekey_fnc(e);
+      if (unite(static_cast<key_type>(ukey), static_cast<key_type>(vkey)))
+        atomic_ref<size_t>(joined).fetch_add(1, memory_order_relaxed);
+    });
+    return joined;
+  }
+
+  //! True if ukey and vkey are in the same component. A concurrent union may join them after
+  //! false is returned.
+  bool same_component(key_type const ukey, key_type const vkey) noexcept {
+    for (;;) {
+      key_type const u_root = find(ukey);
+      key_type const v_root = find(vkey);
+      if (u_root == v_root)
+        return true;
+      if (load(parent_[u_root]) == u_root)
+        return false; // u_root was still a root after v_root was found
+    }
+  }
+
+  //! The number of vertices in the component that ukey is in.
+  size_t component_size(key_type const ukey) noexcept { return atomic_ref<key_type>(size_[find(ukey)]).load(); }
+
+protected:
+  static key_type load(key_type& target) noexcept { return atomic_ref<key_type>(target).load(); }
+
+  //! Move the size of ukey, which is no longer a root, to its parent. This repeats while the
+  //! parent isn't a root, because another thread may have linked it before the size was added.
+  //! A thread that links a root moves its size afterwards, and a thread that adds to a size checks
+  //! if it's still a root afterwards, so at least one of them moves it and nothing is lost.
+  void move_size(key_type ukey) noexcept {
+    for (;;) {
+      key_type const parent = load(parent_[ukey]);
+      if (parent == ukey)
+        return;
+      key_type const sz = atomic_ref<key_type>(size_[ukey]).exchange(0);
+      if (sz == 0)
+        return; // moved by another thread
+      atomic_ref<key_type>(size_[parent]).fetch_add(sz);
+      ukey = parent;
+    }
+  }
+
+private:
+  key_vector parent_;
+  key_vector size_; // only valid for roots when no unions are in progress
+  size_t     components_ = 0;
+};
+
+#  ifdef CPO
+
+//! Create a disjoint_set with the components of a graph, which can then be updated as edges are
+//! added.
+//!
+//! @param g     The graph. Each edge joins the components of its vertices, whether the graph is
+//!              directed or not.
+//! @param alloc The allocator to use for the disjoint_set.
+//
+// clang-format off
+template <incidence_graph G, typename A = allocator<vertex_key_t<G>>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+disjoint_set<vertex_key_t<G>, A> make_disjoint_set(G& g, A alloc = A())
+// clang-format on
+{
+  disjoint_set<vertex_key_t<G>, A> ds(ranges::size(g), alloc);
+  for (vertex_iterator_t<G> u = begin(g); u != end(g); ++u) {
+    vertex_key_t<G> const  ukey      = vertex_key(g, u);
+    vertex_edge_range_t<G> edges_rng = edges(g, u);
+    for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv)
+      ds.unite(ukey, vertex_key(g, uv, ukey));
+  }
+  return ds;
+}
+
+//! Create a concurrent_disjoint_set with the components of a graph, using multiple threads,
+//! which can then be updated as edges are added by multiple threads.
+//!
+//! @param policy The execution policy used to visit the vertices.
+//! @param g      The graph. Each edge joins the components of its vertices, whether the graph is
+//!               directed or not.
+//! @param alloc  The allocator to use for the concurrent_disjoint_set.
+//
+// clang-format off
+template <typename ExecutionPolicy, incidence_graph G, typename A = allocator<vertex_key_t<G>>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+concurrent_disjoint_set<vertex_key_t<G>, A> make_concurrent_disjoint_set(ExecutionPolicy&& policy, G& g, A alloc = A())
+// clang-format on
+{
+  using key_t = vertex_key_t<G>;
+  concurrent_disjoint_set<key_t, A> ds(ranges::size(g), alloc);
+  detail::for_each_index(policy, key_t(0), static_cast<key_t>(ranges::size(g)), [&g, &ds](key_t const ukey) {
+    vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+    for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv)
+      ds.unite(ukey, vertex_key(g, uv, ukey));
+  });
+  return ds;
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_INCREMENTAL_COMPONENTS_HPP
@@ -0,0 +1,280 @@
+//
+// k-core decomposition.
+//
+// The k-core of a graph is the largest induced subgraph where every vertex has at least k
+// neighbors, and the core number of a vertex is the largest k with the vertex in the k-core. Cores
+// are defined on the underlying undirected graph: the direction of edges is ignored, and
+// self-loops and parallel edges don't add to the degree.
+//
+// core_numbers uses the bucket algorithm of Batagelj & Zaversnik. The vertices are kept sorted by
+// their current degree in an array with the start of each degree's bucket, and are removed in
+// order of increasing degree. Removing a vertex moves each remaining neighbor with a higher degree
+// to the front of its bucket and then into the bucket below, so it's O(|V| + |E|).
+//
+// The ExecutionPolicy overload peels the graph in parallel, level by level (as in ParK and
+// Julienne). Level k starts with the remaining vertices of degree k, the lowest degree remaining.
+// Each round assigns the core number k to the vertices of the frontier and decrements the degree
+// of their neighbors concurrently, but never below k; the neighbors whose degree reaches k form
+// the next frontier. When the frontier is empty every vertex of degree k has been removed, and
+// the remaining vertices are compacted before the next level.
+//
+// k_core_view is a view of the k-core of a graph, given the core numbers: it filters the vertices
+// and edges of the graph without copying them.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "../detail/neighbor_lists.hpp"
+
+#ifndef GRAPH_K_CORE_HPP
+#  define GRAPH_K_CORE_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of the k-core decomposition.
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class k_core_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  k_core_fn(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+        : neighbors_(policy, g, alloc), degree_(neighbors_.size(), alloc), alloc_(alloc) {}
+
+  //! Assign the core number of each vertex to core_iter[ukey] with the bucket algorithm.
+  //! @return The largest core number.
+  template <random_access_iterator CoreIter>
+  key_type operator()(CoreIter core_iter) {
+    key_type const n = neighbors_.size();
+    for (key_type ukey = 0; ukey < n; ++ukey)
+      degree_[ukey] = neighbors_.degree(ukey);
+    key_type const max_degree = n ? *max_element(degree_.begin(), degree_.end()) : key_type(0);
+
+    // bin[d] is the start of the vertices of degree d in vert; pos is the position of each vertex
+    size_vector bin(static_cast<size_t>(max_degree) + 1, 0, alloc_);
+    for (key_type const d : degree_)
+      ++bin[d];
+    exclusive_scan(bin.begin(), bin.end(), bin.begin(), size_t(0));
+    size_vector pos(n, alloc_);
+    key_vector  vert(n, alloc_);
+    for (key_type ukey = 0; ukey < n; ++ukey) {
+      pos[ukey]       = bin[degree_[ukey]]++;
+      vert[pos[ukey]] = ukey;
+    }
+    shift_right(bin.begin(), bin.end(), 1);
+    bin[0] = 0;
+
+    key_type core = 0;
+    for (size_t i = 0; i < n; ++i) {
+      key_type const vkey = vert[i];
+      core                = degree_[vkey];
+      for (key_type const ukey : neighbors_[vkey]) {
+        key_type const du = degree_[ukey];
+        if (du > core) {
+          // swap ukey with the first vertex of its bucket, then move the bucket's start past it
+          size_t const   pw   = bin[du];
+          key_type const wkey = vert[pw];
+          if (ukey != wkey) {
+            swap(vert[pos[ukey]], vert[pw]);
+            swap(pos[ukey], pos[wkey]);
+          }
+          ++bin[du];
+          --degree_[ukey];
+        }
+      }
+      core_iter[static_cast<iter_difference_t<CoreIter>>(vkey)] = static_cast<iter_value_t<CoreIter>>(core);
+    }
+    return core;
+  }
+
+  //! Assign the core number of each vertex to core_iter[ukey] by peeling the graph in parallel.
+  //! @return The largest core number.
+  template <typename ExecutionPolicy, random_access_iterator CoreIter>
+  key_type operator()(ExecutionPolicy&& policy, CoreIter core_iter) {
+    key_type const n = neighbors_.size();
+    key_vector     remaining(n, alloc_);
+    key_vector     frontier(n, alloc_);
+    key_vector     next(n, alloc_);
+    iota(remaining.begin(), remaining.end(), key_type(0));
+    detail::for_each_index(policy, key_type(0), n,
+                           [this](key_type const ukey) { degree_[ukey] = neighbors_.degree(ukey); });
+
+    key_type core = 0;
+    while (!remaining.empty()) {
+      core = max(core, transform_reduce(
+                             policy, remaining.begin(), remaining.end(), numeric_limits<key_type>::max(),
+                             [](key_type const a, key_type const b) { return min(a, b); },
+                             [this](key_type const ukey) { return degree_[ukey]; }));
+
+      size_t frontier_size = 0;
+      detail::for_each_index(policy, size_t(0), remaining.size(), [&, core](size_t const i) {
+        if (degree_[remaining[i]] == core)
+          frontier[atomic_ref<size_t>(frontier_size).fetch_add(1, memory_order_relaxed)] = remaining[i];
+      });
+
+      while (frontier_size > 0) {
+        size_t next_size = 0;
+        detail::for_each_index(policy, size_t(0), frontier_size, [&, core](size_t const i) {
+          key_type const vkey = frontier[i];
+          core_iter[static_cast<iter_difference_t<CoreIter>>(vkey)] = static_cast<iter_value_t<CoreIter>>(core);
+          for (key_type const ukey : neighbors_[vkey])
+            if (decrement_above(degree_[ukey], core))
+              next[atomic_ref<size_t>(next_size).fetch_add(1, memory_order_relaxed)] = ukey;
+        });
+        swap(frontier, next);
+        frontier_size = next_size;
+      }
+
+      auto last = remove_if(policy, remaining.begin(), remaining.end(),
+                            [this, core](key_type const ukey) { return degree_[ukey] <= core; });
+      remaining.erase(last, remaining.end());
+    }
+    return core;
+  }
+
+protected:
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+
+  //! Atomically decrement degree if it's greater than core.
+  //! @return true if degree was decremented to core.
+  static bool decrement_above(key_type& degree, key_type const core) noexcept {
+    atomic_ref<key_type> ref(degree);
+    key_type             cur = ref.load(memory_order_relaxed);
+    while (cur > core)
+      if (ref.compare_exchange_weak(cur, cur - 1, memory_order_relaxed))
+        return cur - 1 == core;
+    return false;
+  }
+
+private:
+  detail::neighbor_lists<G, A> neighbors_;
+  key_vector                   degree_; // the degree among the vertices that haven't been removed
+  allocator_type               alloc_;
+};
+
+
+//! Find the core number of each vertex of a graph, ignoring the direction of edges.
+//!
+//! Complexity is O(|V| + |E|) after the distinct neighbors of each vertex are found.
+//!
+//! @param g         The graph
+//! @param core_iter The beginning of a random-access range of size(g) values, where
+//!                  core_iter[ukey] is assigned the core number of ukey.
+//! @param alloc     The allocator to use for internal containers.
+//! @return          The largest core number (the degeneracy of the graph).
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CoreIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CoreIter>>
+vertex_key_t<G> core_numbers(G& g, CoreIter core_iter, A alloc = A())
+// clang-format on
+{
+  k_core_fn<G, A> fn(execution::seq, g, alloc);
+  return fn(core_iter);
+}
+
+//! Find the core number of each vertex of a graph in parallel, ignoring the direction of edges.
+//!
+//! @param policy    The execution policy used.
+//! @param g         The graph
+//! @param core_iter The beginning of a random-access range of size(g) values, where
+//!                  core_iter[ukey] is assigned the core number of ukey.
+//! @param alloc     The allocator to use for internal containers.
+//! @return          The largest core number (the degeneracy of the graph).
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CoreIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CoreIter>>
+vertex_key_t<G> core_numbers(ExecutionPolicy&& policy, G& g, CoreIter core_iter, A alloc = A())
+// clang-format on
+{
+  k_core_fn<G, A> fn(policy, g, alloc);
+  return fn(policy, core_iter);
+}
+
+
+//! A view of the k-core of a graph: the vertices with a core number of at least k, and the edges
+//! between them. The graph and the core numbers are referenced, not copied, and must outlive the
+//! view.
+//!
+// clang-format off
+template <incidence_graph G, ranges::random_access_range CoreRange>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<ranges::range_value_t<CoreRange>>
+class k_core_view
+// clang-format on
+{
+public:
+  using graph_type = G;
+  using key_type   = vertex_key_t<G>;
+  using core_type  = ranges::range_value_t<CoreRange>;
+
+  k_core_view(graph_type& g, CoreRange const& cores, core_type const k) : graph_(&g), cores_(&cores), k_(k) {}
+
+  core_type k() const noexcept { return k_; }
+
+  //! True if ukey is in the k-core.
+  bool contains(key_type const ukey) const {
+    return ranges::begin(*cores_)[static_cast<ranges::range_difference_t<CoreRange>>(ukey)] >= k_;
+  }
+
+  //! The keys of the vertices in the k-core, in increasing order.
+  auto vertex_keys() const {
+    return views::iota(key_type(0), static_cast<key_type>(ranges::size(*graph_))) |
+           views::filter([this](key_type const ukey) { return contains(ukey); });
+  }
+
+  //! The iterators of the edges of ukey to vertices in the k-core.
+  auto vertex_edges(key_type const ukey) const {
+    vertex_edge_range_t<G> edges_rng = edges(*graph_, find_vertex(*graph_, ukey));
+    return views::iota(ranges::begin(edges_rng), ranges::end(edges_rng)) |
+           views::filter([this, ukey](vertex_edge_iterator_t<G> const uv) {
+             return contains(vertex_key(*graph_, uv, ukey));
+           });
+  }
+
+private:
+  graph_type*      graph_;
+  CoreRange const* cores_;
+  core_type        k_;
+};
+
+//! Make a view of the k-core of g from the core numbers found by core_numbers.
+template <incidence_graph G, ranges::random_access_range CoreRange>
+k_core_view<G, CoreRange> k_core(G& g, CoreRange const& cores, ranges::range_value_t<CoreRange> const k) {
+  return k_core_view<G, CoreRange>(g, cores, k);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_K_CORE_HPP
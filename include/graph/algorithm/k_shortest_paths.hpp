@@ -0,0 +1,220 @@
+//
+// The k shortest loopless paths between a source and target vertex, for alternative routes.
+//
+// Yen's algorithm finds each path after the first by taking every vertex on the previous path as
+// a spur vertex, and searching for the shortest path from the spur vertex to the target that
+// leaves the root path (source to spur vertex) on a different edge than any path already found
+// with the same root. The root vertices and the edges already taken are excluded from the search
+// with a predicate rather than by copying or modifying the graph. Lawler's refinement is used so
+// only the spur vertices at or after the point where a path deviated from its parent are searched.
+//
+// Each spur search is a Dijkstra search on a single dijkstra_workspace that is reused for the
+// whole query, and stops as soon as the target is settled. The cost of each search is
+// proportional to the part of the graph it explores.
+//
+// Paths are sequences of vertices; when there are parallel edges between two vertices only the
+// shortest is used. Weights must be non-negative.
+//
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <vector>
+#include "../graph.hpp"
+#include "shortest_paths.hpp"
+
+#ifndef GRAPH_K_SHORTEST_PATHS_HPP
+#  define GRAPH_K_SHORTEST_PATHS_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of Yen's k shortest loopless paths algorithm.
+//!
+template <incidence_graph G, typename DistFnc, typename DistanceT, typename A = allocator<char>>
+class yen_fn {
+public:
+  using graph_t        = G;
+  using distance_fnc_t = DistFnc;
+  using allocator_t    = A;
+  using key_t          = vertex_key_t<G>;
+  using workspace_t    = dijkstra_workspace<key_t, DistanceT, A>;
+
+  yen_fn(graph_t& g, DistFnc distance_fnc, allocator_t alloc)
+        : g_(g)
+        , distance_fnc_(distance_fnc)
+        , alloc_(alloc)
+        , ws_(ranges::size(g), alloc)
+        , banned_vertex_(ranges::size(g), false, alloc)
+        , banned_next_(alloc) {}
+
+  template <typename OutIter>
+  void shortest_paths(vertex_iterator_t<G> source, vertex_iterator_t<G> target, size_t const k, OutIter result_iter) {
+    using path_t = shortest_path<vertex_iterator_t<G>, DistanceT>;
+    path_t               spath(alloc_);
+    vertex_iterator_t<G> first = begin(vertices(g_));
+    find_paths(vertex_key(g_, source), vertex_key(g_, target), k, [&](key_vector const& keys, DistanceT const dist) {
+      spath.distance = dist;
+      for (key_t ukey : keys)
+        spath.path.push_back(first + ukey);
+      *result_iter = spath;
+      ++result_iter;
+      spath.path.clear();
+    });
+  }
+
+protected:
+  using key_vector  = vector<key_t, typename allocator_traits<A>::template rebind_alloc<key_t>>;
+  using dist_vector = vector<DistanceT, typename allocator_traits<A>::template rebind_alloc<DistanceT>>;
+  using bool_vector = vector<bool, typename allocator_traits<A>::template rebind_alloc<bool>>;
+
+  struct path_detail {
+    key_vector  keys;      // vertices from source to target
+    dist_vector distances; // distances[i] is the distance from the source to keys[i]
+    size_t      deviation; // index of the spur vertex where the path left its parent
+
+    DistanceT distance() const { return distances.back(); }
+  };
+  using path_vector = vector<path_detail, typename allocator_traits<A>::template rebind_alloc<path_detail>>;
+
+  //! Find up to k paths, calling path_fnc(keys, distance) for each in order of increasing
+  //! distance.
+  template <typename PathFnc>
+  void find_paths(key_t const source_key, key_t const target_key, size_t const k, PathFnc&& path_fnc) {
+    if (k == 0)
+      return;
+    path_vector found(alloc_);      // A: the paths output
+    path_vector candidates(alloc_); // B: min-heap of paths not output yet
+    auto        longer = [](path_detail const& lhs, path_detail const& rhs) { return lhs.distance() > rhs.distance(); };
+
+    if (!find_spur(source_key, target_key))
+      return;
+    found.push_back(make_path(nullptr, 0, source_key, target_key));
+    path_fnc(found.back().keys, found.back().distance());
+
+    while (found.size() < k) {
+      path_detail const& prev = found.back();
+      for (size_t i = 0; i < prev.deviation; ++i)
+        banned_vertex_[prev.keys[i]] = true;
+
+      for (size_t i = prev.deviation; i + 1 < prev.keys.size(); ++i) {
+        key_t const spur_key = prev.keys[i];
+
+        // leave the root on an edge that hasn't been taken by a path with the same root
+        banned_next_.clear();
+        for (path_detail const& p : found)
+          if (p.keys.size() > i + 1 && equal(p.keys.begin(), p.keys.begin() + i + 1, prev.keys.begin()))
+            banned_next_.push_back(p.keys[i + 1]);
+
+        if (find_spur(spur_key, target_key)) {
+          path_detail cand = make_path(&prev, i, spur_key, target_key);
+          if (none_of(candidates.begin(), candidates.end(), [&cand](path_detail const& p) { return p.keys == cand.keys; })) {
+            candidates.push_back(move(cand));
+            push_heap(candidates.begin(), candidates.end(), longer);
+          }
+        }
+        banned_vertex_[spur_key] = true; // part of the root for the next spur vertex
+      }
+      for (key_t ukey : prev.keys)
+        banned_vertex_[ukey] = false;
+
+      if (candidates.empty())
+        break;
+      pop_heap(candidates.begin(), candidates.end(), longer);
+      found.push_back(move(candidates.back())); // invalidates prev
+      candidates.pop_back();
+      path_fnc(found.back().keys, found.back().distance());
+    }
+  }
+
+  //! Search for the shortest path from spur_key to target_key that avoids the banned vertices and
+  //! the edges from spur_key to the banned next vertices.
+  //! @return true if target_key was reached.
+  bool find_spur(key_t const spur_key, key_t const target_key) {
+    ws_.search_if(
+          g_, spur_key, distance_fnc_, [target_key](key_t ukey, DistanceT) { return ukey != target_key; },
+          [this, spur_key](key_t ukey, key_t vkey, auto&&) {
+            return !banned_vertex_[vkey] &&
+                   (ukey != spur_key || find(banned_next_.begin(), banned_next_.end(), vkey) == banned_next_.end());
+          });
+    return ws_.distance(target_key) != workspace_t::null_distance;
+  }
+
+  //! Join the root of prev, up to but not including spur index i, with the spur path found by the
+  //! last search.
+  path_detail make_path(path_detail const* prev, size_t const i, key_t const spur_key, key_t const target_key) {
+    path_detail     path{key_vector(alloc_), dist_vector(alloc_), i};
+    DistanceT const root_dist = prev ? prev->distances[i] : DistanceT(0);
+    if (prev) {
+      path.keys.assign(prev->keys.begin(), prev->keys.begin() + i);
+      path.distances.assign(prev->distances.begin(), prev->distances.begin() + i);
+    }
+    for (key_t ukey = target_key;; ukey = ws_.predecessor(ukey)) {
+      path.keys.push_back(ukey);
+      path.distances.push_back(root_dist + ws_.distance(ukey));
+      if (ukey == spur_key)
+        break;
+    }
+    reverse(path.keys.begin() + i, path.keys.end());
+    reverse(path.distances.begin() + i, path.distances.end());
+    return path;
+  }
+
+private:
+  graph_t&       g_;
+  distance_fnc_t distance_fnc_;
+  allocator_t    alloc_;
+  workspace_t    ws_;
+  bool_vector    banned_vertex_; // vertices on the root path
+  key_vector     banned_next_;   // vertices that can't be reached directly from the spur vertex
+};
+
+
+//! Find the k shortest loopless paths from the source to the target vertex using Yen's algorithm.
+//!
+//! Complexity is O(k|V|(|E| + |V|log|V|)) in the worst case, though each spur search stops when
+//! it reaches the target.
+//!
+//! @param g           The graph
+//! @param source      The source vertex of the paths.
+//! @param target      The target vertex of the paths.
+//! @param result_iter The output iterator that results are written to, in order of increasing
+//!                    distance. The iterator must accept a type of
+//!                    shortest_path<vertex_iterator_t<G>, DistanceT>. Fewer than k paths are
+//!                    written if there aren't k loopless paths from source to target.
+//! @param k           The maximum number of paths to find.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1. Weights must
+//!                    be non-negative.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        DistFnc,
+          typename        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void k_shortest_paths(
+      G&                   g,
+      vertex_iterator_t<G> source,
+      vertex_iterator_t<G> target,
+      OutIter              result_iter,
+      size_t const         k,
+      DistFnc              distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                    alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  yen_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  fn.shortest_paths(source, target, k, result_iter);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_K_SHORTEST_PATHS_HPP
@@ -0,0 +1,474 @@
+//
+// Maximum flow & minimum cut with the push-relabel algorithm of Goldberg & Tarjan.
+//
+// The residual graph is built once as a compressed array of arcs: each edge u->v with a positive
+// capacity adds the arc u->v to the arcs of u and its reverse arc v->u (with no capacity) to the
+// arcs of v, and each arc holds the index of its pair. Pushing flow along an arc moves residual
+// capacity to its pair. The edges of an undirected graph are seen from both ends, so they carry
+// flow in either direction. Self-loops are skipped.
+//
+// Only the first phase is run: it finds a maximum preflow, where the excess at the sink is the
+// value of the maximum flow. The source side of the minimum cut is the vertices that can't reach
+// the sink in the final residual graph, which is the largest minimum cut. The flow of each edge
+// isn't reported, since that needs a second phase to return the remaining excess to the source.
+//
+// The serial algorithm discharges the active vertex with the highest label first, keeping the
+// active vertices & all the vertices in a bucket for each label. Two heuristics keep the labels
+// close to the distance to the sink:
+//  1. Global relabeling sets every label to the exact distance to the sink in the residual graph
+//     with a breadth-first search backwards from the sink, after about 6|V| + |A| units of
+//     relabeling work.
+//  2. Gap relabeling: when the last vertex with a label leaves it, no vertex with a higher label
+//     can reach the sink, so they're all removed.
+//
+// The ExecutionPolicy overload is the lock-free algorithm of Hong & He: the active vertices are
+// discharged concurrently in rounds, each pushing to its lowest residual neighbor if that's lower
+// than itself and relabeling to one more than it otherwise. Residual capacities and excesses are
+// updated with atomic additions, and a vertex is queued for the next round when its excess
+// becomes positive, so each vertex is discharged by one thread at a time. A global relabel (also
+// a parallel breadth-first search) runs when the work of the rounds reaches the same bound, and
+// the algorithm stops when no vertex with excess can reach the sink after a global relabel.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+
+#ifndef GRAPH_MAX_FLOW_HPP
+#  define GRAPH_MAX_FLOW_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of push-relabel maximum flow, holding the residual graph. It's built
+//! when it's constructed, and each call finds the maximum flow from the original capacities.
+//!
+// clang-format off
+template <incidence_graph G, typename CapacityFnc, typename FlowT, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class push_relabel_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using flow_type      = FlowT;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  push_relabel_fn(ExecutionPolicy&& policy,
+                  graph_type&       g,
+                  key_type const    source,
+                  key_type const    sink,
+                  CapacityFnc&      capacity_fnc,
+                  allocator_type    alloc = A())
+        : n_(static_cast<key_type>(ranges::size(g)))
+        , source_(source)
+        , sink_(sink)
+        , offsets_(static_cast<size_t>(n_) + 1, 0, alloc)
+        , head_(alloc)
+        , pair_(alloc)
+        , capacity_(alloc)
+        , residual_(alloc)
+        , excess_(n_, alloc)
+        , label_(n_, alloc)
+        , current_(n_, alloc)
+        , active_head_(static_cast<size_t>(n_) + 1, none, alloc)
+        , active_next_(n_, alloc)
+        , all_head_(static_cast<size_t>(n_) + 1, none, alloc)
+        , all_next_(n_, alloc)
+        , all_prev_(n_, alloc)
+        , queue_(n_, alloc) {
+    detail::for_each_index(policy, key_type(0), n_, [this, &g, &capacity_fnc](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(g, uv, ukey);
+        if (vkey != ukey && static_cast<flow_type>(capacity_fnc(*uv)) > flow_type()) {
+          atomic_ref<size_t>(offsets_[ukey + 1]).fetch_add(1, memory_order_relaxed);
+          atomic_ref<size_t>(offsets_[vkey + 1]).fetch_add(1, memory_order_relaxed);
+        }
+      }
+    });
+    inclusive_scan(policy, offsets_.begin() + 1, offsets_.end(), offsets_.begin() + 1);
+
+    head_.resize(offsets_[n_]);
+    pair_.resize(offsets_[n_]);
+    capacity_.resize(offsets_[n_]);
+    size_vector next(offsets_.begin(), offsets_.end() - 1, alloc);
+    detail::for_each_index(policy, key_type(0), n_, [this, &g, &capacity_fnc, &next](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const  vkey = vertex_key(g, uv, ukey);
+        flow_type const cap  = static_cast<flow_type>(capacity_fnc(*uv));
+        if (vkey != ukey && cap > flow_type()) {
+          size_t const a = atomic_ref<size_t>(next[ukey]).fetch_add(1, memory_order_relaxed);
+          size_t const b = atomic_ref<size_t>(next[vkey]).fetch_add(1, memory_order_relaxed);
+          head_[a]       = vkey;
+          head_[b]       = ukey;
+          pair_[a]       = b;
+          pair_[b]       = a;
+          capacity_[a]   = cap;
+          capacity_[b]   = flow_type();
+        }
+      }
+    });
+  }
+
+  //! Find a maximum preflow, discharging the active vertex with the highest label first.
+  //! @return The value of the maximum flow.
+  flow_type operator()() {
+    preflow();
+    global_relabel();
+    for (;;) {
+      while (top_active_ > 0 && active_head_[top_active_ - 1] == none)
+        --top_active_;
+      if (top_active_ == 0)
+        break;
+      key_type const ukey           = active_head_[top_active_ - 1];
+      active_head_[top_active_ - 1] = active_next_[ukey];
+      if (label_[ukey] >= n_)
+        continue; // removed by the gap heuristic, so it can't reach the sink
+      discharge(ukey);
+      if (work_ > global_relabel_work())
+        global_relabel();
+    }
+    relabel_from_sink(execution::seq); // exact labels for the cut
+    return excess_[sink_];
+  }
+
+  //! Find a maximum preflow by discharging the active vertices concurrently.
+  //! @return The value of the maximum flow.
+  template <typename ExecutionPolicy>
+  flow_type operator()(ExecutionPolicy&& policy) {
+    preflow();
+    key_vector& active = queue_;
+    key_vector  next(n_, queue_.get_allocator());
+    for (;;) {
+      relabel_from_sink(policy);
+      size_t active_size = 0;
+      detail::for_each_index(policy, key_type(0), n_, [this, &active, &active_size](key_type const ukey) {
+        if (excess_[ukey] > flow_type() && label_[ukey] < n_ && ukey != source_ && ukey != sink_)
+          active[atomic_ref<size_t>(active_size).fetch_add(1, memory_order_relaxed)] = ukey;
+      });
+      if (active_size == 0)
+        break;
+
+      work_ = 0;
+      while (active_size > 0 && work_ <= global_relabel_work()) {
+        size_t next_size = 0;
+        detail::for_each_index(policy, size_t(0), active_size, [this, &active, &next, &next_size](size_t const i) {
+          discharge_concurrent(active[i], next, next_size);
+        });
+        swap(active, next);
+        active_size = next_size;
+      }
+    }
+    return excess_[sink_];
+  }
+
+  //! True if ukey is on the source side of the minimum cut found by the last call.
+  bool source_side(key_type const ukey) const noexcept { return label_[ukey] >= n_; }
+
+protected:
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+  using flow_vector = vector<flow_type, typename allocator_traits<A>::template rebind_alloc<flow_type>>;
+
+  static constexpr key_type none = numeric_limits<key_type>::max();
+
+  //! The relabeling work (arcs scanned, plus a constant per relabel) between global relabels.
+  size_t global_relabel_work() const noexcept { return 6 * static_cast<size_t>(n_) + head_.size(); }
+
+  //! Reset the residual graph & saturate the arcs out of the source.
+  void preflow() {
+    residual_ = capacity_;
+    fill(excess_.begin(), excess_.end(), flow_type());
+    for (size_t a = offsets_[source_]; a < offsets_[source_ + 1]; ++a) {
+      flow_type const delta = residual_[a];
+      residual_[a]          = flow_type();
+      residual_[pair_[a]] += delta;
+      excess_[head_[a]] += delta;
+    }
+  }
+
+  //! Set each label to the distance to the sink in the residual graph, or n if it can't reach the
+  //! sink, with a level-synchronous breadth-first search backwards from the sink.
+  template <typename ExecutionPolicy>
+  void relabel_from_sink(ExecutionPolicy&& policy) {
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const ukey) { label_[ukey] = n_; });
+    key_vector next(n_, queue_.get_allocator());
+    label_[sink_]        = 0;
+    queue_[0]            = sink_;
+    size_t frontier_size = 1;
+    for (key_type level = 1; frontier_size > 0; ++level) {
+      size_t next_size = 0;
+      detail::for_each_index(policy, size_t(0), frontier_size, [&, level](size_t const i) {
+        key_type const vkey = queue_[i];
+        for (size_t a = offsets_[vkey]; a < offsets_[vkey + 1]; ++a) {
+          key_type const ukey = head_[a];
+          if (ukey != source_ && residual_[pair_[a]] > flow_type() &&
+              detail::atomic_compare_exchange(label_[ukey], n_, level))
+            next[atomic_ref<size_t>(next_size).fetch_add(1, memory_order_relaxed)] = ukey;
+        }
+      });
+      swap(queue_, next);
+      frontier_size = next_size;
+    }
+  }
+
+  //! Relabel exactly from the sink & rebuild the buckets of the serial algorithm.
+  void global_relabel() {
+    relabel_from_sink(execution::seq);
+    fill(active_head_.begin(), active_head_.end(), none);
+    fill(all_head_.begin(), all_head_.end(), none);
+    top_active_ = top_all_ = 0;
+    for (key_type ukey = 0; ukey < n_; ++ukey) {
+      current_[ukey] = offsets_[ukey];
+      if (label_[ukey] < n_ && ukey != sink_) {
+        add_all(ukey);
+        if (excess_[ukey] > flow_type())
+          add_active(ukey);
+      }
+    }
+    work_ = 0;
+  }
+
+  void add_active(key_type const ukey) {
+    key_type const d   = label_[ukey];
+    active_next_[ukey] = active_head_[d];
+    active_head_[d]    = ukey;
+    top_active_        = max(top_active_, static_cast<key_type>(d + 1));
+  }
+
+  void add_all(key_type const ukey) {
+    key_type const d = label_[ukey];
+    all_prev_[ukey]  = none;
+    all_next_[ukey]  = all_head_[d];
+    if (all_head_[d] != none)
+      all_prev_[all_head_[d]] = ukey;
+    all_head_[d] = ukey;
+    top_all_     = max(top_all_, static_cast<key_type>(d + 1));
+  }
+
+  void remove_all(key_type const ukey) {
+    if (all_prev_[ukey] != none)
+      all_next_[all_prev_[ukey]] = all_next_[ukey];
+    else
+      all_head_[label_[ukey]] = all_next_[ukey];
+    if (all_next_[ukey] != none)
+      all_prev_[all_next_[ukey]] = all_prev_[ukey];
+  }
+
+  //! Push the excess of ukey along admissible arcs, relabeling it when there are none left, until
+  //! it has no excess or can't reach the sink.
+  void discharge(key_type const ukey) {
+    size_t const last = offsets_[ukey + 1];
+    while (excess_[ukey] > flow_type()) {
+      key_type const d = label_[ukey];
+      size_t         a = current_[ukey];
+      for (; a < last; ++a) {
+        key_type const vkey = head_[a];
+        if (residual_[a] > flow_type() && label_[vkey] + 1 == d) {
+          if (excess_[vkey] == flow_type() && vkey != sink_)
+            add_active(vkey);
+          flow_type const delta = min(excess_[ukey], residual_[a]);
+          residual_[a] -= delta;
+          residual_[pair_[a]] += delta;
+          excess_[ukey] -= delta;
+          excess_[vkey] += delta;
+          if (excess_[ukey] == flow_type())
+            break;
+        }
+      }
+      if (a < last) {
+        current_[ukey] = a;
+        return;
+      }
+
+      // relabel, or remove the vertices above a gap
+      work_ += last - offsets_[ukey] + 12;
+      remove_all(ukey);
+      if (all_head_[d] == none) {
+        for (key_type gap = d + 1; gap < top_all_; ++gap) {
+          for (key_type vkey = all_head_[gap]; vkey != none; vkey = all_next_[vkey])
+            label_[vkey] = n_;
+          all_head_[gap] = none;
+        }
+        top_all_     = d;
+        label_[ukey] = n_;
+        return;
+      }
+      key_type lowest = n_;
+      for (size_t b = offsets_[ukey]; b < last; ++b) {
+        if (residual_[b] > flow_type() && label_[head_[b]] < lowest) {
+          lowest         = label_[head_[b]];
+          current_[ukey] = b;
+        }
+      }
+      if (lowest + 1 >= n_) {
+        label_[ukey] = n_;
+        return;
+      }
+      label_[ukey] = lowest + 1;
+      add_all(ukey);
+    }
+  }
+
+  //! Discharge ukey concurrently with other vertices. Only this thread changes the label of ukey
+  //! or takes excess from it; other threads may add excess to it & capacity to its arcs.
+  void discharge_concurrent(key_type const ukey, key_vector& next, size_t& next_size) {
+    size_t const first = offsets_[ukey], last = offsets_[ukey + 1];
+    size_t       work  = 0;
+    flow_type    e     = detail::atomic_load(excess_[ukey]);
+    while (e > flow_type() && label_[ukey] < n_) {
+      key_type lowest = numeric_limits<key_type>::max();
+      size_t   arc    = last;
+      for (size_t a = first; a < last; ++a) {
+        if (detail::atomic_load(residual_[a]) > flow_type()) {
+          key_type const h = detail::atomic_load(label_[head_[a]]);
+          if (h < lowest) {
+            lowest = h;
+            arc    = a;
+          }
+        }
+      }
+      work += last - first + 12;
+
+      if (arc != last && label_[ukey] > lowest) {
+        key_type const  vkey  = head_[arc];
+        flow_type const delta = min(e, detail::atomic_load(residual_[arc]));
+        atomic_ref<flow_type>(residual_[arc]).fetch_sub(delta, memory_order_relaxed);
+        atomic_ref<flow_type>(residual_[pair_[arc]]).fetch_add(delta, memory_order_relaxed);
+        if (atomic_ref<flow_type>(excess_[vkey]).fetch_add(delta, memory_order_relaxed) == flow_type() &&
+            vkey != source_ && vkey != sink_)
+          next[atomic_ref<size_t>(next_size).fetch_add(1, memory_order_relaxed)] = vkey;
+        e = atomic_ref<flow_type>(excess_[ukey]).fetch_sub(delta, memory_order_relaxed) - delta;
+      } else {
+        detail::atomic_store(label_[ukey], arc != last && lowest < n_ ? static_cast<key_type>(lowest + 1) : n_);
+      }
+    }
+    atomic_ref<size_t>(work_).fetch_add(work, memory_order_relaxed);
+  }
+
+private:
+  key_type    n_;
+  key_type    source_;
+  key_type    sink_;
+  size_vector offsets_;  // the arcs of ukey are [offsets_[ukey], offsets_[ukey + 1])
+  key_vector  head_;     // the vertex an arc points to
+  size_vector pair_;     // the reverse arc of an arc
+  flow_vector capacity_; // the capacity of each arc, 0 for reverse arcs
+  flow_vector residual_;
+  flow_vector excess_;
+  key_vector  label_;
+  size_vector current_; // the next arc of ukey to push along
+  size_t      work_ = 0;
+
+  // buckets by label: the active vertices, & all the vertices for the gap heuristic
+  key_vector active_head_;
+  key_vector active_next_;
+  key_vector all_head_;
+  key_vector all_next_;
+  key_vector all_prev_;
+  key_type   top_active_ = 0; // one more than the highest label with active vertices
+  key_type   top_all_    = 0; // one more than the highest label with vertices
+
+  key_vector queue_; // the breadth-first search frontier, or the active vertices in parallel rounds
+};
+
+
+//! Find the maximum flow from source to sink & a minimum cut with the highest-label push-relabel
+//! algorithm, with the global & gap relabeling heuristics.
+//!
+//! Complexity is O(|V|^2 sqrt(|E|)).
+//!
+//! @param g            The graph
+//! @param source       The key of the source vertex.
+//! @param sink         The key of the sink vertex, which must be different from source.
+//! @param cut_iter     The beginning of a random-access range of size(g) values, where
+//!                     cut_iter[ukey] is assigned true if ukey is on the source side of the
+//!                     minimum cut, and false if it's on the sink side.
+//! @param capacity_fnc The capacity function object, called with the value of an edge. Edges
+//!                     with no capacity are ignored.
+//! @param alloc        The allocator to use for internal containers.
+//! @return             The value of the maximum flow.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CutIter,
+          typename               CapacityFnc,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<CapacityFnc, edge_value_t<G>&>>>
+auto push_relabel_max_flow(G&                    g,
+                           vertex_key_t<G> const source,
+                           vertex_key_t<G> const sink,
+                           CutIter               cut_iter,
+                           CapacityFnc           capacity_fnc,
+                           A                     alloc = A())
+// clang-format on
+{
+  using flow_t = remove_cvref_t<invoke_result_t<CapacityFnc, edge_value_t<G>&>>;
+  push_relabel_fn<G, CapacityFnc, flow_t, A> fn(execution::seq, g, source, sink, capacity_fnc, alloc);
+  flow_t const flow = fn();
+  for (vertex_key_t<G> ukey = 0; ukey < static_cast<vertex_key_t<G>>(ranges::size(g)); ++ukey)
+    cut_iter[static_cast<iter_difference_t<CutIter>>(ukey)] = fn.source_side(ukey);
+  return flow;
+}
+
+//! Find the maximum flow from source to sink & a minimum cut with the lock-free parallel
+//! push-relabel algorithm.
+//!
+//! @param policy       The execution policy used.
+//! @param g            The graph
+//! @param source       The key of the source vertex.
+//! @param sink         The key of the sink vertex, which must be different from source.
+//! @param cut_iter     The beginning of a random-access range of size(g) values, where
+//!                     cut_iter[ukey] is assigned true if ukey is on the source side of the
+//!                     minimum cut, and false if it's on the sink side.
+//! @param capacity_fnc The capacity function object, called with the value of an edge. Edges
+//!                     with no capacity are ignored.
+//! @param alloc        The allocator to use for internal containers.
+//! @return             The value of the maximum flow.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CutIter,
+          typename               CapacityFnc,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<CapacityFnc, edge_value_t<G>&>>>
+auto push_relabel_max_flow(ExecutionPolicy&&     policy,
+                           G&                    g,
+                           vertex_key_t<G> const source,
+                           vertex_key_t<G> const sink,
+                           CutIter               cut_iter,
+                           CapacityFnc           capacity_fnc,
+                           A                     alloc = A())
+// clang-format on
+{
+  using flow_t = remove_cvref_t<invoke_result_t<CapacityFnc, edge_value_t<G>&>>;
+  push_relabel_fn<G, CapacityFnc, flow_t, A> fn(policy, g, source, sink, capacity_fnc, alloc);
+  flow_t const flow = fn(policy);
+  detail::for_each_index(policy, vertex_key_t<G>(0), static_cast<vertex_key_t<G>>(ranges::size(g)),
+                         [&fn, &cut_iter](vertex_key_t<G> const ukey) {
+                           cut_iter[static_cast<iter_difference_t<CutIter>>(ukey)] = fn.source_side(ukey);
+                         });
+  return flow;
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_MAX_FLOW_HPP
@@ -0,0 +1,380 @@
+//
+// Minimum spanning forests of undirected graphs.
+//
+// The edges are copied once into an array of (source, target, weight, edge iterator), taking each
+// undirected edge from the endpoint with the lower key and skipping self-loops. A forest is found
+// for every connected component, and the edges of the forest are written to an output iterator as
+// spanning_tree_edge, with the edge iterator so the caller can reach the edge's value.
+//
+// kruskal_minimum_spanning_tree sorts the edges by weight (in parallel with an ExecutionPolicy)
+// and adds each edge that joins two components of a union-find structure.
+//
+// filter_kruskal_minimum_spanning_tree avoids sorting the edges that can't be in the forest. The
+// edges are partitioned around a pivot weight; the light edges are processed first (recursively),
+// then the heavy edges that now join two vertices of the same component are filtered out before
+// the rest are processed. On graphs with many more edges than vertices most heavy edges are
+// filtered, so the time is close to O(|E| + |V| log |V| log(|E|/|V|)).
+//
+// boruvka_minimum_spanning_tree works in rounds, each in parallel: every component finds its
+// lightest edge to another component, those edges are added, and the edges inside the merged
+// components are removed. The number of components at least halves in each round. Ties are
+// broken by the position of the edge, so every component agrees on a strict order of the edges
+// and the edges added in a round can't form a cycle.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "incremental_components.hpp"
+
+#ifndef GRAPH_MINIMUM_SPANNING_TREE_HPP
+#  define GRAPH_MINIMUM_SPANNING_TREE_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! An edge of a minimum spanning forest. The target is vertex_key(g, edge, source).
+template <typename G, typename WeightT>
+struct spanning_tree_edge {
+  vertex_key_t<G>           source = vertex_key_t<G>();
+  vertex_edge_iterator_t<G> edge;
+  WeightT                   weight = WeightT();
+};
+
+//! Internal implementation of the minimum spanning forest algorithms.
+//!
+// clang-format off
+template <incidence_graph G, typename WeightFnc, typename WeightT, typename A = allocator<char>>
+  requires undirected<G> && ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class minimum_spanning_tree_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using weight_type    = WeightT;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+  using value_type     = spanning_tree_edge<G, WeightT>;
+
+  template <typename ExecutionPolicy>
+  minimum_spanning_tree_fn(ExecutionPolicy&& policy, graph_type& g, WeightFnc& weight_fnc, allocator_type alloc = A())
+        : n_(static_cast<key_type>(ranges::size(g))), edges_(alloc), tree_(alloc), sets_(n_, alloc) {
+    // each undirected edge is taken from the endpoint with the lower key
+    size_vector offsets(static_cast<size_t>(n_) + 1, 0, alloc);
+    detail::for_each_index(policy, key_type(0), n_, [&g, &offsets](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      size_t                 count     = 0;
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv)
+        count += ukey < vertex_key(g, uv, ukey);
+      offsets[ukey + 1] = count;
+    });
+    inclusive_scan(policy, offsets.begin() + 1, offsets.end(), offsets.begin() + 1);
+
+    edges_.resize(offsets[n_]);
+    detail::for_each_index(policy, key_type(0), n_, [this, &g, &weight_fnc, &offsets](key_type const ukey) {
+      size_t                 i         = offsets[ukey];
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(g, uv, ukey);
+        if (ukey < vkey)
+          edges_[i++] = {ukey, vkey, static_cast<weight_type>(weight_fnc(*uv)), uv};
+      }
+    });
+    tree_.reserve(n_ > 0 ? n_ - 1 : 0);
+  }
+
+  //! Sort all the edges & add them in order.
+  template <typename ExecutionPolicy>
+  void kruskal(ExecutionPolicy&& policy) {
+    add_sorted(policy, edges_.begin(), edges_.end());
+  }
+
+  //! Add the edges in order, sorting only the edges that may be in the forest.
+  template <typename ExecutionPolicy>
+  void filter_kruskal(ExecutionPolicy&& policy) {
+    filter_kruskal(policy, edges_.begin(), edges_.end());
+  }
+
+  //! Add the lightest edge of each component to another component, in parallel rounds. The edges
+  //! inside merged components are removed from edges_ after each round.
+  template <typename ExecutionPolicy>
+  void boruvka(ExecutionPolicy&& policy) {
+    constexpr size_t      none = numeric_limits<size_t>::max();
+    constexpr weight_type inf  = numeric_limits<weight_type>::max();
+    size_vector           lightest(n_, none, edges_.get_allocator());
+    weight_vector         min_weight(n_, inf, edges_.get_allocator());
+    key_vector            comp(n_, edges_.get_allocator());
+    iota(comp.begin(), comp.end(), key_type(0));
+    tree_.resize(n_ > 0 ? n_ - 1 : 0);
+    size_t tree_size = 0;
+
+    while (!edges_.empty()) {
+      // the lightest weight of each component, then the first edge with it; the second pass only
+      // reads the edge records in order, rather than the current lightest edge of each component
+      detail::for_each_index(policy, size_t(0), edges_.size(), [this, &comp, &min_weight](size_t const e) {
+        detail::atomic_min(min_weight[comp[edges_[e].source]], edges_[e].weight);
+        detail::atomic_min(min_weight[comp[edges_[e].target]], edges_[e].weight);
+      });
+      detail::for_each_index(policy, size_t(0), edges_.size(), [this, &comp, &min_weight, &lightest](size_t e) {
+        key_type const ucomp = comp[edges_[e].source], vcomp = comp[edges_[e].target];
+        if (edges_[e].weight == min_weight[ucomp])
+          detail::atomic_min(lightest[ucomp], e);
+        if (edges_[e].weight == min_weight[vcomp])
+          detail::atomic_min(lightest[vcomp], e);
+      });
+      detail::for_each_index(policy, key_type(0), n_, [&](key_type const ukey) {
+        size_t const e = lightest[ukey];
+        if (comp[ukey] != ukey || e == none)
+          return;
+        lightest[ukey]   = none;
+        min_weight[ukey] = inf;
+        if (sets_.unite(edges_[e].source, edges_[e].target)) // false for the other end of the same edge
+          tree_[atomic_ref<size_t>(tree_size).fetch_add(1, memory_order_relaxed)] = edges_[e];
+      });
+      detail::for_each_index(policy, key_type(0), n_,
+                             [this, &comp](key_type const ukey) { comp[ukey] = sets_.find(ukey); });
+      auto last = remove_if(policy, edges_.begin(), edges_.end(), [&comp](edge_type const& e) {
+        return comp[e.source] == comp[e.target]; // inside a merged component
+      });
+      edges_.erase(last, edges_.end());
+    }
+    tree_.resize(tree_size);
+  }
+
+  //! Write the edges of the forest to out.
+  //! @return The total weight of the forest.
+  template <typename OutIter>
+  weight_type output(OutIter out) const {
+    weight_type total = weight_type();
+    for (edge_type const& e : tree_) {
+      *out = value_type{e.source, e.uv, e.weight};
+      ++out;
+      total += e.weight;
+    }
+    return total;
+  }
+
+protected:
+  struct edge_type {
+    key_type                  source = key_type();
+    key_type                  target = key_type();
+    weight_type               weight = weight_type();
+    vertex_edge_iterator_t<G> uv;
+  };
+  using edge_vector   = vector<edge_type, typename allocator_traits<A>::template rebind_alloc<edge_type>>;
+  using edge_iter     = typename edge_vector::iterator;
+  using key_vector    = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector   = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+  using weight_vector = vector<weight_type, typename allocator_traits<A>::template rebind_alloc<weight_type>>;
+  using set_type      = concurrent_disjoint_set<key_type, typename key_vector::allocator_type>;
+
+  // Below this many edges filter_kruskal sorts instead of partitioning.
+  static constexpr ptrdiff_t sort_threshold = 4096;
+
+  bool done() const noexcept { return sets_.components() == 1; }
+
+  template <typename ExecutionPolicy>
+  void add_sorted(ExecutionPolicy&& policy, edge_iter first, edge_iter last) {
+    sort(policy, first, last, [](edge_type const& a, edge_type const& b) { return a.weight < b.weight; });
+    for (; first != last && !done(); ++first)
+      if (sets_.unite(first->source, first->target))
+        tree_.push_back(*first);
+  }
+
+  template <typename ExecutionPolicy>
+  void filter_kruskal(ExecutionPolicy&& policy, edge_iter first, edge_iter last) {
+    if (last - first <= sort_threshold) {
+      add_sorted(policy, first, last);
+      return;
+    }
+    weight_type const pivot = pivot_weight(first, last);
+    edge_iter         mid = partition(policy, first, last, [pivot](edge_type const& e) { return e.weight < pivot; });
+    if (mid == first) // the pivot is the lightest weight
+      mid = partition(policy, first, last, [pivot](edge_type const& e) { return !(pivot < e.weight); });
+    if (mid == last) { // all weights are equal
+      add_sorted(policy, first, last);
+      return;
+    }
+
+    filter_kruskal(policy, first, mid);
+    if (done())
+      return;
+    last = remove_if(policy, mid, last,
+                     [this](edge_type const& e) { return sets_.find(e.source) == sets_.find(e.target); });
+    filter_kruskal(policy, mid, last);
+  }
+
+  //! The median weight of a sample of the edges.
+  weight_type pivot_weight(edge_iter first, edge_iter last) const {
+    constexpr ptrdiff_t samples = 31;
+    weight_type         sample[samples];
+    ptrdiff_t const     step = (last - first) / samples;
+    for (ptrdiff_t i = 0; i < samples; ++i)
+      sample[i] = first[i * step + (i * 7919) % step].weight;
+    nth_element(sample, sample + samples / 2, sample + samples);
+    return sample[samples / 2];
+  }
+
+private:
+  key_type    n_;
+  edge_vector edges_;
+  edge_vector tree_;
+  set_type    sets_;
+};
+
+
+//! Find a minimum spanning forest of an undirected graph with Kruskal's algorithm, sorting the
+//! edges in parallel.
+//!
+//! Complexity is O(|E| log |E|).
+//!
+//! @param policy      The execution policy used to copy & sort the edges.
+//! @param g           The graph
+//! @param result_iter The output iterator that the edges of the forest are written to, in order
+//!                    of increasing weight. It must accept a spanning_tree_edge<G, WeightT>,
+//!                    where WeightT is the type returned by weight_fnc.
+//! @param weight_fnc  The weight function object, called with the value of an edge.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The total weight of the forest.
+//
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G,
+          typename        OutIter,
+          typename        WeightFnc,
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>>
+auto kruskal_minimum_spanning_tree(
+      ExecutionPolicy&& policy, G& g, OutIter result_iter, WeightFnc weight_fnc, A alloc = A())
+// clang-format on
+{
+  using weight_t = remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>;
+  minimum_spanning_tree_fn<G, WeightFnc, weight_t, A> fn(policy, g, weight_fnc, alloc);
+  fn.kruskal(policy);
+  return fn.output(result_iter);
+}
+
+//! Find a minimum spanning forest of an undirected graph with Kruskal's algorithm.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        WeightFnc,
+          typename        A = allocator<char>>
+  requires undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>>
+auto kruskal_minimum_spanning_tree(G& g, OutIter result_iter, WeightFnc weight_fnc, A alloc = A())
+// clang-format on
+{
+  return kruskal_minimum_spanning_tree(execution::seq, g, result_iter, weight_fnc, alloc);
+}
+
+//! Find a minimum spanning forest of an undirected graph with filter-Kruskal, which only sorts
+//! the edges that may be in the forest. Partitioning & filtering use the execution policy.
+//!
+//! Complexity is O(|E| log |E|) in the worst case, and close to O(|E|) when |E| is much larger
+//! than |V|.
+//!
+//! @param policy      The execution policy used.
+//! @param g           The graph
+//! @param result_iter The output iterator that the edges of the forest are written to, in order
+//!                    of increasing weight. It must accept a spanning_tree_edge<G, WeightT>,
+//!                    where WeightT is the type returned by weight_fnc.
+//! @param weight_fnc  The weight function object, called with the value of an edge.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The total weight of the forest.
+//
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G,
+          typename        OutIter,
+          typename        WeightFnc,
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>>
+auto filter_kruskal_minimum_spanning_tree(
+      ExecutionPolicy&& policy, G& g, OutIter result_iter, WeightFnc weight_fnc, A alloc = A())
+// clang-format on
+{
+  using weight_t = remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>;
+  minimum_spanning_tree_fn<G, WeightFnc, weight_t, A> fn(policy, g, weight_fnc, alloc);
+  fn.filter_kruskal(policy);
+  return fn.output(result_iter);
+}
+
+//! Find a minimum spanning forest of an undirected graph with filter-Kruskal.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        WeightFnc,
+          typename        A = allocator<char>>
+  requires undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>>
+auto filter_kruskal_minimum_spanning_tree(G& g, OutIter result_iter, WeightFnc weight_fnc, A alloc = A())
+// clang-format on
+{
+  return filter_kruskal_minimum_spanning_tree(execution::seq, g, result_iter, weight_fnc, alloc);
+}
+
+//! Find a minimum spanning forest of an undirected graph with Borůvka's algorithm, running each
+//! round in parallel.
+//!
+//! Complexity is O(|E| log |V|) work over O(log |V|) rounds.
+//!
+//! @param policy      The execution policy used.
+//! @param g           The graph
+//! @param result_iter The output iterator that the edges of the forest are written to, in no
+//!                    particular order. It must accept a spanning_tree_edge<G, WeightT>, where
+//!                    WeightT is the type returned by weight_fnc.
+//! @param weight_fnc  The weight function object, called with the value of an edge.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            The total weight of the forest.
+//
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G,
+          typename        OutIter,
+          typename        WeightFnc,
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           undirected<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>>
+auto boruvka_minimum_spanning_tree(
+      ExecutionPolicy&& policy, G& g, OutIter result_iter, WeightFnc weight_fnc, A alloc = A())
+// clang-format on
+{
+  using weight_t = remove_cvref_t<invoke_result_t<WeightFnc, edge_value_t<G>&>>;
+  minimum_spanning_tree_fn<G, WeightFnc, weight_t, A> fn(policy, g, weight_fnc, alloc);
+  fn.boruvka(policy);
+  return fn.output(result_iter);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_MINIMUM_SPANNING_TREE_HPP
@@ -0,0 +1,483 @@
+//
+// PageRank of the vertices of a directed graph, with an optional personalization vector.
+//
+// The rank of v is (1 - d) p(v) + d (sum of r(u)/outdegree(u) for the edges u->v) + d D p(v),
+// where d is the damping factor, p is the personalization vector (uniform by default) and D is
+// the total rank of the dangling vertices, those without outgoing edges, which is redistributed in
+// proportion to p. The ranks always sum to 1.
+//
+// The power iteration is done in the pull formulation: the incoming edges of each vertex are
+// copied once into a compressed array of source keys, and each iteration computes the new rank of
+// each vertex from the contributions r(u)/outdegree(u) of its sources. Each vertex is only written
+// by the thread that computes it, so no atomics are needed, and the ranks, contributions and
+// sources are contiguous arrays scanned in order. The ExecutionPolicy overloads compute the
+// vertices of each iteration in parallel.
+//
+// Iteration stops when the sum of the absolute changes in rank (the L1 norm) is less than the
+// tolerance, or after the maximum number of iterations.
+//
+// forward_push_page_rank approximates the personalized PageRank of a single seed vertex locally,
+// with the forward push of Andersen, Chung & Lang. Each touched vertex has an estimate p and a
+// residual r, starting with r(seed) = 1. While a vertex u has r(u) >= epsilon * outdegree(u), it's
+// pushed: (1 - d) r(u) is added to p(u) and d r(u) / outdegree(u) to the residual of each vertex it
+// has an edge to. The residual of a dangling vertex goes back to the seed, as the personalization
+// does in page_rank. Each push moves at least (1 - d) epsilon outdegree(u) of the residual to the
+// estimates, so the total work is O(1 / (epsilon (1 - d))) regardless of the size of the graph.
+// The estimates and residuals are kept in a workspace that is allocated once and reused, and only
+// the vertices touched by a query are visited again to reset them.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+
+#ifndef GRAPH_PAGE_RANK_HPP
+#  define GRAPH_PAGE_RANK_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of PageRank. The incoming edges are found when it's constructed, so it
+//! can be run many times with different parameters.
+//!
+// clang-format off
+template <incidence_graph G, floating_point RankT = double, typename A = allocator<char>>
+  requires directed<G>
+class page_rank_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using rank_type      = RankT;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  page_rank_fn(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+        : n_(static_cast<key_type>(ranges::size(g)))
+        , in_offsets_(static_cast<size_t>(n_) + 1, 0, alloc)
+        , in_sources_(alloc)
+        , inv_out_degree_(n_, rank_type(0), alloc)
+        , dangling_(alloc)
+        , personal_(alloc)
+        , rank_(alloc)
+        , next_(alloc)
+        , contrib_(alloc) {
+    // count the incoming edges, & the outgoing edges of each vertex
+    detail::for_each_index(policy, key_type(0), n_, [this, &g](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      size_t                 degree    = 0;
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv, ++degree)
+        atomic_ref<size_t>(in_offsets_[vertex_key(g, uv, ukey) + 1]).fetch_add(1, memory_order_relaxed);
+      if (degree > 0)
+        inv_out_degree_[ukey] = rank_type(1) / static_cast<rank_type>(degree);
+    });
+    inclusive_scan(policy, in_offsets_.begin() + 1, in_offsets_.end(), in_offsets_.begin() + 1);
+
+    // fill the sources, then sort them so the contributions are read in increasing order
+    in_sources_.resize(in_offsets_[n_]);
+    size_vector next(in_offsets_.begin(), in_offsets_.end() - 1, alloc);
+    detail::for_each_index(policy, key_type(0), n_, [this, &g, &next](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv)
+        in_sources_[atomic_ref<size_t>(next[vertex_key(g, uv, ukey)]).fetch_add(1, memory_order_relaxed)] = ukey;
+    });
+    detail::for_each_index(policy, key_type(0), n_, [this](key_type const vkey) {
+      sort(in_sources_.begin() + static_cast<ptrdiff_t>(in_offsets_[vkey]),
+           in_sources_.begin() + static_cast<ptrdiff_t>(in_offsets_[vkey + 1]));
+    });
+
+    for (key_type ukey = 0; ukey < n_; ++ukey)
+      if (inv_out_degree_[ukey] == rank_type(0))
+        dangling_.push_back(ukey);
+  }
+
+  //! Compute the ranks, assigning the rank of each vertex to rank_iter[ukey].
+  //!
+  //! @param personal_fnc personal_fnc(ukey) returns the personalization weight of ukey, or is
+  //!                     nullptr for a uniform personalization. Weights are normalized to sum to 1.
+  //! @return             The number of iterations.
+  template <typename ExecutionPolicy, random_access_iterator RankIter, typename PersonalFnc>
+  size_t operator()(ExecutionPolicy&& policy,
+                    RankIter          rank_iter,
+                    PersonalFnc&&     personal_fnc,
+                    rank_type const   damping,
+                    rank_type const   tolerance,
+                    size_t const      max_iterations) {
+    if (n_ == 0)
+      return 0;
+    init_personalization(policy, personal_fnc);
+    rank_ = personal_;
+    next_.resize(n_);
+    contrib_.resize(n_);
+
+    size_t iterations = 0;
+    while (iterations < max_iterations) {
+      ++iterations;
+      detail::for_each_index(policy, key_type(0), n_,
+                             [this](key_type const ukey) { contrib_[ukey] = rank_[ukey] * inv_out_degree_[ukey]; });
+      rank_type dangling_rank = 0;
+      for (key_type const ukey : dangling_)
+        dangling_rank += rank_[ukey];
+
+      // the restart & dangling ranks are both distributed by the personalization
+      rank_type const base  = (rank_type(1) - damping) + damping * dangling_rank;
+      rank_type const error = transform_reduce(
+            policy, detail::index_iterator<key_type>(0), detail::index_iterator<key_type>(n_), rank_type(0),
+            plus<rank_type>(), [this, damping, base](key_type const vkey) {
+              rank_type sum = 0;
+              for (size_t i = in_offsets_[vkey]; i < in_offsets_[vkey + 1]; ++i)
+                sum += contrib_[in_sources_[i]];
+              next_[vkey] = base * personal_[vkey] + damping * sum;
+              return abs(next_[vkey] - rank_[vkey]);
+            });
+      swap(rank_, next_);
+      if (error < tolerance)
+        break;
+    }
+
+    detail::for_each_index(policy, key_type(0), n_, [this, &rank_iter](key_type const ukey) {
+      rank_iter[static_cast<iter_difference_t<RankIter>>(ukey)] = static_cast<iter_value_t<RankIter>>(rank_[ukey]);
+    });
+    return iterations;
+  }
+
+protected:
+  using size_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using rank_vector = vector<rank_type, typename allocator_traits<A>::template rebind_alloc<rank_type>>;
+
+  template <typename ExecutionPolicy, typename PersonalFnc>
+  void init_personalization(ExecutionPolicy&& policy, PersonalFnc&& personal_fnc) {
+    personal_.assign(n_, rank_type(1) / static_cast<rank_type>(n_));
+    if constexpr (!is_null_pointer_v<remove_cvref_t<PersonalFnc>>) {
+      detail::for_each_index(policy, key_type(0), n_, [this, &personal_fnc](key_type const ukey) {
+        personal_[ukey] = static_cast<rank_type>(personal_fnc(ukey));
+      });
+      rank_type const total = reduce(policy, personal_.begin(), personal_.end(), rank_type(0));
+      if (total > rank_type(0))
+        for_each(policy, personal_.begin(), personal_.end(), [total](rank_type& p) { p /= total; });
+      else
+        fill(personal_.begin(), personal_.end(), rank_type(1) / static_cast<rank_type>(n_));
+    }
+  }
+
+private:
+  key_type    n_;
+  size_vector in_offsets_; // in_sources_[in_offsets_[v]..in_offsets_[v+1]) are the sources of v
+  key_vector  in_sources_;
+  rank_vector inv_out_degree_; // 1/outdegree, or 0 for a dangling vertex
+  key_vector  dangling_;
+  rank_vector personal_;
+  rank_vector rank_;
+  rank_vector next_;
+  rank_vector contrib_; // rank/outdegree
+};
+
+
+//! Compute the PageRank of each vertex in parallel.
+//!
+//! @param policy         The execution policy used.
+//! @param g              The graph
+//! @param rank_iter      The beginning of a random-access range of size(g) floating-point values,
+//!                       where rank_iter[ukey] is assigned the rank of ukey. The ranks sum to 1.
+//! @param damping        The probability of following an edge rather than restarting.
+//! @param tolerance      Iteration stops when the sum of the changes in rank is less than this.
+//! @param max_iterations The maximum number of iterations.
+//! @param alloc          The allocator to use for internal containers.
+//! @return               The number of iterations.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator RankIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           floating_point<iter_value_t<RankIter>>
+size_t page_rank(ExecutionPolicy&&           policy,
+                 G&                          g,
+                 RankIter                    rank_iter,
+                 iter_value_t<RankIter> const damping        = 0.85,
+                 iter_value_t<RankIter> const tolerance      = 1e-6,
+                 size_t const                max_iterations = 100,
+                 A                           alloc          = A())
+// clang-format on
+{
+  page_rank_fn<G, iter_value_t<RankIter>, A> fn(policy, g, alloc);
+  return fn(policy, rank_iter, nullptr, damping, tolerance, max_iterations);
+}
+
+//! Compute the PageRank of each vertex.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator RankIter,
+          typename               A = allocator<char>>
+  requires directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           floating_point<iter_value_t<RankIter>>
+size_t page_rank(G&                          g,
+                 RankIter                    rank_iter,
+                 iter_value_t<RankIter> const damping        = 0.85,
+                 iter_value_t<RankIter> const tolerance      = 1e-6,
+                 size_t const                max_iterations = 100,
+                 A                           alloc          = A())
+// clang-format on
+{
+  return page_rank(execution::seq, g, rank_iter, damping, tolerance, max_iterations, alloc);
+}
+
+//! Compute the personalized PageRank of each vertex in parallel, where restarts and the rank of
+//! dangling vertices go to the vertices in proportion to their personalization weight.
+//!
+//! @param policy         The execution policy used.
+//! @param g              The graph
+//! @param personal_iter  The beginning of a random-access range of size(g) non-negative weights,
+//!                       where personal_iter[ukey] is the weight of ukey. They're normalized to
+//!                       sum to 1; if they're all 0 a uniform personalization is used.
+//! @param rank_iter      The beginning of a random-access range of size(g) floating-point values,
+//!                       where rank_iter[ukey] is assigned the rank of ukey. The ranks sum to 1.
+//! @param damping        The probability of following an edge rather than restarting.
+//! @param tolerance      Iteration stops when the sum of the changes in rank is less than this.
+//! @param max_iterations The maximum number of iterations.
+//! @param alloc          The allocator to use for internal containers.
+//! @return               The number of iterations.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator PersonalIter,
+          random_access_iterator RankIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           floating_point<iter_value_t<RankIter>>
+size_t personalized_page_rank(ExecutionPolicy&&           policy,
+                              G&                          g,
+                              PersonalIter                personal_iter,
+                              RankIter                    rank_iter,
+                              iter_value_t<RankIter> const damping        = 0.85,
+                              iter_value_t<RankIter> const tolerance      = 1e-6,
+                              size_t const                max_iterations = 100,
+                              A                           alloc          = A())
+// clang-format on
+{
+  page_rank_fn<G, iter_value_t<RankIter>, A> fn(policy, g, alloc);
+  auto personal_fnc = [&personal_iter](vertex_key_t<G> const ukey) {
+    return personal_iter[static_cast<iter_difference_t<PersonalIter>>(ukey)];
+  };
+  return fn(policy, rank_iter, personal_fnc, damping, tolerance, max_iterations);
+}
+
+//! Compute the personalized PageRank of each vertex.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator PersonalIter,
+          random_access_iterator RankIter,
+          typename               A = allocator<char>>
+  requires directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           floating_point<iter_value_t<RankIter>>
+size_t personalized_page_rank(G&                          g,
+                              PersonalIter                personal_iter,
+                              RankIter                    rank_iter,
+                              iter_value_t<RankIter> const damping        = 0.85,
+                              iter_value_t<RankIter> const tolerance      = 1e-6,
+                              size_t const                max_iterations = 100,
+                              A                           alloc          = A())
+// clang-format on
+{
+  return personalized_page_rank(execution::seq, g, personal_iter, rank_iter, damping, tolerance, max_iterations,
+                                alloc);
+}
+
+
+//! A vertex and its rank, as returned by forward_push_page_rank.
+template <typename G, typename RankT>
+struct vertex_rank {
+  vertex_key_t<G> key  = vertex_key_t<G>();
+  RankT           rank = RankT();
+};
+
+//! Approximate personalized PageRank of single seed vertices, computed locally by forward push.
+//! It's constructed once for a graph and then queried many times.
+//!
+// clang-format off
+template <incidence_graph G, floating_point RankT = double, typename A = allocator<char>>
+  requires directed<G> && integral<vertex_key_t<G>>
+class forward_push_page_rank
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using rank_type      = RankT;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+  using value_type     = vertex_rank<G, RankT>;
+
+  //! The estimates and residuals of a query. Concurrent queries must each use a different
+  //! workspace.
+  class workspace {
+  public:
+    workspace(forward_push_page_rank const& fp, allocator_type alloc = A())
+          : stamp_(fp.degree_.size(), 0, alloc)
+          , estimate_(fp.degree_.size(), rank_type(0), alloc)
+          , residual_(fp.degree_.size(), rank_type(0), alloc)
+          , queued_(fp.degree_.size(), 0, alloc)
+          , touched_(alloc)
+          , queue_(alloc) {}
+
+    //! The estimated rank of ukey from the last query.
+    rank_type estimate(key_type const ukey) const noexcept {
+      return stamp_[ukey] == cur_stamp_ ? estimate_[ukey] : rank_type(0);
+    }
+
+    //! The number of vertices touched by the last query.
+    size_t touched() const noexcept { return touched_.size(); }
+
+  private:
+    friend class forward_push_page_rank;
+    using stamp_vector = vector<uint32_t, typename allocator_traits<A>::template rebind_alloc<uint32_t>>;
+    using rank_vector  = vector<rank_type, typename allocator_traits<A>::template rebind_alloc<rank_type>>;
+    using mark_vector  = vector<uint8_t, typename allocator_traits<A>::template rebind_alloc<uint8_t>>;
+    using key_vector   = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+
+    stamp_vector stamp_; // estimate_ & residual_ are only valid for vertices with the current stamp
+    rank_vector  estimate_;
+    rank_vector  residual_;
+    mark_vector  queued_;
+    key_vector   touched_; // vertices with the current stamp
+    key_vector   queue_;
+    uint32_t     cur_stamp_ = 0;
+  };
+
+  forward_push_page_rank(graph_type& g, allocator_type alloc = A())
+        : graph_(g), degree_(ranges::size(g), 0, alloc), ws_(*this, alloc) {
+    for (key_type ukey = 0; ukey < static_cast<key_type>(degree_.size()); ++ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(graph_, find_vertex(graph_, ukey));
+      degree_[ukey] = static_cast<key_type>(ranges::distance(edges_rng));
+    }
+  }
+
+  //! Assign the (at most) k vertices with the highest estimated rank for seed to out, in order of
+  //! decreasing rank. This uses the object's own workspace, so it mustn't be called concurrently.
+  //!
+  //! @param damping The probability of following an edge rather than restarting at the seed.
+  //! @param epsilon The residual per outgoing edge below which a vertex isn't pushed. The error
+  //!                of the estimate of each vertex is less than epsilon times its outdegree.
+  //! @return        The number of vertices assigned.
+  template <output_iterator<value_type> OutIter>
+  size_t top_k(key_type const  seed,
+               size_t const    k,
+               OutIter         out,
+               rank_type const damping = 0.85,
+               rank_type const epsilon = 1e-4) {
+    return top_k(seed, k, out, ws_, damping, epsilon);
+  }
+
+  //! Assign the (at most) k vertices with the highest estimated rank for seed to out, using ws.
+  template <output_iterator<value_type> OutIter>
+  size_t top_k(key_type const  seed,
+               size_t const    k,
+               OutIter         out,
+               workspace&      ws,
+               rank_type const damping = 0.85,
+               rank_type const epsilon = 1e-4) const {
+    push(seed, ws, damping, epsilon);
+
+    auto by_rank = [&ws](key_type const ukey, key_type const vkey) {
+      return ws.estimate_[ukey] > ws.estimate_[vkey] || (ws.estimate_[ukey] == ws.estimate_[vkey] && ukey < vkey);
+    };
+    auto first = ws.touched_.begin();
+    auto last  = partition(first, ws.touched_.end(), [&ws](key_type const ukey) { return ws.estimate_[ukey] > 0; });
+    size_t const count = min(k, static_cast<size_t>(last - first));
+    partial_sort(first, first + static_cast<ptrdiff_t>(count), last, by_rank);
+    for (size_t i = 0; i < count; ++i, ++out)
+      *out = value_type{first[static_cast<ptrdiff_t>(i)], ws.estimate_[first[static_cast<ptrdiff_t>(i)]]};
+    return count;
+  }
+
+  //! Push the residual from seed until no vertex has a residual of epsilon per outgoing edge. The
+  //! estimates are then available from ws.estimate().
+  void push(key_type const seed, workspace& ws, rank_type const damping = 0.85, rank_type const epsilon = 1e-4) const {
+    if (++ws.cur_stamp_ == 0) { // wrapped
+      fill(ws.stamp_.begin(), ws.stamp_.end(), 0);
+      ws.cur_stamp_ = 1;
+    }
+    ws.touched_.clear();
+    ws.queue_.clear();
+
+    auto touch = [&ws](key_type const ukey) {
+      if (ws.stamp_[ukey] != ws.cur_stamp_) {
+        ws.stamp_[ukey]    = ws.cur_stamp_;
+        ws.estimate_[ukey] = ws.residual_[ukey] = rank_type(0);
+        ws.touched_.push_back(ukey);
+      }
+    };
+    // a vertex is queued when its residual reaches the threshold, & stays queued until it's pushed
+    auto add_residual = [this, &ws, epsilon](key_type const ukey, rank_type const r) {
+      ws.residual_[ukey] += r;
+      rank_type const threshold = epsilon * static_cast<rank_type>(max(degree_[ukey], key_type(1)));
+      if (!ws.queued_[ukey] && ws.residual_[ukey] >= threshold) {
+        ws.queued_[ukey] = 1;
+        ws.queue_.push_back(ukey);
+      }
+    };
+
+    touch(seed);
+    add_residual(seed, rank_type(1));
+    for (size_t head = 0; head < ws.queue_.size(); ++head) {
+      key_type const  ukey = ws.queue_[head];
+      rank_type const r    = ws.residual_[ukey];
+      ws.queued_[ukey]     = 0;
+      ws.residual_[ukey]   = rank_type(0);
+      ws.estimate_[ukey] += (rank_type(1) - damping) * r;
+
+      if (degree_[ukey] == 0) {
+        add_residual(seed, damping * r);
+        continue;
+      }
+      rank_type const        share     = damping * r / static_cast<rank_type>(degree_[ukey]);
+      vertex_edge_range_t<G> edges_rng = edges(graph_, find_vertex(graph_, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(graph_, uv, ukey);
+        touch(vkey);
+        add_residual(vkey, share);
+      }
+    }
+  }
+
+protected:
+  using key_vector = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+
+private:
+  graph_type& graph_;
+  key_vector  degree_; // outdegree
+  workspace   ws_;
+};
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_PAGE_RANK_HPP
@@ -0,0 +1,235 @@
+//
+// A reachability index for answering many "can u reach v?" queries on a static directed graph.
+//
+// The strongly connected components are condensed first, since every vertex in a component
+// reaches the same vertices. The components are then labeled with GRAIL intervals: a depth-first
+// traversal of the condensation, visiting the roots and the successors of each component in a
+// random order, gives each component its post-order rank and the lowest rank of any component it
+// reaches. If u reaches v, the interval of v is inside the interval of u in every traversal, so a
+// query that fails this check for any label is answered immediately. Several independent
+// traversals make false positives rare, and they're built in parallel by the ExecutionPolicy
+// constructor.
+//
+// The post-order ranks of the components in the depth-first tree below a component are
+// contiguous, so the tree interval of the first traversal also answers many positive queries
+// immediately. Other queries fall back to a depth-first search of the condensation that skips
+// components whose labels don't contain the target. Components are numbered in reverse
+// topological order, so components numbered below the target are skipped as well. All answers are
+// exact.
+//
+// The index is O(|V| + |E| + kC) in size for k labels and C components, compared with O(C^2) for
+// the full transitive closure.
+//
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "components.hpp"
+
+#ifndef GRAPH_REACHABILITY_HPP
+#  define GRAPH_REACHABILITY_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! An index of a directed graph for answering reachability queries.
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires directed<G>
+class reachability_index
+// clang-format on
+{
+public:
+  using graph_type        = G;
+  using allocator_type    = A;
+  using key_type          = vertex_key_t<G>;
+  using condensation_type = condensation<G, A>;
+
+  //! Scratch space for the searches of queries that the labels don't answer. Concurrent queries
+  //! must each use a different workspace.
+  class workspace {
+  public:
+    workspace(reachability_index const& index, allocator_type alloc = A())
+          : visited_(index.cond_.components(), 0, alloc), stack_(alloc) {}
+
+  private:
+    friend class reachability_index;
+    using stamp_vector = vector<uint32_t, typename allocator_traits<A>::template rebind_alloc<uint32_t>>;
+    using key_vector   = typename condensation_type::key_vector;
+
+    stamp_vector visited_; // components visited by the search with the current stamp
+    key_vector   stack_;
+    uint32_t     stamp_ = 0;
+  };
+
+  //! Build the index with num_labels random traversals.
+  reachability_index(graph_type& g, size_t const num_labels = 3, allocator_type alloc = A())
+        : cond_(g, alloc)
+        , k_(max(num_labels, size_t(1)))
+        , labels_(cond_.components() * k_, alloc)
+        , tree_low_(cond_.components(), alloc)
+        , alloc_(alloc)
+        , ws_(*this, alloc) {
+    for (size_t i = 0; i < k_; ++i)
+      label(i);
+  }
+
+  //! Build the index with num_labels random traversals, run in parallel.
+  // clang-format off
+  template <typename ExecutionPolicy>
+    requires execution_policy<ExecutionPolicy>
+  reachability_index(ExecutionPolicy&& policy, graph_type& g, size_t const num_labels = 3, allocator_type alloc = A())
+  // clang-format on
+        : cond_(g, alloc)
+        , k_(max(num_labels, size_t(1)))
+        , labels_(cond_.components() * k_, alloc)
+        , tree_low_(cond_.components(), alloc)
+        , alloc_(alloc)
+        , ws_(*this, alloc) {
+    detail::for_each_index(policy, size_t(0), k_, [this](size_t const i) { label(i); });
+  }
+
+  //! The number of vertices
+  size_t size() const noexcept { return cond_.size(); }
+  //! The strongly connected components the index is built on.
+  condensation_type const& components() const noexcept { return cond_; }
+
+  //! True if there's a path of one or more edges from ukey to vkey. A vertex only reaches itself
+  //! if it's on a cycle. This uses the index's own workspace, so it mustn't be called concurrently.
+  bool reaches(key_type const ukey, key_type const vkey) { return reaches(ukey, vkey, ws_); }
+
+  //! True if there's a path of one or more edges from ukey to vkey, using ws for any search.
+  bool reaches(key_type const ukey, key_type const vkey, workspace& ws) const {
+    key_type const ucomp = cond_.component(ukey), vcomp = cond_.component(vkey);
+    if (ucomp == vcomp)
+      return ukey != vkey || cond_.is_cyclic(ucomp);
+    if (vcomp > ucomp || !contains(ucomp, vcomp))
+      return false;
+    if (tree_low_[ucomp] <= post(vcomp, 0) && post(vcomp, 0) <= post(ucomp, 0))
+      return true; // vcomp is below ucomp in the first traversal's tree
+    return search(ucomp, vcomp, ws);
+  }
+
+protected:
+  struct interval {
+    key_type low  = 0; // lowest post-order rank reachable
+    key_type post = 0; // post-order rank
+  };
+  using interval_vector = vector<interval, typename allocator_traits<A>::template rebind_alloc<interval>>;
+  using key_vector      = typename condensation_type::key_vector;
+  using mark_vector     = vector<uint8_t, typename allocator_traits<A>::template rebind_alloc<uint8_t>>;
+
+  interval const& at(size_t const comp, size_t const i) const noexcept { return labels_[comp * k_ + i]; }
+  interval&       at(size_t const comp, size_t const i) noexcept { return labels_[comp * k_ + i]; }
+  key_type        post(size_t const comp, size_t const i) const noexcept { return at(comp, i).post; }
+
+  //! True if the labels of ucomp contain the labels of vcomp, which is required for ucomp to reach
+  //! vcomp.
+  bool contains(size_t const ucomp, size_t const vcomp) const noexcept {
+    interval const* u = &at(ucomp, 0);
+    interval const* v = &at(vcomp, 0);
+    for (size_t i = 0; i < k_; ++i)
+      if (v[i].low < u[i].low || v[i].post > u[i].post)
+        return false;
+    return true;
+  }
+
+  //! Assign label i with a depth-first traversal of the condensation in a random order.
+  void label(size_t const i) {
+    size_t const ncomp = cond_.components();
+    minstd_rand  rng(static_cast<minstd_rand::result_type>(i + 1));
+
+    key_vector roots(ncomp, alloc_);
+    iota(roots.begin(), roots.end(), key_type(0));
+    shuffle(roots.begin(), roots.end(), rng);
+
+    struct dfs_elem {
+      key_type comp;
+      key_type first; // the rank of the first component finished below comp
+      size_t   start; // successors are visited from a random starting point
+      size_t   next;  // successors visited so far
+    };
+    vector<dfs_elem, typename allocator_traits<A>::template rebind_alloc<dfs_elem>> dfs(alloc_);
+    mark_vector visited(ncomp, 0, alloc_);
+    key_type    rank = 0;
+
+    auto push = [&](key_type const comp) {
+      visited[comp]       = 1;
+      size_t const degree = ranges::size(cond_.successors(comp));
+      at(comp, i).low     = numeric_limits<key_type>::max();
+      dfs.push_back({comp, rank, degree > 0 ? rng() % degree : 0, 0});
+    };
+
+    for (key_type const root : roots) {
+      if (visited[root])
+        continue;
+      push(root);
+      while (!dfs.empty()) {
+        dfs_elem&      top   = dfs.back();
+        auto           succs = cond_.successors(top.comp);
+        size_t const   deg   = ranges::size(succs);
+        key_type const comp  = top.comp;
+        if (top.next < deg) {
+          key_type const succ = succs[(top.start + top.next++) % deg];
+          if (!visited[succ])
+            push(succ); // invalidates top
+          else
+            at(comp, i).low = min(at(comp, i).low, at(succ, i).low); // already finished in a DAG
+          continue;
+        }
+        interval& lbl = at(comp, i);
+        lbl.post      = rank++;
+        lbl.low       = min(lbl.low, lbl.post);
+        if (i == 0)
+          tree_low_[comp] = top.first;
+        dfs.pop_back();
+        if (!dfs.empty())
+          at(dfs.back().comp, i).low = min(at(dfs.back().comp, i).low, lbl.low);
+      }
+    }
+  }
+
+  //! Search the condensation from ucomp for vcomp, skipping components that can't reach it.
+  bool search(key_type const ucomp, key_type const vcomp, workspace& ws) const {
+    if (++ws.stamp_ == 0) { // wrapped
+      fill(ws.visited_.begin(), ws.visited_.end(), 0);
+      ws.stamp_ = 1;
+    }
+    ws.stack_.clear();
+    ws.stack_.push_back(ucomp);
+    ws.visited_[ucomp] = ws.stamp_;
+    while (!ws.stack_.empty()) {
+      key_type const comp = ws.stack_.back();
+      ws.stack_.pop_back();
+      for (key_type const succ : cond_.successors(comp)) {
+        if (succ == vcomp)
+          return true;
+        if (succ > vcomp && ws.visited_[succ] != ws.stamp_ && contains(succ, vcomp)) {
+          ws.visited_[succ] = ws.stamp_;
+          ws.stack_.push_back(succ);
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  condensation_type cond_;
+  size_t            k_;        // labels per component
+  interval_vector   labels_;   // labels_[comp * k_ + i] is label i of comp
+  key_vector        tree_low_; // the lowest post-order rank in the first traversal's tree below comp
+  allocator_type    alloc_;
+  workspace         ws_;
+};
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_REACHABILITY_HPP
@@ -15,11 +15,29 @@
 // is the user's responsibility to assure only non-negative weights exist. Outputting leaf-only
 // distances/paths adds an additional O(|V| + |E|).
 //
+// When the distance type is integral, Dijkstra's algorithm uses a monotone radix heap instead of
+// a priority_queue. Because the weights are non-negative the extracted distances never decrease,
+// so each entry only moves between O(log C) buckets (C = largest distance) instead of paying for
+// O(log |V|) comparisons on every push & pop.
+//
+// dijkstra_workspace holds the buffers for a single-source search so they can be reused for
+// many searches on the same graph, resetting only the vertices reached by the previous search.
+// Its search stops when the caller's settle function returns false, which allows searches to end
+// as soon as the vertices of interest have been settled.
+//
 // Bellman-Ford shortest path algorithm runs in O(|V| * |E|) and support negative edge weights.
 // It is slower than Dijktra's algorithm but is more versatile because it supports negative
 // edge weights. Outputting leaf-only distances/paths adds an additional O(|V| + |E|). Detecting
 // negative edge cycles adds an addtional O(|E|).
 //
+// The SPFA variant of Bellman-Ford (spfa_shortest_distances, spfa_shortest_paths) only relaxes the
+// edges of vertices whose distance changed on the previous iteration. It has the same worst-case
+// time, but typically visits a small fraction of the edges on each iteration after the first few.
+//
+// The ExecutionPolicy overloads of Bellman-Ford partition the edges on each iteration across
+// threads, using atomic min updates on the distances. They require edges(g) to be a
+// random-access range.
+//
 // Both algorithms support shortest-distance and shortest-path varients, where shortest-path
 // requires memory allocation of a vector of vertex iterators for each value returned to the
 // output iterator passed.
@@ -47,7 +65,13 @@
 
 #include <queue>
 #include <vector>
+#include <atomic>
+#include <functional>
+#include <bit>
+#include <limits>
+#include <cassert>
 #include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
 
 #define SHORTEST_RANGE
 
@@ -115,6 +139,225 @@ struct shortest_path
   shortest_path(A alloc) : path(alloc) {}
 };
 
+namespace detail {
+  //! A monotone priority queue for unsigned integral keys (radix heap).
+  //!
+  //! Keys pushed must never be less than the key of the last value popped, which holds for
+  //! Dijkstra's algorithm with non-negative weights. Values are kept in buckets based on the
+  //! highest bit that differs from the last key popped. Popping from an empty bucket 0
+  //! redistributes the next non-empty bucket, so each value moves at most digits(KeyT) times.
+  //!
+  // clang-format off
+  template <unsigned_integral KeyT, typename ValueT, typename A = allocator<pair<KeyT, ValueT>>>
+  class radix_heap
+  // clang-format on
+  {
+  public:
+    using key_type       = KeyT;
+    using value_type     = pair<KeyT, ValueT>;
+    using allocator_type = typename allocator_traits<A>::template rebind_alloc<value_type>;
+
+  protected:
+    using bucket_type       = vector<value_type, allocator_type>;
+    using bucket_alloc      = typename allocator_traits<A>::template rebind_alloc<bucket_type>;
+    using bucket_cont       = vector<bucket_type, bucket_alloc>;
+    static constexpr size_t bucket_count = numeric_limits<key_type>::digits + 1;
+
+  public:
+    radix_heap(A alloc = A()) : buckets_(bucket_count, bucket_type(allocator_type(alloc)), bucket_alloc(alloc)) {}
+
+    bool   empty() const noexcept { return size_ == 0; }
+    size_t size() const noexcept { return size_; }
+
+    void push(key_type key, ValueT const& val) {
+      assert(key >= last_); // monotone requirement
+      buckets_[bucket(key)].push_back({key, val});
+      ++size_;
+    }
+
+    value_type pop() {
+      assert(!empty());
+      if (buckets_[0].empty()) {
+        size_t i = 1;
+        while (buckets_[i].empty())
+          ++i;
+        bucket_type& from = buckets_[i];
+        last_             = ranges::min_element(from, {}, &value_type::first)->first;
+        for (value_type& kv : from)
+          buckets_[bucket(kv.first)].push_back(kv);
+        from.clear();
+      }
+      value_type kv = buckets_[0].back();
+      buckets_[0].pop_back();
+      --size_;
+      return kv;
+    }
+
+    void clear() {
+      for (bucket_type& b : buckets_)
+        b.clear();
+      last_ = 0;
+      size_ = 0;
+    }
+
+  protected:
+    size_t bucket(key_type key) const noexcept { return static_cast<size_t>(bit_width(key ^ last_)); }
+
+  private:
+    bucket_cont buckets_;
+    key_type    last_ = 0; // last key popped
+    size_t      size_ = 0;
+  };
+} // namespace detail
+
+
+//! Reusable buffers for running many single-source Dijkstra searches on the same graph. The
+//! buffers are sized to the graph once, and only the vertices reached by the previous search are
+//! reset when the next one starts. The cost of a search is proportional to the part of the graph
+//! it explores rather than to the size of the graph.
+//!
+template <integral KeyT, typename DistanceT, typename A = allocator<char>>
+class dijkstra_workspace {
+  // integral distances use a radix heap (bool isn't a distance)
+  static constexpr bool use_radix_heap = is_integral_v<DistanceT> && !is_same_v<DistanceT, bool>;
+
+  using heap_key_t = make_unsigned_t<conditional_t<use_radix_heap, DistanceT, unsigned>>;
+  using heap_entry = pair<DistanceT, KeyT>;
+  using heap_t     = conditional_t<use_radix_heap,
+                               detail::radix_heap<heap_key_t, KeyT, A>,
+                               vector<heap_entry, typename allocator_traits<A>::template rebind_alloc<heap_entry>>>;
+
+public:
+  using key_type       = KeyT;
+  using distance_type  = DistanceT;
+  using allocator_type = A;
+  using key_vector     = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using dist_vector    = vector<DistanceT, typename allocator_traits<A>::template rebind_alloc<DistanceT>>;
+
+  static constexpr key_type  null_key      = numeric_limits<key_type>::max();
+  static constexpr DistanceT null_distance = numeric_limits<DistanceT>::max();
+
+  dijkstra_workspace(size_t const n, allocator_type alloc = allocator_type())
+        : distance_(n, null_distance, alloc), predecessor_(n, null_key, alloc), reached_(alloc), heap_(alloc) {}
+
+  size_t         size() const noexcept { return distance_.size(); }
+  allocator_type get_allocator() const { return allocator_type(distance_.get_allocator()); }
+
+  //! The distance from the source of the last search, or null_distance if ukey wasn't reached.
+  //! The distance is tentative for vertices reached but not settled when the search was stopped.
+  DistanceT distance(key_type const ukey) const noexcept { return distance_[ukey]; }
+  //! The previous vertex on the path from the source, or null_key if ukey wasn't reached. The
+  //! predecessor of the source is itself.
+  key_type predecessor(key_type const ukey) const noexcept { return predecessor_[ukey]; }
+  //! The vertices reached by the last search, in the order they were first reached.
+  key_vector const& reached() const noexcept { return reached_; }
+
+  //! Reset the vertices reached by the last search.
+  void reset() {
+    for (key_type ukey : reached_) {
+      distance_[ukey]    = null_distance;
+      predecessor_[ukey] = null_key;
+    }
+    reached_.clear();
+    heap_.clear();
+  }
+
+  //! Run Dijkstra's algorithm from source. settle_fnc(ukey, distance) is called as each vertex is
+  //! settled, in order of increasing distance, and the search stops when it returns false.
+  //!
+  //! @param g           The graph
+  //! @param source      The key of the source vertex.
+  //! @param distance_fnc
+  //!                    The weight function object used to determine the distance between
+  //!                    vertices on an edge. Weights must be non-negative.
+  //! @param settle_fnc  Called with the key and distance of each vertex settled. Return false to
+  //!                    stop the search.
+  template <incidence_graph G, typename DistFnc, typename SettleFnc>
+  void search(G& g, key_type const source, DistFnc& distance_fnc, SettleFnc&& settle_fnc) {
+    search(g, source, distance_fnc, settle_fnc, [](key_type) { return DistanceT(0); });
+  }
+
+  //! Run Dijkstra's algorithm from source using the reduced weights
+  //! distance_fnc(uv) + potential_fnc(ukey) - potential_fnc(vkey), which must be non-negative
+  //! even when distance_fnc returns negative weights (e.g. the potentials from Johnson's
+  //! algorithm). The distances are the reduced distances; the distance of the original weights
+  //! to vkey is distance(vkey) - potential_fnc(source) + potential_fnc(vkey).
+  template <incidence_graph G, typename DistFnc, typename SettleFnc, typename PotentialFnc>
+  void search(G& g, key_type const source, DistFnc& distance_fnc, SettleFnc&& settle_fnc, PotentialFnc&& potential_fnc) {
+    run(g, source, distance_fnc, settle_fnc, potential_fnc, [](key_type, key_type, auto&&) { return true; });
+  }
+
+  //! Run Dijkstra's algorithm from source, only following the edges uv from ukey to vkey where
+  //! edge_pred(ukey, vkey, *uv) is true. This excludes vertices and edges from the search without
+  //! copying or modifying the graph.
+  template <incidence_graph G, typename DistFnc, typename SettleFnc, typename EdgePred>
+  void search_if(G& g, key_type const source, DistFnc& distance_fnc, SettleFnc&& settle_fnc, EdgePred&& edge_pred) {
+    run(g, source, distance_fnc, settle_fnc, [](key_type) { return DistanceT(0); }, edge_pred);
+  }
+
+protected:
+  template <incidence_graph G, typename DistFnc, typename SettleFnc, typename PotentialFnc, typename EdgePred>
+  void run(G&             g,
+           key_type const source,
+           DistFnc&       distance_fnc,
+           SettleFnc&&    settle_fnc,
+           PotentialFnc&& potential_fnc,
+           EdgePred&&     edge_pred) {
+    reset();
+    reach(source, 0, source);
+    while (!heap_.empty()) {
+      auto [u_dist, ukey] = pop();
+      if (u_dist != distance_[ukey])
+        continue; // stale entry; ukey was reached with a shorter distance after it was pushed
+      if (!settle_fnc(ukey, u_dist))
+        break;
+
+      DistanceT const        u_potential = potential_fnc(ukey);
+      vertex_edge_range_t<G> edges_rng   = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(g, uv, ukey);
+        if (!edge_pred(ukey, vkey, *uv))
+          continue;
+        DistanceT const v_dist = u_dist + distance_fnc(*uv) + u_potential - potential_fnc(vkey);
+        if (v_dist < distance_[vkey])
+          reach(vkey, v_dist, ukey);
+      }
+    }
+  }
+
+  void reach(key_type const ukey, DistanceT const u_dist, key_type const pred_key) {
+    if (distance_[ukey] == null_distance)
+      reached_.push_back(ukey);
+    distance_[ukey]    = u_dist;
+    predecessor_[ukey] = pred_key;
+    if constexpr (use_radix_heap) {
+      heap_.push(static_cast<heap_key_t>(u_dist), ukey);
+    } else {
+      heap_.push_back({u_dist, ukey});
+      push_heap(heap_.begin(), heap_.end(), greater<heap_entry>());
+    }
+  }
+
+  heap_entry pop() {
+    if constexpr (use_radix_heap) {
+      auto [u_dist, ukey] = heap_.pop();
+      return {static_cast<DistanceT>(u_dist), ukey};
+    } else {
+      pop_heap(heap_.begin(), heap_.end(), greater<heap_entry>());
+      heap_entry top = heap_.back();
+      heap_.pop_back();
+      return top;
+    }
+  }
+
+private:
+  dist_vector distance_;
+  key_vector  predecessor_;
+  key_vector  reached_;
+  heap_t      heap_;
+};
+
+
 //! Internal implementation of the Dijstra algorithm.
 //!
 template <incidence_graph G, typename DistFnc, typename DistanceT, typename A = allocator<DistanceT>>
@@ -134,6 +377,9 @@ class dijkstra_fn {
   };
   using vertex_dist_cont = vector<vertex_dist>;
 
+  // integral distances use a radix heap (bool isn't a distance)
+  static constexpr bool use_radix_heap = is_integral_v<DistanceT> && !is_same_v<DistanceT, bool>;
+
 public:
   using graph_t        = G;
   using distance_fnc_t = DistFnc;
@@ -193,7 +439,71 @@ public:
     }
   }
 
+  using workspace_t = dijkstra_workspace<vertex_key_t<G>, DistanceT, A>;
+
+  template <typename OutIter>
+  void bounded_shortest_distances(workspace_t&         ws,
+                                  vertex_iterator_t<G> source,
+                                  OutIter              result_iter,
+                                  DistanceT const      max_distance,
+                                  size_t const         max_vertices) {
+    vertex_iterator_t<G> first = begin(vertices(g_));
+    find_bounded_paths(ws, source, max_distance, max_vertices, [&](vertex_key_t<G> const vkey, DistanceT const v_dist) {
+      *result_iter = {source, first + vkey, v_dist};
+      ++result_iter;
+    });
+  }
+
+  template <typename OutIter>
+  void bounded_shortest_paths(workspace_t&         ws,
+                              vertex_iterator_t<G> source,
+                              OutIter              result_iter,
+                              DistanceT const      max_distance,
+                              size_t const         max_vertices) {
+    using path_t = shortest_path<vertex_iterator_t<G>, DistanceT>;
+    using key_t  = vertex_key_t<G>;
+    path_t               spath(alloc_);
+    vertex_iterator_t<G> first = begin(vertices(g_));
+    find_bounded_paths(ws, source, max_distance, max_vertices, [&](key_t const vkey, DistanceT const v_dist) {
+      // predecessors are settled before the vertices they lead to, so the path is complete
+      spath.distance = v_dist;
+      for (key_t ukey = vkey; ws.predecessor(ukey) != ukey; ukey = ws.predecessor(ukey))
+        spath.path.push_back(first + ukey);
+      spath.path.push_back(source);
+
+      ranges::reverse(spath.path);
+      *result_iter = spath;
+      ++result_iter;
+      spath.path.clear();
+    });
+  }
+
 protected:
+  //! Run a search from source that stops once the next vertex to settle is further than
+  //! max_distance, or when max_vertices have been settled. Only the vertices touched by the
+  //! search are visited, so the cost is proportional to the size of the output.
+  //!
+  //! @param settle_fnc Called with the key and distance of each vertex settled within the bounds,
+  //!                   in order of increasing distance.
+  template <typename SettleFnc>
+  void find_bounded_paths(workspace_t&         ws,
+                          vertex_iterator_t<G> source,
+                          DistanceT const      max_distance,
+                          size_t const         max_vertices,
+                          SettleFnc&&          settle_fnc) {
+    if (max_vertices == 0) {
+      ws.reset();
+      return;
+    }
+    size_t settled = 0;
+    ws.search(g_, vertex_key(g_, source), distance_fnc_, [&](vertex_key_t<G> const ukey, DistanceT const u_dist) {
+      if (u_dist > max_distance)
+        return false;
+      settle_fnc(ukey, u_dist);
+      return ++settled < max_vertices; // don't relax the edges of the last vertex
+    });
+  }
+
   //! Find the shortest paths. Caller can determine how to transform the results to a higher level.
   //!
   //! @param source   The source vertex to start the search at
@@ -208,6 +518,32 @@ protected:
     vertex_key_t<G> const source_key = vertex_key(g_, source);
     distances[source_key]            = {source_key, 0};
 
+    if constexpr (use_radix_heap)
+      relax_radix_heap(source_key, distances);
+    else
+      relax_priority_queue(source_key, distances, leaf);
+
+    // Identify the leaves, if needed (only needed for undirected graphs)
+    if (leaves_only) {
+      // identify all vertices that are reachable by source
+      size_t reached = 0;
+      for (vertex_key_t<G> vkey = 0; vkey < distances.size(); ++vkey) {
+        if (distances[vkey].vtx_key != numeric_limits<vertex_key_t<G>>::max()) {
+          leaf[vkey] = true;
+          ++reached;
+        }
+      }
+      // turn off leaf for vertices that are previous to other vertices
+      if (reached > 1) {
+        for (edge_iterator_t<G> uv = begin(edges(g_)); uv != end(edges(g_)); ++uv)
+          if (target_vertex_key(g_, uv) != numeric_limits<vertex_key_t<G>>::max())
+            leaf[source_vertex_key(g_, uv)] = false;
+      }
+    }
+  }
+
+  //! Relax the edges using a priority_queue, ordered by the distance from the source.
+  void relax_priority_queue(vertex_key_t<G> const source_key, vertex_dist_cont& distances, vector<bool>& leaf) {
     struct q_vertex_dist { // --> template<G,DistanceT> path_detail; move outside function
       vertex_key_t<G> vtx_key    = numeric_limits<vertex_key_t<G>>::max();
       DistanceT       distance   = numeric_limits<DistanceT>::max(); // distance from source
@@ -247,23 +583,29 @@ protected:
         }
       }
     }
+  }
 
-    // Identify the leaves, if needed (only needed for undirected graphs)
-    if (leaves_only) {
-      // identify all vertices that are reachable by source
-      size_t reached = 0;
-      for (vertex_key_t<G> vkey = 0; vkey < distances.size(); ++vkey) {
-        if (distances[vkey].vtx_key != numeric_limits<vertex_key_t<G>>::max()) {
-          leaf[vkey] = true;
-          ++reached;
+  //! Relax the edges using a radix heap. Entries are never updated in the heap; a new entry is
+  //! pushed each time a shorter distance is found and stale entries are skipped when popped.
+  void relax_radix_heap(vertex_key_t<G> const source_key, vertex_dist_cont& distances) {
+    using heap_key_t = make_unsigned_t<DistanceT>;
+    detail::radix_heap<heap_key_t, vertex_key_t<G>, A> q(alloc_);
+
+    q.push(0, source_key);
+    while (!q.empty()) {
+      auto [u_dist, ukey] = q.pop();
+      if (u_dist != static_cast<heap_key_t>(distances[ukey].distance))
+        continue; // stale entry; ukey was reached with a shorter distance after it was pushed
+
+      vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, ukey));
+      for (vertex_edge_iterator_t<G> uv = edges_rng.begin(); uv != edges_rng.end(); ++uv) {
+        DistanceT       v_dist = distances[ukey].distance + distance_fnc_(*uv);
+        vertex_key_t<G> vkey   = vertex_key(g_, uv, ukey);
+        if (v_dist < distances[vkey].distance) {
+          distances[vkey] = {ukey, v_dist}; // {prev,dist}
+          q.push(static_cast<heap_key_t>(v_dist), vkey);
         }
       }
-      // turn off leaf for vertices that are previous to other vertices
-      if (reached > 1) {
-        for (edge_iterator_t<G> uv = begin(edges(g_)); uv != end(edges(g_)); ++uv)
-          if (target_vertex_key(g_, uv) != numeric_limits<vertex_key_t<G>>::max())
-            leaf[source_vertex_key(g_, uv)] = false;
-      }
     }
   }
 
@@ -274,6 +616,12 @@ protected:
 };
 
 
+//! Identifies how the edges are relaxed on each iteration of the Bellman-Ford algorithm.
+enum class bellman_ford_mode : int8_t {
+  edge_scan, // relax all edges in edges(g) on each iteration
+  worklist   // relax only the edges of vertices whose distance changed in the previous iteration (SPFA)
+};
+
 //! Internal implementation of the Bellman-Ford algorithm.
 //!
 template <incidence_graph G, typename DistFnc, typename DistanceT, typename A = allocator<DistanceT>>
@@ -300,42 +648,100 @@ public:
 
   //template <ranges::output_iterator<shortest_distance<vertex_iterator_t<G>, DistanceT>> OutIter>
   template <typename OutIter>
-  bool shortest_distances(vertex_iterator_t<G> source,
+  bool shortest_distances(vertex_iterator_t<G>    source,
+                          OutIter                 result_iter,
+                          bool const              leaves_only,
+                          bool const              detect_neg_edge_cycles,
+                          bellman_ford_mode const mode = bellman_ford_mode::edge_scan) {
+    // find the paths
+    vertex_dist_cont distances(ranges::size(g_), alloc_);
+    vector<bool>     leaf(ranges::size(g_), alloc_);
+    bool neg_edge_cycles = find_paths(source, distances, leaf, leaves_only, detect_neg_edge_cycles, mode);
+    if (neg_edge_cycles)
+      return true;
+
+    output_distances(source, distances, leaf, result_iter, leaves_only);
+    return false;
+  }
+
+  template <typename ExecutionPolicy, typename OutIter>
+  bool shortest_distances(ExecutionPolicy&&    policy,
+                          vertex_iterator_t<G> source,
                           OutIter              result_iter,
                           bool const           leaves_only,
                           bool const           detect_neg_edge_cycles) {
     // find the paths
-    vertex_dist_cont distance(ranges::size(g_), alloc_);
+    vertex_dist_cont distances(ranges::size(g_), alloc_);
     vector<bool>     leaf(ranges::size(g_), alloc_);
-    bool             neg_edge_cycles = find_paths(source, distance, leaf, leaves_only, detect_neg_edge_cycles);
+    bool             neg_edge_cycles =
+          find_paths(policy, source, distances, leaf, leaves_only, detect_neg_edge_cycles);
     if (neg_edge_cycles)
       return true;
 
-    // output distances to the output iterator
-    //using path                 = shortest_distance<vertex_iterator_t<G>, DistanceT>;
-    using key_t                = vertex_key_t<G>;
-    vertex_iterator_t<G> first = begin(vertices(g_));
-    for (key_t vkey = 0; vkey < static_cast<key_t>(distance.size()); ++vkey) {
-      if (!leaves_only || (leaves_only && leaf[vkey])) {
-        auto& [prev_key, dist] = distance[vkey];
-        *result_iter           = {source, first + vkey, dist};
-      }
-    }
+    output_distances(source, distances, leaf, result_iter, leaves_only);
     return false;
   }
 
   template <typename OutIter>
-  bool shortest_paths(vertex_iterator_t<G> source,
+  bool shortest_paths(vertex_iterator_t<G>    source,
+                      OutIter                 result_iter,
+                      bool const              leaves_only,
+                      bool const              detect_neg_edge_cycles,
+                      bellman_ford_mode const mode = bellman_ford_mode::edge_scan) {
+    // find the paths
+    vertex_dist_cont distances(ranges::size(g_), alloc_);
+    vector<bool>     leaf(ranges::size(g_), alloc_);
+    bool neg_edge_cycles = find_paths(source, distances, leaf, leaves_only, detect_neg_edge_cycles, mode);
+    if (neg_edge_cycles)
+      return true;
+
+    output_paths(source, distances, leaf, result_iter, leaves_only);
+    return false;
+  }
+
+  template <typename ExecutionPolicy, typename OutIter>
+  bool shortest_paths(ExecutionPolicy&&    policy,
+                      vertex_iterator_t<G> source,
                       OutIter              result_iter,
                       bool const           leaves_only,
                       bool const           detect_neg_edge_cycles) {
     // find the paths
     vertex_dist_cont distances(ranges::size(g_), alloc_);
     vector<bool>     leaf(ranges::size(g_), alloc_);
-    bool             neg_edge_cycles = find_paths(source, distances, leaf, leaves_only, detect_neg_edge_cycles);
+    bool             neg_edge_cycles =
+          find_paths(policy, source, distances, leaf, leaves_only, detect_neg_edge_cycles);
     if (neg_edge_cycles)
       return true;
 
+    output_paths(source, distances, leaf, result_iter, leaves_only);
+    return false;
+  }
+
+protected:
+  template <typename OutIter>
+  void output_distances(vertex_iterator_t<G>    source,
+                        vertex_dist_cont const& distances,
+                        vector<bool> const&     leaf,
+                        OutIter                 result_iter,
+                        bool const              leaves_only) {
+    // output distances to the output iterator
+    //using path                 = shortest_distance<vertex_iterator_t<G>, DistanceT>;
+    using key_t                = vertex_key_t<G>;
+    vertex_iterator_t<G> first = begin(vertices(g_));
+    for (key_t vkey = 0; vkey < static_cast<key_t>(distances.size()); ++vkey) {
+      if (!leaves_only || (leaves_only && leaf[vkey])) {
+        auto& [prev_key, dist] = distances[vkey];
+        *result_iter           = {source, first + vkey, dist};
+      }
+    }
+  }
+
+  template <typename OutIter>
+  void output_paths(vertex_iterator_t<G>    source,
+                    vertex_dist_cont const& distances,
+                    vector<bool> const&     leaf,
+                    OutIter                 result_iter,
+                    bool const              leaves_only) {
     // output paths to the output iterator
     using path_t = shortest_path<vertex_iterator_t<G>, DistanceT>;
     using key_t  = vertex_key_t<G>;
@@ -355,19 +761,86 @@ public:
         spath.path.clear();
       }
     }
-    return false;
   }
 
-protected:
-  bool find_paths(vertex_iterator_t<G> source,
+  bool find_paths(vertex_iterator_t<G>    source,
+                  vertex_dist_cont&       distances,
+                  vector<bool>&           leaf,
+                  bool const              leaves_only,
+                  bool const              detect_neg_edge_cycles,
+                  bellman_ford_mode const mode) {
+    vertex_key_t<G> const source_key = static_cast<vertex_key_t<G>>(source - begin(g_));
+    distances[source_key]            = {source_key, 0};
+
+    // find the shortest paths
+    if (mode == bellman_ford_mode::worklist)
+      relax_worklist(source_key, distances);
+    else
+      relax_edge_scan(distances);
+
+    identify_leaves(distances, leaf, leaves_only);
+    return detect_neg_edge_cycles && has_neg_edge_cycle(distances);
+  }
+
+  //! Parallel rounds. Each round reads the distances from the previous round and the edge
+  //! scan is partitioned across threads, using an atomic min to update the new distances.
+  //! A second pass over the edges assigns the previous vertex for the distances that changed,
+  //! because the vertex & distance can't be updated together atomically.
+  template <typename ExecutionPolicy>
+  bool find_paths(ExecutionPolicy&&    policy,
+                  vertex_iterator_t<G> source,
                   vertex_dist_cont&    distances,
                   vector<bool>&        leaf,
                   bool const           leaves_only,
                   bool const           detect_neg_edge_cycles) {
-    vertex_key_t<G> const source_key = static_cast<vertex_key_t<G>>(source - begin(g_));
+    using key_t                      = vertex_key_t<G>;
+    using edge_index_t               = ranges::range_difference_t<edge_range_t<G>>;
+    key_t const        source_key    = static_cast<key_t>(source - begin(g_));
+    edge_iterator_t<G> first_edge    = ranges::begin(edges(g_));
+    edge_index_t const edge_cnt      = static_cast<edge_index_t>(ranges::size(edges(g_)));
+    key_t const        unreached_key = numeric_limits<key_t>::max();
     distances[source_key]            = {source_key, 0};
 
-    // find the shortest paths
+    using dist_alloc = typename allocator_traits<A>::template rebind_alloc<DistanceT>;
+    vector<DistanceT, dist_alloc> prev_dist(ranges::size(g_), numeric_limits<DistanceT>::max(), alloc_);
+    vector<DistanceT, dist_alloc> next_dist(ranges::size(g_), numeric_limits<DistanceT>::max(), alloc_);
+    prev_dist[source_key] = next_dist[source_key] = 0;
+
+    bool changed = true; // allows exiting early once results are stable
+    for (size_t i = 1; changed && i < ranges::size(g_); ++i) {
+      atomic<bool> round_changed = false;
+      detail::for_each_index(policy, edge_index_t(0), edge_cnt, [&](edge_index_t const uv_idx) {
+        edge_iterator_t<G> uv   = first_edge + uv_idx;
+        key_t const        ukey = source_vertex_key(g_, uv);
+        if (prev_dist[ukey] == numeric_limits<DistanceT>::max())
+          return; // ukey not connected to source [yet]
+        if (detail::atomic_min(next_dist[target_vertex_key(g_, uv)], prev_dist[ukey] + distance_fnc_(*uv)))
+          round_changed.store(true, memory_order_relaxed);
+      });
+
+      if ((changed = round_changed.load())) {
+        detail::for_each_index(policy, edge_index_t(0), edge_cnt, [&](edge_index_t const uv_idx) {
+          edge_iterator_t<G> uv   = first_edge + uv_idx;
+          key_t const        ukey = source_vertex_key(g_, uv);
+          key_t const        vkey = target_vertex_key(g_, uv);
+          if (next_dist[vkey] < prev_dist[vkey] && prev_dist[ukey] != numeric_limits<DistanceT>::max() &&
+              prev_dist[ukey] + distance_fnc_(*uv) == next_dist[vkey])
+            detail::atomic_store(distances[vkey].vtx_key, ukey); // any edge giving the new distance
+        });
+        prev_dist = next_dist;
+      }
+    }
+
+    for (key_t vkey = 0; vkey < static_cast<key_t>(distances.size()); ++vkey)
+      if (distances[vkey].vtx_key != unreached_key)
+        distances[vkey].distance = prev_dist[vkey];
+
+    identify_leaves(distances, leaf, leaves_only);
+    return detect_neg_edge_cycles && has_neg_edge_cycle(distances);
+  }
+
+  //! Relax all edges in the graph on each iteration, up to |V|-1 times.
+  void relax_edge_scan(vertex_dist_cont& distances) {
     bool changed = true; // allows exiting early once results are stable
     for (size_t i = 1; changed && i < ranges::size(g_); ++i) {
       changed = false;
@@ -385,7 +858,47 @@ protected:
         }
       }
     }
+  }
+
+  //! Relax the edges of the vertices whose distance changed on the previous iteration, up to
+  //! |V|-1 times. The vertices to visit on the next iteration are kept in a worklist with a
+  //! flag to avoid duplicates. Only edges where u is the source_vertex are relaxed so the
+  //! results match the edge scan for undirected graphs.
+  void relax_worklist(vertex_key_t<G> const source_key, vertex_dist_cont& distances) {
+    using key_t       = vertex_key_t<G>;
+    using key_alloc   = typename allocator_traits<A>::template rebind_alloc<key_t>;
+    using worklist_t  = vector<key_t, key_alloc>;
+    using in_work_t   = vector<bool, typename allocator_traits<A>::template rebind_alloc<bool>>;
+    worklist_t curr(alloc_), next(alloc_);
+    in_work_t  in_next(ranges::size(g_), alloc_);
+
+    curr.push_back(source_key);
+    for (size_t i = 1; !curr.empty() && i < ranges::size(g_); ++i) {
+      for (key_t ukey : curr) {
+        vertex_edge_range_t<G> edges_rng = edges(g_, find_vertex(g_, ukey));
+        for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+          if (source_vertex_key(g_, uv) != ukey)
+            continue; // incoming edge of an undirected graph
+
+          key_t     vkey   = target_vertex_key(g_, uv);
+          DistanceT v_dist = distances[ukey].distance + distance_fnc_(*uv);
+          if (v_dist < distances[vkey].distance) {
+            distances[vkey] = {ukey, v_dist};
+            if (!in_next[vkey]) {
+              in_next[vkey] = true;
+              next.push_back(vkey);
+            }
+          }
+        }
+      }
+      for (key_t vkey : next)
+        in_next[vkey] = false;
+      curr.swap(next);
+      next.clear();
+    }
+  }
 
+  void identify_leaves(vertex_dist_cont const& distances, vector<bool>& leaf, bool const leaves_only) {
     // Identify the leaves, if needed
     if (leaves_only) {
       // identify all vertices that are reachable by source
@@ -403,24 +916,20 @@ protected:
             leaf[source_vertex_key(g_, uv)] = false;
       }
     }
+  }
 
-    // Detect negative edge cycles, if desired
-    bool neg_edge_cycles = false;
-    if (detect_neg_edge_cycles) {
-      for (edge_iterator_t<G> uv = begin(edges(g_)); uv != end(edges(g_)); ++uv) {
-        vertex_key_t<G> ukey = source_vertex_key(g_, uv);
-        if (distances[ukey].vtx_key == numeric_limits<vertex_key_t<G>>::max())
-          continue; // ukey not connected to source
+  // Detect negative edge cycles
+  bool has_neg_edge_cycle(vertex_dist_cont const& distances) {
+    for (edge_iterator_t<G> uv = begin(edges(g_)); uv != end(edges(g_)); ++uv) {
+      vertex_key_t<G> ukey = source_vertex_key(g_, uv);
+      if (distances[ukey].vtx_key == numeric_limits<vertex_key_t<G>>::max())
+        continue; // ukey not connected to source
 
-        vertex_key_t<G> vkey = target_vertex_key(g_, uv);
-        if (distances[ukey].distance + distance_fnc_(*uv) < distances[vkey].distance) {
-          neg_edge_cycles = true;
-          break;
-        }
-      }
+      vertex_key_t<G> vkey = target_vertex_key(g_, uv);
+      if (distances[ukey].distance + distance_fnc_(*uv) < distances[vkey].distance)
+        return true;
     }
-
-    return neg_edge_cycles;
+    return false;
   }
 
 protected:
@@ -461,7 +970,7 @@ void dijkstra_shortest_distances(
       OutIter              result_iter,
       bool const           leaves_only  = true,
       DistFnc              distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
-      A                    alloc        = A())
+      A                                                alloc        = A())
 // clang-format on
 {
   using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
@@ -501,7 +1010,7 @@ void dijkstra_shortest_paths(
       bool const           leaves_only  = true,
       DistFnc              distance_fnc = [](edge_value_t<G>&) -> size_t
                                                { return 1; },
-      A                    alloc        = A())
+      A                                                alloc        = A())
 // clang-format on
 {
   using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
@@ -510,6 +1019,179 @@ void dijkstra_shortest_paths(
 }
 
 
+//! Find the shortest distances to the vertices within a distance, or to the nearest vertices, of
+//! the source vertex (e.g. an isochrone). The search stops as soon as the next vertex is beyond
+//! either bound, and only the vertices settled within the bounds are written.
+//!
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to, in order of increasing
+//!                    distance. The iterator must accept a type of
+//!                    shortest_distance<vertex_iterator_t<G>, DistanceT>.
+//! @param max_distance
+//!                    Vertices with a distance greater than this aren't visited.
+//! @param max_vertices
+//!                    The maximum number of vertices to write, including the source.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        DistFnc,
+          typename        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void dijkstra_bounded_shortest_distances(
+      G&                                               g,
+      vertex_iterator_t<G>                             source,
+      OutIter                                          result_iter,
+      invoke_result_t<DistFnc, edge_value_t<G>&> const max_distance,
+      size_t const                                     max_vertices = numeric_limits<size_t>::max(),
+      DistFnc                                          distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                                                alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  using fn_t       = dijkstra_fn<G, DistFnc, distance_t, A>;
+  fn_t                      fn(g, distance_fnc, alloc);
+  typename fn_t::workspace_t ws(ranges::size(g), alloc);
+  fn.bounded_shortest_distances(ws, source, result_iter, max_distance, max_vertices);
+}
+
+
+//! Find the shortest distances to the vertices within a distance, or to the nearest vertices, of
+//! the source vertex, reusing a workspace across searches. Only the vertices touched by the
+//! previous search are reset, so the cost of repeated queries is proportional to their output.
+//!
+//! @param ws          The workspace, sized for the number of vertices in g. It holds the
+//!                    distances and predecessors of the search when the function returns.
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to, in order of increasing
+//!                    distance. The iterator must accept a type of
+//!                    shortest_distance<vertex_iterator_t<G>, DistanceT>.
+//! @param max_distance
+//!                    Vertices with a distance greater than this aren't visited.
+//! @param max_vertices
+//!                    The maximum number of vertices to write, including the source.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        DistFnc,
+          typename        A>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void dijkstra_bounded_shortest_distances(
+      dijkstra_workspace<vertex_key_t<G>, invoke_result_t<DistFnc, edge_value_t<G>&>, A>& ws,
+      G&                                               g,
+      vertex_iterator_t<G>                             source,
+      OutIter                                          result_iter,
+      invoke_result_t<DistFnc, edge_value_t<G>&> const max_distance,
+      size_t const                                     max_vertices = numeric_limits<size_t>::max(),
+      DistFnc                                          distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; })
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  dijkstra_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, ws.get_allocator());
+  fn.bounded_shortest_distances(ws, source, result_iter, max_distance, max_vertices);
+}
+
+
+//! Find the shortest paths to the vertices within a distance, or to the nearest vertices, of
+//! the source vertex. The search stops as soon as the next vertex is beyond either bound, and
+//! only the paths to vertices settled within the bounds are written.
+//!
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to, in order of increasing
+//!                    distance. The iterator must accept a type of
+//!                    shortest_path<vertex_iterator_t<G>, DistanceT>.
+//! @param max_distance
+//!                    Vertices with a distance greater than this aren't visited.
+//! @param max_vertices
+//!                    The maximum number of paths to write, including the one to the source.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//! @param alloc       The allocator to use for internal containers.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        DistFnc,
+          typename        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void dijkstra_bounded_shortest_paths(
+      G&                                               g,
+      vertex_iterator_t<G>                             source,
+      OutIter                                          result_iter,
+      invoke_result_t<DistFnc, edge_value_t<G>&> const max_distance,
+      size_t const                                     max_vertices = numeric_limits<size_t>::max(),
+      DistFnc                                          distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                                                alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  using fn_t       = dijkstra_fn<G, DistFnc, distance_t, A>;
+  fn_t                      fn(g, distance_fnc, alloc);
+  typename fn_t::workspace_t ws(ranges::size(g), alloc);
+  fn.bounded_shortest_paths(ws, source, result_iter, max_distance, max_vertices);
+}
+
+
+//! Find the shortest paths to the vertices within a distance, or to the nearest vertices, of the
+//! source vertex, reusing a workspace across searches.
+//!
+//! @param ws          The workspace, sized for the number of vertices in g. It holds the
+//!                    distances and predecessors of the search when the function returns.
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to, in order of increasing
+//!                    distance. The iterator must accept a type of
+//!                    shortest_path<vertex_iterator_t<G>, DistanceT>.
+//! @param max_distance
+//!                    Vertices with a distance greater than this aren't visited.
+//! @param max_vertices
+//!                    The maximum number of paths to write, including the one to the source.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//
+// clang-format off
+template <incidence_graph G,
+          typename        OutIter,
+          typename        DistFnc,
+          typename        A>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+void dijkstra_bounded_shortest_paths(
+      dijkstra_workspace<vertex_key_t<G>, invoke_result_t<DistFnc, edge_value_t<G>&>, A>& ws,
+      G&                                               g,
+      vertex_iterator_t<G>                             source,
+      OutIter                                          result_iter,
+      invoke_result_t<DistFnc, edge_value_t<G>&> const max_distance,
+      size_t const                                     max_vertices = numeric_limits<size_t>::max(),
+      DistFnc                                          distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; })
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  dijkstra_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, ws.get_allocator());
+  fn.bounded_shortest_paths(ws, source, result_iter, max_distance, max_vertices);
+}
+
+
 //! Find the shortest distances to vertices reachable from the source vertex.
 //!
 //! @param g           The graph
@@ -550,7 +1232,7 @@ bool bellman_ford_shortest_distances(
       bool const           leaves_only            = true,
       bool const           detect_neg_edge_cycles = true,
       DistFnc              distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
-      A                    alloc        = A())
+      A                                                alloc        = A())
 // clang-format on
 {
 
@@ -599,7 +1281,7 @@ bool bellman_ford_shortest_paths(
       bool const           leaves_only            = true,
       bool const           detect_neg_edge_cycles = true,
       DistFnc              distance_fnc           = [](edge_value_t<G>&) -> size_t { return 1; },
-      A                    alloc                  = A())
+      A                                                alloc                  = A())
 // clang-format on
 {
   //static_assert(is_same<invoke_result<DistFnc(edge_value_t<G>&)>, DistanceT>::value);
@@ -608,6 +1290,215 @@ bool bellman_ford_shortest_paths(
   return fn.shortest_paths(source, result_iter, leaves_only, detect_neg_edge_cycles);
 }
 
+
+//! Find the shortest distances to vertices reachable from the source vertex, relaxing the edges
+//! of all vertices in parallel on each iteration.
+//!
+//! @param policy      The execution policy used to relax the edges on each iteration.
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to. The iterator
+//!                    must accept a type of shortest_distance<vertex_iterator_t<G>, DistanceT>.
+//!                    Nothing will be output to this if detect_neg_edge_cycles is true and
+//!                    a negative edge cycle exists.
+//! @param leaves_only When false, all vertices are written to the output iterator.
+//!                    When true, only vertices that are the end of a path are written
+//!                    to the output iterator with an additional cost of O(|V|+|E|).
+//! @param detect_neg_edge_cycles
+//!                    Detects if a negateve edge cycle exists. When true, an additional O(|E|)
+//!                    pass is made and true/false is returned to identify if a negateve edge
+//!                    cycle exists.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            true if a negateve edge cycle exists, which is only detected if
+//!                    detect_neg_edge_cycles is true.
+//
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G, 
+          typename        OutIter, 
+          typename        DistFnc, 
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> && 
+           ranges::random_access_range<edge_range_t<G>> && 
+           integral<vertex_key_t<G>> && 
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>> &&
+           output_iterator<OutIter,
+                  shortest_distance<ranges::iterator_t<vertex_range_t<G>>,
+                       invoke_result_t<DistFnc, edge_value_t<G>&>>>
+bool bellman_ford_shortest_distances(
+      ExecutionPolicy&&    policy,
+      G&                   g,
+      vertex_iterator_t<G> source,
+      OutIter              result_iter,
+      bool const           leaves_only            = true,
+      bool const           detect_neg_edge_cycles = true,
+      DistFnc              distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                                                alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  bellman_ford_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  return fn.shortest_distances(policy, source, result_iter, leaves_only, detect_neg_edge_cycles);
+}
+
+
+//! Find the shortest paths to vertices reachable from the source vertex, relaxing the edges
+//! of all vertices in parallel on each iteration.
+//!
+//! @param policy      The execution policy used to relax the edges on each iteration.
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to. The iterator
+//!                    must accept a type of shortest_path<vertex_iterator_t<G>, DistanceT>.
+//!                    Nothing will be output to this if detect_neg_edge_cycles is true and
+//!                    a negative edge cycle exists.
+//! @param leaves_only When false, the shortest path is written to the output iterator for each
+//!                    vertex reachable from source.
+//!                    When true, only paths to final vertices at the end of a path are written
+//!                    to the output iterator with an additional cost of O(|V|+|E|).
+//! @param detect_neg_edge_cycles
+//!                    Detects if a negateve edge cycle exists. When true, an additional O(|E|)
+//!                    pass is made and true/false is returned to identify if a negateve edge
+//!                    cycle exists.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            true if a negateve edge cycle exists, which is only detected if
+//!                    detect_neg_edge_cycles is true.
+//!
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G, 
+          typename        OutIter, 
+          typename        DistFnc, 
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> && 
+           ranges::random_access_range<edge_range_t<G>> && 
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+bool bellman_ford_shortest_paths(
+      ExecutionPolicy&&    policy,
+      G&                   g,
+      vertex_iterator_t<G> source,
+      OutIter              result_iter,
+      bool const           leaves_only            = true,
+      bool const           detect_neg_edge_cycles = true,
+      DistFnc              distance_fnc           = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                                                alloc                  = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  bellman_ford_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  return fn.shortest_paths(policy, source, result_iter, leaves_only, detect_neg_edge_cycles);
+}
+
+
+//! Find the shortest distances to vertices reachable from the source vertex using the
+//! Shortest Path Faster Algorithm (SPFA), a worklist variant of Bellman-Ford that only relaxes
+//! the edges of vertices whose distance changed on the previous iteration.
+//!
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to. The iterator
+//!                    must accept a type of shortest_distance<vertex_iterator_t<G>, DistanceT>.
+//!                    Nothing will be output to this if detect_neg_edge_cycles is true and
+//!                    a negative edge cycle exists.
+//! @param leaves_only When false, all vertices are written to the output iterator.
+//!                    When true, only vertices that are the end of a path are written
+//!                    to the output iterator with an additional cost of O(|V|+|E|).
+//! @param detect_neg_edge_cycles
+//!                    Detects if a negateve edge cycle exists. When true, an additional O(|E|)
+//!                    pass is made and true/false is returned to identify if a negateve edge
+//!                    cycle exists.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            true if a negateve edge cycle exists, which is only detected if
+//!                    detect_neg_edge_cycles is true.
+//
+// clang-format off
+template <incidence_graph G, 
+          typename        OutIter, 
+          typename        DistFnc, 
+          typename        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && 
+           integral<vertex_key_t<G>> && 
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>> &&
+           output_iterator<OutIter,
+                  shortest_distance<ranges::iterator_t<vertex_range_t<G>>,
+                       invoke_result_t<DistFnc, edge_value_t<G>&>>>
+bool spfa_shortest_distances(
+      G&                   g,
+      vertex_iterator_t<G> source,
+      OutIter              result_iter,
+      bool const           leaves_only            = true,
+      bool const           detect_neg_edge_cycles = true,
+      DistFnc              distance_fnc = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                                                alloc        = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  bellman_ford_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  return fn.shortest_distances(source, result_iter, leaves_only, detect_neg_edge_cycles,
+                               bellman_ford_mode::worklist);
+}
+
+
+//! Find the shortest paths to vertices reachable from the source vertex using the
+//! Shortest Path Faster Algorithm (SPFA), a worklist variant of Bellman-Ford that only relaxes
+//! the edges of vertices whose distance changed on the previous iteration.
+//!
+//! @param g           The graph
+//! @param source      The single source vertex to start the search.
+//! @param result_iter The output iterator that results are written to. The iterator
+//!                    must accept a type of shortest_path<vertex_iterator_t<G>, DistanceT>.
+//!                    Nothing will be output to this if detect_neg_edge_cycles is true and
+//!                    a negative edge cycle exists.
+//! @param leaves_only When false, the shortest path is written to the output iterator for each
+//!                    vertex reachable from source.
+//!                    When true, only paths to final vertices at the end of a path are written
+//!                    to the output iterator with an additional cost of O(|V|+|E|).
+//! @param detect_neg_edge_cycles
+//!                    Detects if a negateve edge cycle exists. When true, an additional O(|E|)
+//!                    pass is made and true/false is returned to identify if a negateve edge
+//!                    cycle exists.
+//! @param distance_fnc
+//!                    The weight function object used to determine the distance between
+//!                    vertices on an edge. The default is to return a value of 1.
+//! @param alloc       The allocator to use for internal containers.
+//! @return            true if a negateve edge cycle exists, which is only detected if
+//!                    detect_neg_edge_cycles is true.
+//!
+// clang-format off
+template <incidence_graph G, 
+          typename        OutIter, 
+          typename        DistFnc, 
+          typename        A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && 
+           integral<vertex_key_t<G>> &&
+           is_arithmetic_v<invoke_result_t<DistFnc, edge_value_t<G>&>>
+bool spfa_shortest_paths(
+      G&                   g,
+      vertex_iterator_t<G> source,
+      OutIter              result_iter,
+      bool const           leaves_only            = true,
+      bool const           detect_neg_edge_cycles = true,
+      DistFnc              distance_fnc           = [](edge_value_t<G>&) -> size_t { return 1; },
+      A                                                alloc                  = A())
+// clang-format on
+{
+  using distance_t = decltype(distance_fnc(*ranges::begin(edges(g, begin(g)))));
+  bellman_ford_fn<G, DistFnc, distance_t, A> fn(g, distance_fnc, alloc);
+  return fn.shortest_paths(source, result_iter, leaves_only, detect_neg_edge_cycles, bellman_ford_mode::worklist);
+}
+
 #  endif // CPO
 
 } // namespace std::graph
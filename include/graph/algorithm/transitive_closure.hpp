@@ -4,10 +4,17 @@
 // Algorithms:
 //  dfs_transitive_closure
 //  warshall_transitive_closure
+//  condensed_transitive_closure
 //
 
 #include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "components.hpp"
 #include "../range/depth_first_search.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #ifndef GRAPH_TRANSITIVE_CLOSURE_HPP
@@ -49,26 +56,150 @@ constexpr void dfs_transitive_closure(G& g, OutIter result_iter, A alloc = A())
   }
 }
 
+//! Internal implementation of Warshall's algorithm on rows of bits.
+//!
+//! Row u holds a bit for each vertex reachable from u, packed into words. On round k every row u
+//! that reaches k is or'ed with row k, which is a loop over contiguous words that the compiler is
+//! able to vectorize. The rounds are processed in blocks of rows sized to fit in the L2 cache: the
+//! rows in the block are updated through the block first, then every other row is updated through
+//! the whole block while the block's rows stay in the cache. Using a block row that already
+//! includes later rounds of the same block only adds paths that exist, so the result is the same.
+//! Rows outside the block only read the block's rows, so they're updated in parallel by the
+//! ExecutionPolicy overload.
+//!
+template <incidence_graph G, typename A = allocator<bool>>
+class warshall_fn {
+public:
+  using graph_t = G;
+  using key_t   = vertex_key_t<G>;
+  using word_t  = uint64_t;
+
+  static constexpr size_t word_bits = numeric_limits<word_t>::digits;
+  static constexpr size_t l2_bytes  = 256 * 1024;
+
+  warshall_fn(graph_t& g, A alloc)
+        : g_(g)
+        , n_(ranges::size(g))
+        , words_((n_ + word_bits - 1) / word_bits)
+        , block_(clamp(l2_bytes / max(words_ * sizeof(word_t), size_t(1)), size_t(1), size_t(256)))
+        , reach_(n_ * words_, word_t(0), alloc) {}
+
+  void closure() {
+    init();
+    for (size_t kb = 0; kb < n_; kb += block_) {
+      size_t const ke = min(n_, kb + block_);
+      update_block(kb, ke);
+      update_rows(0, kb, kb, ke);
+      update_rows(ke, n_, kb, ke);
+    }
+  }
+
+  template <typename ExecutionPolicy>
+  void closure(ExecutionPolicy&& policy) {
+    init();
+    for (size_t kb = 0; kb < n_; kb += block_) {
+      size_t const ke = min(n_, kb + block_);
+      update_block(kb, ke);
+      detail::for_each_index(policy, size_t(0), n_, [this, kb, ke](size_t const u) {
+        if (u < kb || u >= ke)
+          update_rows(u, u + 1, kb, ke);
+      });
+    }
+  }
+
+  template <typename OutIter>
+  void output(OutIter result_iter) {
+    for (size_t u = 0; u < n_; ++u) {
+      word_t const* urow = row(u);
+      for (size_t w = 0; w < words_; ++w)
+        for (word_t bits = urow[w]; bits != 0; bits &= bits - 1) {
+          size_t const v = w * word_bits + static_cast<size_t>(countr_zero(bits));
+          *result_iter   = {begin(g_) + static_cast<ptrdiff_t>(u), begin(g_) + static_cast<ptrdiff_t>(v)};
+          ++result_iter;
+        }
+    }
+  }
+
+protected:
+  word_t* row(size_t const u) { return reach_.data() + u * words_; }
+  bool    test(size_t const u, size_t const k) { return (row(u)[k / word_bits] >> (k % word_bits)) & 1; }
+
+  void init() {
+    for (vertex_iterator_t<G> u = begin(g_); u != end(g_); ++u) {
+      key_t const            ukey      = vertex_key(g_, u);
+      word_t*                urow      = row(static_cast<size_t>(ukey));
+      vertex_edge_range_t<G> edges_rng = edges(g_, u);
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        size_t const v = static_cast<size_t>(vertex_key(g_, uv, ukey));
+        urow[v / word_bits] |= word_t(1) << (v % word_bits);
+      }
+    }
+  }
+
+  //! Or row k into row u if u reaches k.
+  void update_row(size_t const u, size_t const k) {
+    if (k == u || !test(u, k))
+      return;
+    word_t*       urow = row(u);
+    word_t const* krow = row(k);
+    for (size_t w = 0; w < words_; ++w)
+      urow[w] |= krow[w];
+  }
+
+  //! Update the rows in block [kb, ke) through the rounds of the block.
+  void update_block(size_t const kb, size_t const ke) {
+    for (size_t k = kb; k < ke; ++k)
+      for (size_t u = kb; u < ke; ++u)
+        update_row(u, k);
+  }
+
+  //! Update rows [u_beg, u_end), which aren't in block [kb, ke), through the rounds of the block.
+  void update_rows(size_t const u_beg, size_t const u_end, size_t const kb, size_t const ke) {
+    for (size_t u = u_beg; u < u_end; ++u)
+      for (size_t k = kb; k < ke; ++k)
+        update_row(u, k);
+  }
+
+private:
+  using word_alloc  = typename allocator_traits<A>::template rebind_alloc<word_t>;
+  using word_vector = vector<word_t, word_alloc>;
+
+  graph_t&    g_;
+  size_t      n_;
+  size_t      words_; // words in a row
+  size_t      block_; // rows in a block
+  word_vector reach_; // row-major |V| x words_ bits
+};
+
+
+/// Transitive closure returns all vertices that can be reached from a source vertex, for all source
+/// vertices. This algorithm specializes on a dense graph using Warshall's algorithm on rows of bits,
+/// with the rows updated in parallel. Complexity is O(n^3/w), where w is the number of bits in a word.
+///
 // clang-format off
 template <typename        ExecutionPolicy, 
           incidence_graph G, 
           typename        OutIter, 
           typename        A = allocator<bool>>
-  requires directed<G> && 
+  requires execution_policy<ExecutionPolicy> &&
+           directed<G> && 
            ranges::random_access_range<vertex_range_t<G>> && 
            integral<vertex_key_t<G>> && 
            output_iterator<OutIter, reaches<G>>
 constexpr void warshall_transitive_closure(ExecutionPolicy&& policy, 
                                            G&                g, 
                                            OutIter           result_iter, 
-                                           A                 alloc = A());
+                                           A                 alloc = A())
 // clang-format on
+{
+  warshall_fn<G, A> fn(g, alloc);
+  fn.closure(policy);
+  fn.output(result_iter);
+}
 
 /// Transitive closure returns all vertices that can be reached from a source vertex, for all source
-/// vertices. This algorithm specializes on a dense graph using Warshall's algorithm.
-/// Complexity is O(n^3).
-//
-/// ToDo: Implement parallel option
+/// vertices. This algorithm specializes on a dense graph using Warshall's algorithm on rows of bits.
+/// Complexity is O(n^3/w), where w is the number of bits in a word.
 ///
 // clang-format off
 template <incidence_graph G, typename OutIter, typename A = allocator<bool>>
@@ -79,31 +210,192 @@ template <incidence_graph G, typename OutIter, typename A = allocator<bool>>
 constexpr void warshall_transitive_closure(G& g, OutIter result_iter, A alloc = A())
 // clang-format on
 {
-  size_t const V = ranges::size(g);
+  warshall_fn<G, A> fn(g, alloc);
+  fn.closure();
+  fn.output(result_iter);
+}
+
+//! A compact transitive closure of a directed graph, for sparse graphs.
+//!
+//! The strongly connected components are condensed first, since every vertex in a component
+//! reaches the same vertices. Each component has a row of bits for the components it reaches.
+//! Components are numbered in reverse topological order, so a component only reaches components
+//! with a smaller number and row c only needs bits 0..c, halving the space. Rows are built in
+//! increasing component order by or'ing in the rows of each successor, which are already complete.
+//! The ExecutionPolicy constructor groups the components by their height in the condensation
+//! (the longest path to a sink) and builds the rows of each height in parallel.
+//!
+//! Space is O(|V| + |E| + C^2/2) bits for C components, and a query is O(1).
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires directed<G>
+class condensed_closure
+// clang-format on
+{
+public:
+  using graph_type        = G;
+  using allocator_type    = A;
+  using key_type          = vertex_key_t<G>;
+  using condensation_type = condensation<G, A>;
+  using word_t            = uint64_t;
 
-  vector<bool> reach(V * V, alloc);
-  for (vertex_iterator_t<G> ui = begin(g); ui != end(g); ++ui) {
-    size_t uoff = vertex_key(g, ui) * V;
-    for (vertex_edge_iterator_t<G> uv = ranges::begin(edges(g, ui)); uv != ranges::end(edges(g, ui)); ++uv)
-      reach[uoff + vertex_key(g, uv, ui)] = true;
+  static constexpr size_t word_bits = numeric_limits<word_t>::digits;
+
+  condensed_closure(graph_type& g, allocator_type alloc = A())
+        : cond_(g, alloc), row_offsets_(alloc), bits_(alloc) {
+    init();
+    for (key_type comp = 0; comp < static_cast<key_type>(cond_.components()); ++comp)
+      build_row(comp);
   }
 
-  for (vertex_key_t<G> k = 0; k < V; ++k) {
-    size_t koff = k * V;
-    for (vertex_key_t<G> ukey = 0; ukey < V; ++ukey) {
-      size_t uoff = ukey * V;
-      for (vertex_key_t<G> vkey = 0; vkey < V; ++vkey) {
-        reach[uoff + vkey] = reach[uoff + vkey] || (reach[uoff + k] && reach[koff + vkey]);
-      }
+  // clang-format off
+  template <typename ExecutionPolicy>
+    requires execution_policy<ExecutionPolicy>
+  condensed_closure(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+  // clang-format on
+        : cond_(g, alloc), row_offsets_(alloc), bits_(alloc) {
+    init();
+    size_t const ncomp = cond_.components();
+
+    // height[c] = 1 + the largest height of c's successors; successors have smaller numbers
+    offset_vector height(ncomp, 0, alloc);
+    size_t        heights = 0;
+    for (key_type comp = 0; comp < static_cast<key_type>(ncomp); ++comp) {
+      for (key_type const succ : cond_.successors(comp))
+        height[comp] = max(height[comp], height[succ] + 1);
+      heights = max(heights, height[comp] + 1);
     }
+
+    // the components of each height, which only reach components of lower heights
+    offset_vector height_offsets(heights + 1, 0, alloc);
+    for (size_t const h : height)
+      ++height_offsets[h + 1];
+    inclusive_scan(height_offsets.begin(), height_offsets.end(), height_offsets.begin());
+    key_vector    by_height(ncomp, alloc);
+    offset_vector next(height_offsets.begin(), height_offsets.end() - 1, alloc);
+    for (key_type comp = 0; comp < static_cast<key_type>(ncomp); ++comp)
+      by_height[next[height[comp]]++] = comp;
+
+    for (size_t h = 0; h < heights; ++h)
+      detail::for_each_index(policy, height_offsets[h], height_offsets[h + 1],
+                             [this, &by_height](size_t const i) { build_row(by_height[i]); });
   }
 
-  for (vertex_key_t<G> ukey = 0; ukey < V; ++ukey) {
-    size_t uoff = ukey * V;
-    for (vertex_key_t<G> vkey = 0; vkey < V; ++vkey)
-      if (reach[uoff + vkey])
-        *result_iter = {begin(g) + ukey, begin(g) + vkey};
+  //! The number of vertices
+  size_t size() const noexcept { return cond_.size(); }
+  //! The strongly connected components the closure is built on.
+  condensation_type const& components() const noexcept { return cond_; }
+
+  //! True if there's a path of one or more edges from ukey to vkey. A vertex only reaches itself
+  //! if it's on a cycle.
+  bool reaches(key_type const ukey, key_type const vkey) const noexcept {
+    size_t const ucomp = cond_.component(ukey), vcomp = cond_.component(vkey);
+    return vcomp <= ucomp && test(ucomp, vcomp);
+  }
+
+  //! Call fnc(vkey) for each vertex reachable from ukey with a path of one or more edges.
+  template <typename F>
+  void for_each_reached(key_type const ukey, F&& fnc) const {
+    size_t const  ucomp = cond_.component(ukey);
+    word_t const* urow  = row(ucomp);
+    for (size_t w = 0; w < words(ucomp); ++w)
+      for (word_t bits = urow[w]; bits != 0; bits &= bits - 1)
+        for (key_type const vkey : cond_.members(static_cast<key_type>(w * word_bits + countr_zero(bits))))
+          fnc(vkey);
   }
+
+protected:
+  using key_vector    = typename condensation_type::key_vector;
+  using offset_vector = typename condensation_type::offset_vector;
+  using word_vector   = vector<word_t, typename allocator_traits<A>::template rebind_alloc<word_t>>;
+
+  //! Words in the row of comp, for bits 0..comp.
+  static constexpr size_t words(size_t const comp) noexcept { return comp / word_bits + 1; }
+
+  word_t*       row(size_t const comp) noexcept { return bits_.data() + row_offsets_[comp]; }
+  word_t const* row(size_t const comp) const noexcept { return bits_.data() + row_offsets_[comp]; }
+  bool          test(size_t const ucomp, size_t const vcomp) const noexcept {
+    return (row(ucomp)[vcomp / word_bits] >> (vcomp % word_bits)) & 1;
+  }
+
+  void init() {
+    size_t const ncomp = cond_.components();
+    row_offsets_.resize(ncomp + 1);
+    row_offsets_[0] = 0;
+    for (size_t comp = 0; comp < ncomp; ++comp)
+      row_offsets_[comp + 1] = row_offsets_[comp] + words(comp);
+    bits_.assign(row_offsets_[ncomp], word_t(0));
+  }
+
+  //! Build the row of comp from the rows of its successors, which must already be built.
+  void build_row(key_type const comp) {
+    word_t* crow = row(comp);
+    if (cond_.is_cyclic(comp))
+      crow[comp / word_bits] |= word_t(1) << (comp % word_bits);
+    // larger successors are more likely to reach smaller ones, which can then be skipped
+    for (key_type const succ : cond_.successors(comp) | views::reverse) {
+      if (test(comp, succ))
+        continue; // already reached through another successor, with everything succ reaches
+      word_t const* srow = row(succ);
+      for (size_t w = 0; w < words(succ); ++w)
+        crow[w] |= srow[w];
+      crow[succ / word_bits] |= word_t(1) << (succ % word_bits);
+    }
+  }
+
+private:
+  condensation_type cond_;
+  offset_vector     row_offsets_; // row c is bits_[row_offsets_[c]..row_offsets_[c+1])
+  word_vector       bits_;
+};
+
+
+/// Transitive closure returns all vertices that can be reached from a source vertex, for all source
+/// vertices. This algorithm specializes on a sparse graph, condensing the strongly connected
+/// components first so each component is only traversed once (see condensed_closure).
+/// A vertex only reaches itself if it's on a cycle. Results are in order of the source vertex.
+///
+// clang-format off
+template <incidence_graph G, typename OutIter, typename A = allocator<char>>
+  requires directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           output_iterator<OutIter, reaches<G>>
+void condensed_transitive_closure(G& g, OutIter result_iter, A alloc = A())
+// clang-format on
+{
+  condensed_closure<G, A> closure(g, alloc);
+  for (vertex_key_t<G> ukey = 0; ukey < static_cast<vertex_key_t<G>>(closure.size()); ++ukey)
+    closure.for_each_reached(ukey, [&g, &result_iter, ukey](vertex_key_t<G> const vkey) {
+      *result_iter = reaches<G>{begin(g) + ukey, begin(g) + vkey};
+      ++result_iter;
+    });
+}
+
+/// Transitive closure returns all vertices that can be reached from a source vertex, for all source
+/// vertices, building the condensed closure in parallel. Results are written serially, in order of
+/// the source vertex.
+///
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G,
+          typename        OutIter,
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           output_iterator<OutIter, reaches<G>>
+void condensed_transitive_closure(ExecutionPolicy&& policy, G& g, OutIter result_iter, A alloc = A())
+// clang-format on
+{
+  condensed_closure<G, A> closure(policy, g, alloc);
+  for (vertex_key_t<G> ukey = 0; ukey < static_cast<vertex_key_t<G>>(closure.size()); ++ukey)
+    closure.for_each_reached(ukey, [&g, &result_iter, ukey](vertex_key_t<G> const vkey) {
+      *result_iter = reaches<G>{begin(g) + ukey, begin(g) + vkey};
+      ++result_iter;
+    });
 }
 
 #  endif // CPO
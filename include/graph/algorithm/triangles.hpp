@@ -0,0 +1,315 @@
+//
+// Triangle counting and local clustering coefficients.
+//
+// Triangles are counted in the underlying undirected graph: the direction of edges is ignored, and
+// self-loops and parallel edges don't add triangles. The distinct neighbors of each vertex are
+// copied into a compressed array (detail::neighbor_lists), and then each edge is oriented from the
+// endpoint with the lower degree to the one with the higher degree (breaking ties by key). Every
+// triangle u,v,w has exactly one vertex u with edges to both others, and it's found once by
+// intersecting the oriented neighbors of u with those of each of its oriented neighbors v. The
+// orientation bounds the oriented degree of every vertex by O(sqrt(|E|)), so the count is
+// O(|E| sqrt(|E|)) even with high-degree hubs, compared with O(d^2) edge lookups per vertex.
+//
+// The oriented neighbor lists are sorted by key, so the intersection is a merge of two sorted
+// ranges. When one list is much shorter than the other, the elements of the shorter are found in
+// the longer by binary search instead. The vertices are processed in parallel by the
+// ExecutionPolicy overloads, with atomic increments of the counts of the other two vertices of
+// each triangle.
+//
+// The local clustering coefficient of a vertex with d > 1 neighbors and t triangles is
+// 2t / (d (d - 1)), the fraction of pairs of its neighbors that are connected.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <numeric>
+#include <vector>
+#include "../graph.hpp"
+#include "../detail/parallel_utility.hpp"
+#include "../detail/neighbor_lists.hpp"
+
+#ifndef GRAPH_TRIANGLES_HPP
+#  define GRAPH_TRIANGLES_HPP
+
+namespace std::graph {
+
+#  ifdef CPO
+
+//! Internal implementation of triangle counting, holding the degree-ordered orientation of the
+//! graph. It's built when it's constructed, so the triangles can be counted many times.
+//!
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class triangle_count_fn
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  triangle_count_fn(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+        : n_(static_cast<key_type>(ranges::size(g)))
+        , degree_(n_, 0, alloc)
+        , out_offsets_(static_cast<size_t>(n_) + 1, 0, alloc)
+        , out_keys_(alloc) {
+    detail::neighbor_lists<G, A> neighbors(policy, g, alloc);
+    detail::for_each_index(policy, key_type(0), n_,
+                           [this, &neighbors](key_type const ukey) { degree_[ukey] = neighbors.degree(ukey); });
+
+    // orient each edge toward the endpoint with the higher degree
+    detail::for_each_index(policy, key_type(0), n_, [this, &neighbors](key_type const ukey) {
+      size_t count = 0;
+      for (key_type const vkey : neighbors[ukey])
+        count += is_oriented(ukey, vkey);
+      out_offsets_[ukey + 1] = count;
+    });
+    inclusive_scan(policy, out_offsets_.begin() + 1, out_offsets_.end(), out_offsets_.begin() + 1);
+
+    out_keys_.resize(out_offsets_[n_]);
+    detail::for_each_index(policy, key_type(0), n_, [this, &neighbors](key_type const ukey) {
+      size_t j = out_offsets_[ukey];
+      for (key_type const vkey : neighbors[ukey])
+        if (is_oriented(ukey, vkey))
+          out_keys_[j++] = vkey;
+    });
+  }
+
+  //! The number of distinct neighbors of ukey, ignoring direction & self-loops.
+  size_t degree(key_type const ukey) const noexcept { return degree_[ukey]; }
+
+  //! The number of triangles in the graph.
+  template <typename ExecutionPolicy>
+  size_t operator()(ExecutionPolicy&& policy) const {
+    return transform_reduce(policy, detail::index_iterator<key_type>(0), detail::index_iterator<key_type>(n_),
+                            size_t(0), plus<size_t>(), [this](key_type const ukey) {
+                              size_t count = 0;
+                              for_each_triangle(ukey, [&count](key_type, key_type) { ++count; });
+                              return count;
+                            });
+  }
+
+  //! The number of triangles in the graph, assigning the number of triangles that each vertex is in
+  //! to count_iter[ukey].
+  template <typename ExecutionPolicy, random_access_iterator CountIter>
+  size_t operator()(ExecutionPolicy&& policy, CountIter count_iter) const {
+    size_vector counts(n_, 0, out_keys_.get_allocator());
+    size_t const total = transform_reduce(
+          policy, detail::index_iterator<key_type>(0), detail::index_iterator<key_type>(n_), size_t(0), plus<size_t>(),
+          [this, &counts](key_type const ukey) {
+            size_t count = 0;
+            for_each_triangle(ukey, [&counts, &count](key_type const vkey, key_type const wkey) {
+              ++count;
+              atomic_ref<size_t>(counts[vkey]).fetch_add(1, memory_order_relaxed);
+              atomic_ref<size_t>(counts[wkey]).fetch_add(1, memory_order_relaxed);
+            });
+            atomic_ref<size_t>(counts[ukey]).fetch_add(count, memory_order_relaxed);
+            return count;
+          });
+    detail::for_each_index(policy, key_type(0), n_, [&counts, &count_iter](key_type const ukey) {
+      count_iter[static_cast<iter_difference_t<CountIter>>(ukey)] = static_cast<iter_value_t<CountIter>>(counts[ukey]);
+    });
+    return total;
+  }
+
+protected:
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+
+  //! True if the edge between ukey & vkey is oriented from ukey to vkey.
+  bool is_oriented(key_type const ukey, key_type const vkey) const noexcept {
+    return degree_[ukey] < degree_[vkey] || (degree_[ukey] == degree_[vkey] && ukey < vkey);
+  }
+
+  //! Call fnc(vkey, wkey) for each triangle ukey,vkey,wkey where ukey has oriented edges to both.
+  template <typename Fnc>
+  void for_each_triangle(key_type const ukey, Fnc&& fnc) const {
+    key_type const* ufirst = out_keys_.data() + out_offsets_[ukey];
+    key_type const* ulast  = out_keys_.data() + out_offsets_[ukey + 1];
+    for (key_type const* uv = ufirst; uv != ulast; ++uv) {
+      key_type const vkey = *uv;
+      intersect(ufirst, ulast, out_keys_.data() + out_offsets_[vkey], out_keys_.data() + out_offsets_[vkey + 1],
+                [&fnc, vkey](key_type const wkey) { fnc(vkey, wkey); });
+    }
+  }
+
+  //! Call fnc(wkey) for each key in both of the sorted ranges.
+  template <typename Fnc>
+  static void
+  intersect(key_type const* afirst, key_type const* alast, key_type const* bfirst, key_type const* blast, Fnc&& fnc) {
+    if (alast - afirst > blast - bfirst) {
+      swap(afirst, bfirst);
+      swap(alast, blast);
+    }
+    if ((alast - afirst) * 16 < blast - bfirst) {
+      for (; afirst != alast && bfirst != blast; ++afirst) {
+        bfirst = lower_bound(bfirst, blast, *afirst);
+        if (bfirst != blast && *bfirst == *afirst)
+          fnc(*afirst);
+      }
+      return;
+    }
+    while (afirst != alast && bfirst != blast) {
+      if (*afirst < *bfirst)
+        ++afirst;
+      else if (*bfirst < *afirst)
+        ++bfirst;
+      else {
+        fnc(*afirst);
+        ++afirst;
+        ++bfirst;
+      }
+    }
+  }
+
+private:
+  key_type    n_;
+  key_vector  degree_;      // distinct neighbors, ignoring direction
+  size_vector out_offsets_; // out_keys_[out_offsets_[u]..out_offsets_[u+1]) are the oriented neighbors of u
+  key_vector  out_keys_;    // sorted by key
+};
+
+
+//! Count the triangles of a graph in parallel, ignoring the direction of edges.
+//!
+//! Complexity is O(|E| sqrt(|E|)).
+//!
+//! @param policy The execution policy used.
+//! @param g      The graph
+//! @param alloc  The allocator to use for internal containers.
+//! @return       The number of triangles.
+//
+// clang-format off
+template <typename        ExecutionPolicy,
+          incidence_graph G,
+          typename        A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>>
+size_t triangle_count(ExecutionPolicy&& policy, G& g, A alloc = A())
+// clang-format on
+{
+  triangle_count_fn<G, A> fn(policy, g, alloc);
+  return fn(policy);
+}
+
+//! Count the triangles of a graph, ignoring the direction of edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+size_t triangle_count(G& g, A alloc = A())
+// clang-format on
+{
+  return triangle_count(execution::seq, g, alloc);
+}
+
+//! Count the triangles that each vertex of a graph is in, in parallel, ignoring the direction of
+//! edges.
+//!
+//! @param policy     The execution policy used.
+//! @param g          The graph
+//! @param count_iter The beginning of a random-access range of size(g) values, where
+//!                   count_iter[ukey] is assigned the number of triangles ukey is in.
+//! @param alloc      The allocator to use for internal containers.
+//! @return           The number of triangles in the graph.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CountIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CountIter>>
+size_t vertex_triangle_count(ExecutionPolicy&& policy, G& g, CountIter count_iter, A alloc = A())
+// clang-format on
+{
+  triangle_count_fn<G, A> fn(policy, g, alloc);
+  return fn(policy, count_iter);
+}
+
+//! Count the triangles that each vertex of a graph is in, ignoring the direction of edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CountIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           integral<iter_value_t<CountIter>>
+size_t vertex_triangle_count(G& g, CountIter count_iter, A alloc = A())
+// clang-format on
+{
+  return vertex_triangle_count(execution::seq, g, count_iter, alloc);
+}
+
+//! Compute the local clustering coefficient of each vertex of a graph in parallel, ignoring the
+//! direction of edges.
+//!
+//! @param policy     The execution policy used.
+//! @param g          The graph
+//! @param coeff_iter The beginning of a random-access range of size(g) floating-point values, where
+//!                   coeff_iter[ukey] is assigned the fraction of pairs of neighbors of ukey that
+//!                   are connected, or 0 if ukey has fewer than 2 neighbors.
+//! @param alloc      The allocator to use for internal containers.
+//! @return           The number of triangles in the graph.
+//
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator CoeffIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           floating_point<iter_value_t<CoeffIter>>
+size_t clustering_coefficient(ExecutionPolicy&& policy, G& g, CoeffIter coeff_iter, A alloc = A())
+// clang-format on
+{
+  using key_t   = vertex_key_t<G>;
+  using coeff_t = iter_value_t<CoeffIter>;
+  triangle_count_fn<G, A> fn(policy, g, alloc);
+
+  vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>> counts(ranges::size(g), alloc);
+  size_t const total = fn(policy, counts.begin());
+  key_t const n = static_cast<key_t>(ranges::size(g));
+  detail::for_each_index(policy, key_t(0), n, [&fn, &counts, &coeff_iter](key_t const ukey) {
+    coeff_t const d     = static_cast<coeff_t>(fn.degree(ukey));
+    coeff_t const coeff = (d < 2) ? coeff_t(0) : coeff_t(2) * static_cast<coeff_t>(counts[ukey]) / (d * (d - 1));
+    coeff_iter[static_cast<iter_difference_t<CoeffIter>>(ukey)] = coeff;
+  });
+  return total;
+}
+
+//! Compute the local clustering coefficient of each vertex of a graph, ignoring the direction of
+//! edges.
+//!
+//! See the ExecutionPolicy overload for the parameters.
+//
+// clang-format off
+template <incidence_graph        G,
+          random_access_iterator CoeffIter,
+          typename               A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           floating_point<iter_value_t<CoeffIter>>
+size_t clustering_coefficient(G& g, CoeffIter coeff_iter, A alloc = A())
+// clang-format on
+{
+  return clustering_coefficient(execution::seq, g, coeff_iter, alloc);
+}
+
+#  endif // CPO
+
+} // namespace std::graph
+
+#endif //GRAPH_TRIANGLES_HPP
@@ -0,0 +1,101 @@
+//
+// The distinct neighbors of each vertex of a graph, ignoring the direction of edges, for the
+// algorithms that are defined on the underlying simple undirected graph (triangles, cores).
+//
+// The neighbors are copied into a compressed array in parallel: each edge u->v adds v to the
+// neighbors of u and u to the neighbors of v, self-loops are skipped, and then the neighbors of
+// each vertex are sorted and duplicates removed. The space reserved for the duplicates isn't
+// reclaimed, so the neighbors of u are neighbors_[offsets_[u]..offsets_[u]+degree_[u]).
+//
+
+#include <algorithm>
+#include <atomic>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <vector>
+#include "../graph.hpp"
+#include "parallel_utility.hpp"
+
+#ifndef GRAPH_NEIGHBOR_LISTS_HPP
+#  define GRAPH_NEIGHBOR_LISTS_HPP
+
+namespace std::graph::detail {
+
+#  ifdef CPO
+
+// clang-format off
+template <incidence_graph G, typename A = allocator<char>>
+  requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
+class neighbor_lists
+// clang-format on
+{
+public:
+  using graph_type     = G;
+  using allocator_type = A;
+  using key_type       = vertex_key_t<G>;
+
+  template <typename ExecutionPolicy>
+  neighbor_lists(ExecutionPolicy&& policy, graph_type& g, allocator_type alloc = A())
+        : n_(static_cast<key_type>(ranges::size(g)))
+        , offsets_(static_cast<size_t>(n_) + 1, 0, alloc)
+        , degree_(n_, 0, alloc)
+        , neighbors_(alloc) {
+    for_each_index(policy, key_type(0), n_, [this, &g](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(g, uv, ukey);
+        if (vkey != ukey) {
+          atomic_ref<size_t>(offsets_[ukey + 1]).fetch_add(1, memory_order_relaxed);
+          atomic_ref<size_t>(offsets_[vkey + 1]).fetch_add(1, memory_order_relaxed);
+        }
+      }
+    });
+    inclusive_scan(policy, offsets_.begin() + 1, offsets_.end(), offsets_.begin() + 1);
+
+    neighbors_.resize(offsets_[n_]);
+    size_vector next(offsets_.begin(), offsets_.end() - 1, alloc);
+    for_each_index(policy, key_type(0), n_, [this, &g, &next](key_type const ukey) {
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_type const vkey = vertex_key(g, uv, ukey);
+        if (vkey != ukey) {
+          neighbors_[atomic_ref<size_t>(next[ukey]).fetch_add(1, memory_order_relaxed)] = vkey;
+          neighbors_[atomic_ref<size_t>(next[vkey]).fetch_add(1, memory_order_relaxed)] = ukey;
+        }
+      }
+    });
+    for_each_index(policy, key_type(0), n_, [this](key_type const ukey) {
+      auto first = neighbors_.begin() + static_cast<ptrdiff_t>(offsets_[ukey]);
+      auto last  = neighbors_.begin() + static_cast<ptrdiff_t>(offsets_[ukey + 1]);
+      sort(first, last);
+      degree_[ukey] = static_cast<key_type>(unique(first, last) - first);
+    });
+  }
+
+  //! The number of vertices
+  key_type size() const noexcept { return n_; }
+
+  //! The number of distinct neighbors of ukey.
+  key_type degree(key_type const ukey) const noexcept { return degree_[ukey]; }
+
+  //! The distinct neighbors of ukey, in increasing order.
+  span<key_type const> operator[](key_type const ukey) const noexcept {
+    return span<key_type const>(neighbors_.data() + offsets_[ukey], degree_[ukey]);
+  }
+
+private:
+  using key_vector  = vector<key_type, typename allocator_traits<A>::template rebind_alloc<key_type>>;
+  using size_vector = vector<size_t, typename allocator_traits<A>::template rebind_alloc<size_t>>;
+
+  key_type    n_;
+  size_vector offsets_;
+  key_vector  degree_;
+  key_vector  neighbors_;
+};
+
+#  endif // CPO
+
+} // namespace std::graph::detail
+
+#endif // GRAPH_NEIGHBOR_LISTS_HPP
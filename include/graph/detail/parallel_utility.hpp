@@ -0,0 +1,241 @@
+//
+// Helpers shared by the algorithms that have an ExecutionPolicy overload.
+//
+// The standard parallel algorithms require forward (or better) iterators, so index_iterator is
+// used to run for_each over a range of vertex or edge keys. It reports random_access_iterator_tag
+// so implementations are able to partition the range across threads.
+//
+// atomic_min & atomic_max update a shared value in-place using atomic_ref, allowing the values
+// to be kept in ordinary vectors and only be treated as atomic while a parallel region is active.
+//
+// workspace_pool hands out per-task scratch objects (e.g. distance arrays sized to the graph) for
+// the body of a parallel loop, so only as many are created as there are tasks running at once.
+// They may also hold per-task accumulators, which are combined with for_each after the loop.
+// When the body is cheap, for_each_block runs the loop over blocks of indexes so a lease is taken
+// once per block rather than once per index.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef GRAPH_PARALLEL_UTILITY_HPP
+#  define GRAPH_PARALLEL_UTILITY_HPP
+
+namespace std::graph {
+
+// clang-format off
+template <typename ExecutionPolicy>
+concept execution_policy = is_execution_policy_v<remove_cvref_t<ExecutionPolicy>>;
+// clang-format on
+
+namespace detail {
+
+  //! A random-access iterator over consecutive integral values [first, last).
+  template <integral T>
+  class index_iterator {
+  public:
+    using iterator_category = random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = ptrdiff_t;
+    using pointer           = const T*;
+    using reference         = T;
+
+    constexpr index_iterator() noexcept = default;
+    constexpr explicit index_iterator(T i) noexcept : i_(i) {}
+
+    constexpr reference operator*() const noexcept { return i_; }
+    constexpr reference operator[](difference_type n) const noexcept { return static_cast<T>(i_ + n); }
+
+    constexpr index_iterator& operator++() noexcept {
+      ++i_;
+      return *this;
+    }
+    constexpr index_iterator operator++(int) noexcept {
+      index_iterator tmp(*this);
+      ++i_;
+      return tmp;
+    }
+    constexpr index_iterator& operator--() noexcept {
+      --i_;
+      return *this;
+    }
+    constexpr index_iterator operator--(int) noexcept {
+      index_iterator tmp(*this);
+      --i_;
+      return tmp;
+    }
+
+    constexpr index_iterator& operator+=(difference_type n) noexcept {
+      i_ = static_cast<T>(i_ + n);
+      return *this;
+    }
+    constexpr index_iterator& operator-=(difference_type n) noexcept {
+      i_ = static_cast<T>(i_ - n);
+      return *this;
+    }
+
+    friend constexpr index_iterator operator+(index_iterator it, difference_type n) noexcept { return it += n; }
+    friend constexpr index_iterator operator+(difference_type n, index_iterator it) noexcept { return it += n; }
+    friend constexpr index_iterator operator-(index_iterator it, difference_type n) noexcept { return it -= n; }
+    friend constexpr difference_type operator-(index_iterator lhs, index_iterator rhs) noexcept {
+      return static_cast<difference_type>(lhs.i_) - static_cast<difference_type>(rhs.i_);
+    }
+
+    friend constexpr bool operator==(index_iterator lhs, index_iterator rhs) noexcept { return lhs.i_ == rhs.i_; }
+    friend constexpr auto operator<=>(index_iterator lhs, index_iterator rhs) noexcept { return lhs.i_ <=> rhs.i_; }
+
+  private:
+    T i_ = T();
+  };
+
+  //! Call fnc(i) for each i in [first, last) using the execution policy.
+  template <execution_policy ExecutionPolicy, integral T, typename F>
+  void for_each_index(ExecutionPolicy&& policy, T first, T last, F&& fnc) {
+    std::for_each(forward<ExecutionPolicy>(policy), index_iterator<T>(first), index_iterator<T>(last), forward<F>(fnc));
+  }
+
+  //! Call fnc(block_first, block_last) for consecutive blocks of [first, last) using the execution
+  //! policy, so that per-task state (e.g. a workspace_pool lease) is taken once per block instead
+  //! of once per index. There are a few blocks per hardware thread to balance the load, and one
+  //! block for the sequenced policy.
+  template <execution_policy ExecutionPolicy, integral T, typename F>
+  void for_each_block(ExecutionPolicy&& policy, T first, T last, F&& fnc) {
+    if (!(first < last))
+      return;
+    size_t const n      = static_cast<size_t>(last - first);
+    size_t       blocks = 1;
+    if constexpr (!is_same_v<remove_cvref_t<ExecutionPolicy>, execution::sequenced_policy>)
+      blocks = min(n, static_cast<size_t>(max(thread::hardware_concurrency(), 1u)) * 8);
+    for_each_index(policy, size_t(0), blocks, [first, n, blocks, &fnc](size_t const b) {
+      fnc(static_cast<T>(first + n * b / blocks), static_cast<T>(first + n * (b + 1) / blocks));
+    });
+  }
+
+  //! Atomically assign value to target if it's less than target.
+  //! @return true if target was updated.
+  // clang-format off
+  template <typename T>
+    requires is_arithmetic_v<T>
+  bool atomic_min(T& target, T const value) noexcept
+  // clang-format on
+  {
+    atomic_ref<T> ref(target);
+    T             cur = ref.load(memory_order_relaxed);
+    while (value < cur)
+      if (ref.compare_exchange_weak(cur, value, memory_order_relaxed))
+        return true;
+    return false;
+  }
+
+  //! Atomically assign value to target if it's greater than target.
+  //! @return true if target was updated.
+  // clang-format off
+  template <typename T>
+    requires is_arithmetic_v<T>
+  bool atomic_max(T& target, T const value) noexcept
+  // clang-format on
+  {
+    atomic_ref<T> ref(target);
+    T             cur = ref.load(memory_order_relaxed);
+    while (value > cur)
+      if (ref.compare_exchange_weak(cur, value, memory_order_relaxed))
+        return true;
+    return false;
+  }
+
+  template <typename T>
+  T atomic_load(T& target) noexcept {
+    return atomic_ref<T>(target).load(memory_order_relaxed);
+  }
+
+  template <typename T>
+  void atomic_store(T& target, T const value) noexcept {
+    atomic_ref<T>(target).store(value, memory_order_relaxed);
+  }
+
+  //! Atomically assign desired to target if it's equal to expected.
+  //! @return true if target was updated.
+  template <typename T>
+  bool atomic_compare_exchange(T& target, T expected, T const desired) noexcept {
+    return atomic_ref<T>(target).compare_exchange_strong(expected, desired, memory_order_relaxed);
+  }
+
+  //! Mix the bits of h (the finalizer of MurmurHash3). It's a bijection, so it gives a fixed
+  //! pseudo-random order of keys for breaking ties without a shared random number generator.
+  constexpr uint64_t mix_bits(uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    return h ^ (h >> 33);
+  }
+
+  //! A pool of scratch objects created on demand by make_fnc. acquire() returns a lease that
+  //! gives exclusive use of an object until the lease is destroyed, when it's returned to the pool
+  //! for reuse by a later task. Objects are expected to be reset by the user before the lease ends.
+  template <typename T, typename MakeFnc>
+  class workspace_pool {
+  public:
+    class lease {
+    public:
+      lease(workspace_pool& pool, unique_ptr<T>&& obj) : pool_(pool), obj_(move(obj)) {}
+      lease(lease const&) = delete;
+      lease& operator=(lease const&) = delete;
+      ~lease() { pool_.release(move(obj_)); }
+
+      T& operator*() const noexcept { return *obj_; }
+      T* operator->() const noexcept { return obj_.get(); }
+
+    private:
+      workspace_pool& pool_;
+      unique_ptr<T>   obj_;
+    };
+
+    explicit workspace_pool(MakeFnc make_fnc) : make_fnc_(move(make_fnc)) {}
+
+    lease acquire() {
+      {
+        lock_guard<mutex> lock(mutex_);
+        if (!free_.empty()) {
+          unique_ptr<T> obj = move(free_.back());
+          free_.pop_back();
+          return lease(*this, move(obj));
+        }
+      }
+      return lease(*this, make_unique<T>(make_fnc_()));
+    }
+
+    //! Call fnc(obj) for each object created by the pool, e.g. to combine per-task results. It
+    //! must not be called while a lease is held.
+    template <typename F>
+    void for_each(F&& fnc) {
+      lock_guard<mutex> lock(mutex_);
+      for (unique_ptr<T>& obj : free_)
+        fnc(*obj);
+    }
+
+  private:
+    void release(unique_ptr<T>&& obj) {
+      lock_guard<mutex> lock(mutex_);
+      free_.push_back(move(obj));
+    }
+
+  private:
+    MakeFnc               make_fnc_;
+    mutex                 mutex_;
+    vector<unique_ptr<T>> free_;
+  };
+
+} // namespace detail
+} // namespace std::graph
+
+#endif // GRAPH_PARALLEL_UTILITY_HPP
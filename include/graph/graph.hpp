@@ -2,7 +2,9 @@
 #include <ranges>
 #include <type_traits>
 #include <optional>
-#include "graph_access.hpp"
+#ifndef CPO
+#  include "graph_access.hpp"
+#endif
 
 /* 
     This header's organization
@@ -100,6 +102,12 @@ using vertex_inward_vertex_range_t = decltype(inward_vertices(declval<G&&>(), de
 template <typename G>
 using vertex_inward_vertex_iterator_t = ranges::iterator_t<vertex_inward_vertex_range_t<G>>;
 
+// Const iterator types
+template <typename G>
+using const_vertex_iterator_t = vertex_iterator_t<const G>;
+template <typename G>
+using const_vertex_edge_iterator_t = vertex_edge_iterator_t<const G>;
+
 // Value types
 template <typename G>
 using graph_value_t = decltype(graph_value(declval<G&&>()));
@@ -111,12 +119,12 @@ using vertex_key_t = decltype(vertex_key(declval<G&&>(), declval<vertex_iterator
 template <typename G>
 using vertex_value_t = decltype(vertex_value(declval<G&&>(), declval<vertex_iterator_t<G>>()));
 
-template <typename G, typename ER>
+template <typename G, typename ER = vertex_edge_range_t<G>>
 using edge_t = typename ranges::range_value_t<ER>;
 template <typename G, typename EI>
 using edge_key_t = decltype(edge_key(declval<G&&>(), declval<EI>())); // e.g. pair<vertex_key_t<G>,vertex_key_t<G>>
-template <typename G, typename EI>
-using edge_value_t = decltype(edge_value(declval<G&&>(), declval<EI>()));
+template <typename G, typename EI = vertex_edge_iterator_t<G>>
+using edge_value_t = remove_reference_t<decltype(edge_value(declval<G&&>(), declval<EI>()))>;
 
 
 // overridable per graph to direct algorithm
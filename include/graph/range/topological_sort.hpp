@@ -1,10 +1,30 @@
 //
 //	Author: J. Phillip Ratzloff
 //
+// topological sort of the vertices of a directed graph, using Kahn's algorithm.
+//
+// Each vertex has a count of its incoming edges from vertices that haven't been visited. Vertices
+// with a count of 0 are ready to be visited; visiting a vertex decrements the count of each vertex
+// it has an edge to, and a vertex becomes ready when its count reaches 0.
+//
+// topological_sort_vertex_range visits the vertices lazily as it's iterated, in the same way as
+// breadth_first_search_vertex_range: the state of the traversal is in the range object and begin()
+// returns the current state. When the graph has a cycle, the vertices on the cycle and the
+// vertices reachable from it never become ready, so iteration ends early after all other vertices
+// are visited in a valid order. has_cycle() is true after iteration if this happened.
+//
+// topological_sort_levels groups the vertices by level, where level 0 has the vertices without
+// incoming edges and level i+1 has the vertices whose incoming edges are all from levels 0..i.
+// The vertices of a level have no edges between them, so they can be processed concurrently. The
+// levels are found in parallel: the vertices of each level are expanded concurrently, decrementing
+// the counts with atomic operations.
 //
 
 #include "../graph.hpp"
-#include <stack>
+#include "../detail/parallel_utility.hpp"
+#include <algorithm>
+#include <atomic>
+#include <queue>
 #include <vector>
 
 #ifndef GRAPH_TOPO_SORT_HPP
@@ -13,27 +33,240 @@
 namespace std::graph {
 
 #  ifdef CPO
+
+//----------------------------------------------------------------------------------------
+/// topological sort range for vertices, using Kahn's algorithm.
+///
+/// Vertices that are ready at the same time are visited in the order they became ready, starting
+/// with the vertices without incoming edges in key order.
+///
 // clang-format off
 template <incidence_graph G, typename A = allocator<char>>
   requires ranges::random_access_range<vertex_range_t<G>> && integral<vertex_key_t<G>>
 class topological_sort_vertex_range
 // clang-format on
 {
-  using count_t   = vertex_key_t<G>;
-  using visited_t = vector<count_t>;
+  using count_t     = vertex_key_t<G>;
+  using count_alloc = typename allocator_traits<A>::template rebind_alloc<count_t>;
+  using visited_t   = vector<count_t, count_alloc>;
 
-public:
-  topological_sort_vertex_range() = default;
-  topological_sort_vertex_range();
+  using queue_elem  = vertex_iterator_t<G>;
+  using queue_alloc = typename allocator_traits<A>::template rebind_alloc<queue_elem>;
+  using queue_type  = queue<queue_elem, deque<queue_elem, queue_alloc>>;
 
 public:
+  topological_sort_vertex_range(G& graph, A alloc = A())
+        : graph_(graph), visit_count_(ranges::size(graph), count_t(0), alloc), queue_(alloc), alloc_(alloc) {
+    for (vertex_iterator_t<G> u = ranges::begin(vertices(graph_)); u != ranges::end(vertices(graph_)); ++u) {
+      vertex_edge_iterator_t<G> uv_end = ranges::end(edges(graph_, u));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges(graph_, u)); uv != uv_end; ++uv)
+        ++visit_count_[vertex_key(graph_, vertex(graph_, uv, u))];
+    }
+    for (vertex_iterator_t<G> u = ranges::begin(vertices(graph_)); u != ranges::end(vertices(graph_)); ++u)
+      if (visit_count_[vertex_key(graph_, u)] == 0)
+        queue_.push(u);
+  }
+
+  class const_iterator {
+  public:
+    using iterator_category = input_iterator_tag;
+    using value_type        = vertex_t<G>;
+    using pointer           = const_vertex_iterator_t<G>;
+    using reference         = const value_type&;
+    using difference_type   = typename iterator_traits<const_vertex_iterator_t<G>>::difference_type;
+
+    const_iterator()                      = default;
+    const_iterator(const_iterator&&)      = default;
+    const_iterator(const const_iterator&) = default;
+    const_iterator(topological_sort_vertex_range& topo, bool end_iter = false)
+          : topo_(&topo), u_(ranges::end(vertices(topo.graph_))) {
+      if (!end_iter && !topo.queue_.empty())
+        u_ = topo.queue_.front();
+    }
+
+    const_iterator& operator=(const_iterator&&) = default;
+    const_iterator& operator=(const const_iterator&) = default;
+
+    reference operator*() const { return *u_; }
+    pointer   operator->() const { return u_; }
+
+    const_iterator& operator++() {
+      u_ = topo_->advance();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& rhs) const { return u_ == rhs.u_; }
+    bool operator!=(const const_iterator& rhs) const { return !operator==(rhs); }
+
+  protected:
+    topological_sort_vertex_range* topo_ = nullptr; // always non-null & valid; ptr allows default ctor
+    vertex_iterator_t<G>           u_;
+  };
+
+  class iterator : public const_iterator {
+  public:
+    using iterator_category = input_iterator_tag;
+    using value_type        = vertex_t<G>;
+    using pointer           = vertex_iterator_t<G>;
+    using reference         = value_type&;
+    using difference_type   = typename iterator_traits<vertex_iterator_t<G>>::difference_type;
+
+    iterator() = default;
+    iterator(const_iterator&& iter) : const_iterator(move(iter)) {}
+    iterator(const const_iterator& iter) : const_iterator(iter) {}
+    iterator(topological_sort_vertex_range& topo, bool end_iter = false) : const_iterator(topo, end_iter) {}
+
+    iterator& operator=(iterator&& rhs) {
+      const_iterator::operator=(move(rhs));
+      return *this;
+    }
+    iterator& operator=(const iterator& rhs) {
+      const_iterator::operator=(rhs);
+      return *this;
+    }
+
+    reference operator*() { return *this->u_; }
+    pointer   operator->() const { return this->u_; }
+
+    iterator& operator++() {
+      this->u_ = this->topo_->advance();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+  };
+
 public:
-public:
+  iterator       begin() { return iterator(*this); }
+  const_iterator begin() const { return const_iterator(*this); }
+  const_iterator cbegin() const { return const_iterator(*this); }
+
+  iterator       end() { return const_iterator(*this, true); }
+  const_iterator end() const { return const_iterator(*this, true); }
+  const_iterator cend() const { return const_iterator(*this, true); }
+
+  /// The number of vertices visited so far.
+  size_t visited() const { return visited_; }
+
+  /// True if iteration has ended without visiting every vertex, because the remaining vertices are
+  /// on a cycle or reachable from one. The vertices that were visited are in a valid order.
+  bool has_cycle() const { return queue_.empty() && visited_ < ranges::size(graph_); }
+
+protected:
+  vertex_iterator_t<G> advance() {
+    if (!queue_.empty()) {
+      vertex_iterator_t<G> u = queue_.front();
+      queue_.pop();
+      ++visited_;
+
+      vertex_edge_iterator_t<G> uv_end = ranges::end(edges(graph_, u));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges(graph_, u)); uv != uv_end; ++uv) {
+        vertex_iterator_t<G> v = vertex(graph_, uv, u);
+        if (--visit_count_[vertex_key(graph_, v)] == 0)
+          queue_.push(v);
+      }
+      if (!queue_.empty())
+        return queue_.front();
+    }
+    return ranges::end(vertices(graph_));
+  }
+
 private:
-  visited_t visit_count_;
-  G&        graph_;
+  G&         graph_;
+  visited_t  visit_count_; // incoming edges from vertices that haven't been visited
+  queue_type queue_;       // vertices that are ready; the front is the current vertex
+  size_t     visited_ = 0;
+  A          alloc_;
 };
 
+
+//----------------------------------------------------------------------------------------
+/// Topologically sort the vertices of a graph in parallel, grouped by level.
+///
+/// @param policy      The execution policy used.
+/// @param g           The graph
+/// @param order_iter  The beginning of a random-access range of size(g) values that the keys of the
+///                    sorted vertices are written to, grouped by level. The vertices of each level
+///                    are in key order.
+/// @param level_iter  The output iterator that the end offset in order_iter of each level is
+///                    written to. Level i is order_iter[level_iter[i-1]..level_iter[i]), where the
+///                    first level begins at 0.
+/// @param alloc       The allocator to use for internal containers.
+/// @return            The number of vertices sorted. If it's less than size(g) the graph has a
+///                    cycle; the vertices that are on a cycle or reachable from one aren't written,
+///                    and the levels of the other vertices are still valid.
+///
+// clang-format off
+template <typename               ExecutionPolicy,
+          incidence_graph        G,
+          random_access_iterator OrderIter,
+          typename               LevelIter,
+          typename               A = allocator<char>>
+  requires execution_policy<ExecutionPolicy> &&
+           directed<G> &&
+           ranges::random_access_range<vertex_range_t<G>> &&
+           integral<vertex_key_t<G>> &&
+           output_iterator<LevelIter, size_t>
+size_t topological_sort_levels(ExecutionPolicy&& policy,
+                               G&                g,
+                               OrderIter         order_iter,
+                               LevelIter         level_iter,
+                               A                 alloc = A())
+// clang-format on
+{
+  using key_t      = vertex_key_t<G>;
+  using key_vector = vector<key_t, typename allocator_traits<A>::template rebind_alloc<key_t>>;
+
+  key_t const n = static_cast<key_t>(ranges::size(g));
+  key_vector  count(n, key_t(0), alloc); // incoming edges from vertices that haven't been sorted
+  key_vector  order(n, alloc);
+
+  detail::for_each_index(policy, key_t(0), n, [&g, &count](key_t const ukey) {
+    vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+    for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv)
+      atomic_ref<key_t>(count[vertex_key(g, uv, ukey)]).fetch_add(1, memory_order_relaxed);
+  });
+
+  size_t tail = 0; // end of the sorted vertices, including the level being added
+  detail::for_each_index(policy, key_t(0), n, [&count, &order, &tail](key_t const ukey) {
+    if (count[ukey] == 0)
+      order[atomic_ref<size_t>(tail).fetch_add(1, memory_order_relaxed)] = ukey;
+  });
+
+  for (size_t level_beg = 0; level_beg < tail;) {
+    size_t const level_end = tail;
+    sort(policy, order.begin() + static_cast<ptrdiff_t>(level_beg), order.begin() + static_cast<ptrdiff_t>(level_end));
+    *level_iter = level_end;
+    ++level_iter;
+
+    detail::for_each_index(policy, level_beg, level_end, [&g, &count, &order, &tail](size_t const i) {
+      key_t const            ukey      = order[i];
+      vertex_edge_range_t<G> edges_rng = edges(g, find_vertex(g, ukey));
+      for (vertex_edge_iterator_t<G> uv = ranges::begin(edges_rng); uv != ranges::end(edges_rng); ++uv) {
+        key_t const vkey = vertex_key(g, uv, ukey);
+        if (atomic_ref<key_t>(count[vkey]).fetch_sub(1, memory_order_relaxed) == 1)
+          order[atomic_ref<size_t>(tail).fetch_add(1, memory_order_relaxed)] = vkey;
+      }
+    });
+    level_beg = level_end;
+  }
+
+  detail::for_each_index(policy, size_t(0), tail, [&order, &order_iter](size_t const i) {
+    order_iter[static_cast<iter_difference_t<OrderIter>>(i)] = static_cast<iter_value_t<OrderIter>>(order[i]);
+  });
+  return tail;
+}
+
 #  endif // CPO
 
 } // namespace std::graph
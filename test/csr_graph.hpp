@@ -0,0 +1,263 @@
+#pragma once
+#include "graph/graph.hpp"
+#include "graph/graph_utility.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//
+// A compressed sparse row graph that implements the free functions used by the algorithms, independent of the
+// directed_adjacency_vector & undirected_adjacency_list API. The vertex keys are the indexes of the vertices.
+//
+// A directed graph stores the outward edges of each vertex contiguously, ordered by source key. An undirected graph
+// stores each edge once and has an incidence list of edge indexes for each vertex, so the edge is visited from both
+// of its vertices (a self-loop is visited once).
+//
+namespace csr {
+
+using key_type = uint32_t;
+
+template <typename VV>
+struct csr_vertex : public VV {
+  key_type first = 0; // [first,last) of the outward edges (directed) or incidences (undirected)
+  key_type last  = 0;
+
+  csr_vertex() = default;
+  csr_vertex(VV const& val) : VV(val) {}
+};
+
+template <typename EV>
+struct csr_edge : public EV {
+  key_type source_key = 0;
+  key_type target_key = 0;
+
+  csr_edge() = default;
+  csr_edge(key_type ukey, key_type vkey, EV const& val) : EV(val), source_key(ukey), target_key(vkey) {}
+};
+
+// Iterates through the edges of a vertex in an undirected graph, using the vertex's incidence list.
+// E is csr_edge<EV> or csr_edge<EV> const.
+template <typename E>
+class csr_incidence_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = std::remove_const_t<E>;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = E*;
+  using reference         = E&;
+
+  csr_incidence_iterator() = default;
+  csr_incidence_iterator(E* edges, key_type const* incidence) : edges_(edges), incidence_(incidence) {}
+
+  reference operator*() const { return edges_[*incidence_]; }
+  pointer   operator->() const { return &edges_[*incidence_]; }
+
+  csr_incidence_iterator& operator++() {
+    ++incidence_;
+    return *this;
+  }
+  csr_incidence_iterator operator++(int) {
+    csr_incidence_iterator tmp = *this;
+    ++incidence_;
+    return tmp;
+  }
+
+  bool operator==(csr_incidence_iterator const& rhs) const { return incidence_ == rhs.incidence_; }
+
+private:
+  E*              edges_     = nullptr;
+  key_type const* incidence_ = nullptr;
+};
+
+template <typename VV, typename EV, bool Directed>
+class csr_graph {
+public:
+  using vertex_type       = csr_vertex<VV>;
+  using vertex_value_type = VV;
+  using vertex_set        = std::vector<vertex_type>;
+
+  using edge_type       = csr_edge<EV>;
+  using edge_value_type = EV;
+  using edge_set        = std::vector<edge_type>;
+
+  static constexpr bool directed = Directed;
+
+  struct edge_def {
+    key_type source_key = 0;
+    key_type target_key = 0;
+    EV       value      = EV();
+  };
+
+public:
+  csr_graph() = default;
+
+  // The number of vertices is the larger of vertex_values.size() and the largest key in edge_defs, plus one.
+  csr_graph(std::vector<VV> const& vertex_values, std::vector<edge_def> const& edge_defs) {
+    size_t n = vertex_values.size();
+    for (edge_def const& e : edge_defs)
+      n = std::max(n, static_cast<size_t>(std::max(e.source_key, e.target_key)) + 1);
+    vertices_.reserve(n);
+    for (size_t ukey = 0; ukey < n; ++ukey)
+      vertices_.emplace_back(ukey < vertex_values.size() ? vertex_values[ukey] : VV());
+
+    edges_.reserve(edge_defs.size());
+    for (edge_def const& e : edge_defs)
+      edges_.emplace_back(e.source_key, e.target_key, e.value);
+    std::ranges::stable_sort(edges_, std::less<key_type>(), [](edge_type const& uv) { return uv.source_key; });
+
+    if constexpr (Directed) {
+      for (key_type i = 0; i < edges_.size(); ++i)
+        ++vertices_[edges_[i].source_key].last;
+      for (key_type ukey = 1; ukey < n; ++ukey)
+        vertices_[ukey].last += vertices_[ukey - 1].last;
+      for (key_type ukey = 1; ukey < n; ++ukey)
+        vertices_[ukey].first = vertices_[ukey - 1].last;
+    } else {
+      std::vector<std::vector<key_type>> incidences(n);
+      for (key_type i = 0; i < edges_.size(); ++i) {
+        incidences[edges_[i].source_key].push_back(i);
+        if (edges_[i].target_key != edges_[i].source_key)
+          incidences[edges_[i].target_key].push_back(i);
+      }
+      for (key_type ukey = 0; ukey < n; ++ukey) {
+        vertices_[ukey].first = static_cast<key_type>(incidences_.size());
+        incidences_.insert(incidences_.end(), incidences[ukey].begin(), incidences[ukey].end());
+        vertices_[ukey].last = static_cast<key_type>(incidences_.size());
+      }
+    }
+  }
+
+  csr_graph(std::initializer_list<edge_def> ilist) : csr_graph(std::vector<VV>(), std::vector<edge_def>(ilist)) {}
+
+public:
+  vertex_set&       vertices() { return vertices_; }
+  vertex_set const& vertices() const { return vertices_; }
+  edge_set&         edges() { return edges_; }
+  edge_set const&   edges() const { return edges_; }
+
+  // the edges of ukey: outward edges for a directed graph, or indexes into edges() for an undirected graph
+  auto vertex_edges(key_type ukey) {
+    if constexpr (Directed)
+      return std::ranges::subrange(edges_.begin() + vertices_[ukey].first, edges_.begin() + vertices_[ukey].last);
+    else
+      return std::ranges::subrange(
+            csr_incidence_iterator<edge_type>(edges_.data(), incidences_.data() + vertices_[ukey].first),
+            csr_incidence_iterator<edge_type>(edges_.data(), incidences_.data() + vertices_[ukey].last));
+  }
+  auto vertex_edges(key_type ukey) const {
+    if constexpr (Directed)
+      return std::ranges::subrange(edges_.begin() + vertices_[ukey].first, edges_.begin() + vertices_[ukey].last);
+    else
+      return std::ranges::subrange(
+            csr_incidence_iterator<edge_type const>(edges_.data(), incidences_.data() + vertices_[ukey].first),
+            csr_incidence_iterator<edge_type const>(edges_.data(), incidences_.data() + vertices_[ukey].last));
+  }
+
+  auto   begin() { return vertices_.begin(); }
+  auto   begin() const { return vertices_.begin(); }
+  auto   end() { return vertices_.end(); }
+  auto   end() const { return vertices_.end(); }
+  size_t size() const { return vertices_.size(); }
+
+private:
+  vertex_set            vertices_;
+  edge_set              edges_;
+  std::vector<key_type> incidences_; // undirected only
+};
+
+template <typename G>
+struct is_csr_graph : std::false_type {};
+template <typename VV, typename EV, bool Directed>
+struct is_csr_graph<csr_graph<VV, EV, Directed>> : std::true_type {};
+
+template <typename G>
+concept csr_graph_type = is_csr_graph<std::remove_cvref_t<G>>::value;
+
+//
+// Uniform API free functions
+//
+
+template <csr_graph_type G>
+constexpr auto& vertices(G&& g) {
+  return g.vertices();
+}
+
+template <csr_graph_type G>
+constexpr auto find_vertex(G&& g, key_type ukey) {
+  return g.vertices().begin() + ukey;
+}
+
+template <csr_graph_type G, std::random_access_iterator VI>
+constexpr key_type vertex_key(G&& g, VI u) {
+  return static_cast<key_type>(u - g.vertices().begin());
+}
+
+template <csr_graph_type G>
+constexpr auto& edges(G&& g) {
+  return g.edges();
+}
+
+template <csr_graph_type G, std::random_access_iterator VI>
+constexpr auto edges(G&& g, VI u) {
+  return g.vertex_edges(vertex_key(g, u));
+}
+
+template <csr_graph_type G, typename EI>
+constexpr auto& edge_value(G&&, EI uv) {
+  using edge_value_type = typename std::remove_cvref_t<G>::edge_value_type;
+  using value_type      = std::conditional_t<std::is_const_v<std::remove_reference_t<decltype(*uv)>>,
+                                        edge_value_type const, edge_value_type>;
+  return static_cast<value_type&>(*uv);
+}
+
+template <csr_graph_type G, typename EI>
+constexpr key_type target_key(G&&, EI uv) {
+  return uv->target_key;
+}
+template <csr_graph_type G, typename EI>
+constexpr key_type source_key(G&&, EI uv) {
+  return uv->source_key;
+}
+template <csr_graph_type G, typename EI>
+constexpr auto target(G&& g, EI uv) {
+  return find_vertex(g, target_key(g, uv));
+}
+template <csr_graph_type G, typename EI>
+constexpr auto source(G&& g, EI uv) {
+  return find_vertex(g, source_key(g, uv));
+}
+
+template <csr_graph_type G, typename EI>
+constexpr key_type target_vertex_key(G&& g, EI uv) {
+  return target_key(g, uv);
+}
+template <csr_graph_type G, typename EI>
+constexpr key_type source_vertex_key(G&& g, EI uv) {
+  return source_key(g, uv);
+}
+template <csr_graph_type G, typename EI>
+constexpr auto target_vertex(G&& g, EI uv) {
+  return target(g, uv);
+}
+
+// the other vertex of uv, for the vertex ukey (or u) it was reached from
+template <csr_graph_type G, typename EI>
+constexpr key_type vertex_key(G&&, EI uv, key_type ukey) {
+  return uv->source_key == ukey ? uv->target_key : uv->source_key;
+}
+template <csr_graph_type G, typename EI, std::random_access_iterator VI>
+constexpr key_type vertex_key(G&& g, EI uv, VI u) {
+  return vertex_key(g, uv, vertex_key(g, u));
+}
+template <csr_graph_type G, typename EI, std::random_access_iterator VI>
+constexpr auto vertex(G&& g, EI uv, VI u) {
+  return find_vertex(g, vertex_key(g, uv, u));
+}
+
+} // namespace csr
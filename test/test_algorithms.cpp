@@ -0,0 +1,964 @@
+// The algorithms are tested against csr_graph, which only implements the free functions the algorithms use. This
+// target is built with CPO defined, which the algorithms require.
+#include "csr_graph.hpp"
+#include "graph/range/topological_sort.hpp"
+#include "graph/algorithm/shortest_paths.hpp"
+#include "graph/algorithm/k_shortest_paths.hpp"
+#include "graph/algorithm/contraction_hierarchies.hpp"
+#include "graph/algorithm/distance_table.hpp"
+#include "graph/algorithm/all_pairs_shortest_paths.hpp"
+#include "graph/algorithm/transitive_closure.hpp"
+#include "graph/algorithm/reachability.hpp"
+#include "graph/algorithm/page_rank.hpp"
+#include "graph/algorithm/max_flow.hpp"
+#include "graph/algorithm/components.hpp"
+#include "graph/algorithm/incremental_components.hpp"
+#include "graph/algorithm/biconnected_components.hpp"
+#include "graph/algorithm/triangles.hpp"
+#include "graph/algorithm/k_core.hpp"
+#include "graph/algorithm/minimum_spanning_tree.hpp"
+#include "graph/algorithm/betweenness_centrality.hpp"
+#include "graph/algorithm/community.hpp"
+#include "graph/algorithm/coloring.hpp"
+#include <cmath>
+#include <execution>
+#include <map>
+#include <numeric>
+#include <catch2/catch.hpp>
+
+#define EXPECT_EQ(a, b) REQUIRE((a) == (b))
+#define EXPECT_NE(a, b) REQUIRE((a) != (b))
+#define EXPECT_FALSE(a) REQUIRE(!(a))
+#define EXPECT_TRUE(a) REQUIRE(a);
+
+using std::vector;
+using std::string;
+using std::numeric_limits;
+using std::pair;
+
+using std::ranges::size;
+
+using std::graph::name_value;
+using std::graph::weight_value;
+using std::graph::vertex_t;
+using std::graph::vertex_key_t;
+using std::graph::vertex_iterator_t;
+using std::graph::edge_value_t;
+using std::graph::shortest_distance;
+using std::graph::shortest_path;
+
+using Graph  = csr::csr_graph<name_value, weight_value, true>;
+using UGraph = csr::csr_graph<name_value, weight_value, false>;
+
+struct csr_route {
+  string from;
+  string to;
+  int    km = 0;
+};
+
+// The vertices are the cities, ordered by name
+template <typename G>
+static G create_routes_graph(vector<csr_route> const& routes) {
+  vector<string> cities;
+  for (csr_route const& r : routes) {
+    cities.push_back(r.from);
+    cities.push_back(r.to);
+  }
+  std::ranges::sort(cities);
+  cities.erase(std::unique(cities.begin(), cities.end()), cities.end());
+  auto key_of = [&cities](string const& city) {
+    return static_cast<csr::key_type>(std::ranges::lower_bound(cities, city) - cities.begin());
+  };
+
+  vector<typename G::edge_def> edge_defs;
+  for (csr_route const& r : routes)
+    edge_defs.push_back({key_of(r.from), key_of(r.to), r.km});
+  return G(vector<name_value>(cities.begin(), cities.end()), edge_defs);
+}
+
+// Augsburg, Erfurt, Frankfürt, Karlsruhe, Kassel, Mannheim, München, Nürnberg, Stuttgart, Würzburg
+template <typename G = Graph>
+static G create_germany_routes_graph() {
+  return create_routes_graph<G>({{"Frankfürt", "Mannheim", 85},
+                                 {"Frankfürt", "Würzburg", 217},
+                                 {"Frankfürt", "Kassel", 173},
+                                 {"Mannheim", "Karlsruhe", 80},
+                                 {"Karlsruhe", "Augsburg", 250},
+                                 {"Augsburg", "München", 84},
+                                 {"Würzburg", "Erfurt", 186},
+                                 {"Würzburg", "Nürnberg", 103},
+                                 {"Nürnberg", "Stuttgart", 183},
+                                 {"Nürnberg", "München", 167},
+                                 {"Kassel", "München", 502}});
+}
+
+// a1 --> b1 --> c1 and a2 --> b2 --> c2, with the cycle b1 <--> b2
+static Graph create_dollar_graph() {
+  return create_routes_graph<Graph>(
+        {{"a1", "b1", 100}, {"a2", "b2", 100}, {"b1", "c1", 50}, {"b2", "c2", 90}, {"b1", "b2", 50}, {"b2", "b1", 10}});
+}
+
+static auto weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+
+TEST_CASE("csr topological sort", "[csr][topological sort]") {
+  using std::graph::topological_sort_vertex_range;
+  using std::graph::topological_sort_levels;
+  using key_t = vertex_key_t<Graph>;
+  Graph g     = create_germany_routes_graph();
+
+  // every edge goes from an earlier vertex to a later one
+  topological_sort_vertex_range<Graph> topo(g);
+  vector<size_t>                       pos(size(g), size(g));
+  size_t                               i = 0;
+  for (auto u = topo.begin(); u != topo.end(); ++u)
+    pos[static_cast<size_t>(u.operator->() - g.begin())] = i++;
+  EXPECT_EQ(size(g), topo.visited());
+  EXPECT_FALSE(topo.has_cycle());
+  EXPECT_EQ(0, pos[2]); // Frankfürt
+  for (vertex_iterator_t<Graph> u = g.begin(); u != g.end(); ++u)
+    for (auto uv = std::ranges::begin(edges(g, u)); uv != std::ranges::end(edges(g, u)); ++uv)
+      EXPECT_TRUE(pos[vertex_key(g, u)] < pos[vertex_key(g, uv, u)]);
+
+  // Frankfürt; Kassel, Mannheim, Würzburg; Erfurt, Karlsruhe, Nürnberg; Augsburg, Stuttgart; München
+  vector<key_t>  order(size(g));
+  vector<size_t> levels;
+  EXPECT_EQ(10, topological_sort_levels(std::execution::par, g, order.begin(), back_inserter(levels)));
+  EXPECT_EQ(vector<key_t>({2, 4, 5, 9, 1, 3, 7, 0, 8, 6}), order);
+  EXPECT_EQ(vector<size_t>({1, 4, 7, 9, 10}), levels);
+
+  // b1 <-> b2 is a cycle in the dollar graph, so only a1 & a2 are sorted
+  Graph                                dollar = create_dollar_graph();
+  topological_sort_vertex_range<Graph> dollar_topo(dollar);
+  vector<key_t>                        keys;
+  for (auto u = dollar_topo.begin(); u != dollar_topo.end(); ++u)
+    keys.push_back(static_cast<key_t>(u.operator->() - dollar.begin()));
+  EXPECT_EQ(vector<key_t>({0, 1}), keys);
+  EXPECT_TRUE(dollar_topo.has_cycle());
+
+  levels.clear();
+  EXPECT_EQ(2, topological_sort_levels(std::execution::par, dollar, order.begin(), back_inserter(levels)));
+  EXPECT_EQ(vector<size_t>({2}), levels);
+  EXPECT_EQ(0, order[0]);
+  EXPECT_EQ(1, order[1]);
+}
+
+TEST_CASE("csr spfa & parallel bellman-ford distance", "[csr][bellman-ford][spfa][parallel][distance]") {
+  using std::graph::bellman_ford_shortest_distances;
+  using std::graph::spfa_shortest_distances;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+  short_dists_t expect_dists, short_dists;
+
+  Graph                    g = create_germany_routes_graph();
+  vertex_iterator_t<Graph> u = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "Frankfürt"; });
+
+  auto expect_same = [&expect_dists, &short_dists]() {
+    REQUIRE(expect_dists.size() == short_dists.size());
+    for (size_t i = 0; i < expect_dists.size(); ++i) {
+      EXPECT_EQ(expect_dists[i].first, short_dists[i].first);
+      EXPECT_EQ(expect_dists[i].last, short_dists[i].last);
+      EXPECT_EQ(expect_dists[i].distance, short_dists[i].distance);
+    }
+  };
+
+  for (bool leaves_only : {false, true}) {
+    expect_dists.clear();
+    EXPECT_FALSE(bellman_ford_shortest_distances(g, u, back_inserter(expect_dists), leaves_only, true, weight_fnc));
+    EXPECT_EQ(leaves_only ? 3 : 10, expect_dists.size());
+
+    short_dists.clear();
+    EXPECT_FALSE(spfa_shortest_distances(g, u, back_inserter(short_dists), leaves_only, true, weight_fnc));
+    expect_same();
+
+    short_dists.clear();
+    EXPECT_FALSE(bellman_ford_shortest_distances(std::execution::par, g, u, back_inserter(short_dists), leaves_only,
+                                                 true, weight_fnc));
+    expect_same();
+  }
+
+  // negative weights are supported by all modes (germany routes is acyclic, so there are no negative edge cycles)
+  auto neg_weight_fnc = [](edge_value_t<Graph>& uv) -> int { return -uv.weight; };
+  expect_dists.clear();
+  EXPECT_FALSE(bellman_ford_shortest_distances(g, u, back_inserter(expect_dists), false, true, neg_weight_fnc));
+
+  short_dists.clear();
+  EXPECT_FALSE(spfa_shortest_distances(g, u, back_inserter(short_dists), false, true, neg_weight_fnc));
+  expect_same();
+
+  short_dists.clear();
+  EXPECT_FALSE(bellman_ford_shortest_distances(std::execution::par, g, u, back_inserter(short_dists), false, true,
+                                               neg_weight_fnc));
+  expect_same();
+}
+
+TEST_CASE("csr dijkstra bounded", "[csr][dikjstra][bounded]") {
+  using std::graph::dijkstra_bounded_shortest_distances;
+  using std::graph::dijkstra_bounded_shortest_paths;
+  using std::graph::dijkstra_workspace;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+  using short_path_t  = shortest_path<vertex_iterator_t<Graph>, int>;
+  using short_paths_t = vector<short_path_t>;
+
+  Graph                    g = create_germany_routes_graph();
+  vertex_iterator_t<Graph> u = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "Frankfürt"; });
+
+  // within 250km of Frankfürt, nearest first
+  short_dists_t short_dists;
+  dijkstra_bounded_shortest_distances(g, u, back_inserter(short_dists), 250, numeric_limits<size_t>::max(),
+                                      weight_fnc);
+  REQUIRE(5 == short_dists.size());
+  EXPECT_EQ("Frankfürt", short_dists[0].last->name);
+  EXPECT_EQ(0, short_dists[0].distance);
+  EXPECT_EQ("Mannheim", short_dists[1].last->name);
+  EXPECT_EQ(85, short_dists[1].distance);
+  EXPECT_EQ("Karlsruhe", short_dists[2].last->name);
+  EXPECT_EQ(165, short_dists[2].distance);
+  EXPECT_EQ("Kassel", short_dists[3].last->name);
+  EXPECT_EQ(173, short_dists[3].distance);
+  EXPECT_EQ("Würzburg", short_dists[4].last->name);
+  EXPECT_EQ(217, short_dists[4].distance);
+
+  // 3 nearest, reusing a workspace
+  dijkstra_workspace<vertex_key_t<Graph>, int> ws(size(g));
+  short_dists.clear();
+  dijkstra_bounded_shortest_distances(ws, g, u, back_inserter(short_dists), numeric_limits<int>::max(), 3,
+                                      weight_fnc);
+  REQUIRE(3 == short_dists.size());
+  EXPECT_EQ("Karlsruhe", short_dists[2].last->name);
+
+  // within 350km; Nürnberg is reached through Würzburg
+  short_paths_t short_paths;
+  dijkstra_bounded_shortest_paths(ws, g, u, back_inserter(short_paths), 350, numeric_limits<size_t>::max(),
+                                  weight_fnc);
+  REQUIRE(6 == short_paths.size());
+  EXPECT_EQ(320, short_paths[5].distance);
+  REQUIRE(3 == short_paths[5].path.size());
+  EXPECT_EQ("Frankfürt", short_paths[5].path[0]->name);
+  EXPECT_EQ("Würzburg", short_paths[5].path[1]->name);
+  EXPECT_EQ("Nürnberg", short_paths[5].path[2]->name);
+}
+
+TEST_CASE("csr k shortest paths", "[csr][k shortest paths][path]") {
+  using std::graph::k_shortest_paths;
+  using short_path_t  = shortest_path<vertex_iterator_t<Graph>, int>;
+  using short_paths_t = vector<short_path_t>;
+
+  Graph                    g = create_germany_routes_graph();
+  vertex_iterator_t<Graph> u = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "Frankfürt"; });
+  vertex_iterator_t<Graph> v = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "München"; });
+
+  auto path_names = [](short_path_t const& spath) {
+    vector<string> names;
+    for (auto& w : spath.path)
+      names.push_back(w->name);
+    return names;
+  };
+
+  // only 3 paths exist
+  short_paths_t short_paths;
+  k_shortest_paths(g, u, v, back_inserter(short_paths), 5, weight_fnc);
+  REQUIRE(3 == short_paths.size());
+  EXPECT_EQ(487, short_paths[0].distance);
+  EXPECT_EQ(vector<string>({"Frankfürt", "Würzburg", "Nürnberg", "München"}), path_names(short_paths[0]));
+  EXPECT_EQ(499, short_paths[1].distance);
+  EXPECT_EQ(vector<string>({"Frankfürt", "Mannheim", "Karlsruhe", "Augsburg", "München"}), path_names(short_paths[1]));
+  EXPECT_EQ(675, short_paths[2].distance);
+  EXPECT_EQ(vector<string>({"Frankfürt", "Kassel", "München"}), path_names(short_paths[2]));
+
+  // the first agrees with dijkstra
+  short_paths.clear();
+  k_shortest_paths(g, u, v, back_inserter(short_paths), 1, weight_fnc);
+  REQUIRE(1 == short_paths.size());
+  EXPECT_EQ(487, short_paths[0].distance);
+
+  // unreachable
+  short_paths.clear();
+  k_shortest_paths(g, v, u, back_inserter(short_paths), 3, weight_fnc);
+  EXPECT_TRUE(short_paths.empty());
+}
+
+TEST_CASE("csr contraction hierarchy", "[csr][contraction hierarchy]") {
+  using std::graph::build_contraction_hierarchy;
+  using std::graph::contraction_hierarchy_query;
+  using std::graph::dijkstra_shortest_distances;
+  using key_t         = vertex_key_t<Graph>;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+
+  Graph g = create_germany_routes_graph();
+
+  auto seq_ch = build_contraction_hierarchy(g, weight_fnc);
+  auto par_ch = build_contraction_hierarchy(std::execution::par, g, weight_fnc);
+  for (auto* ch : {&seq_ch, &par_ch}) {
+    contraction_hierarchy_query query(*ch);
+
+    // all distances agree with dijkstra
+    for (vertex_iterator_t<Graph> u = g.begin(); u != g.end(); ++u) {
+      short_dists_t short_dists;
+      dijkstra_shortest_distances(g, u, back_inserter(short_dists), false, weight_fnc);
+      for (short_dist_t& sd : short_dists)
+        EXPECT_EQ(sd.distance, query.distance(vertex_key(g, sd.first), vertex_key(g, sd.last)));
+    }
+
+    // Frankfürt --> München is 487km; paths are unpacked to the original edges
+    vector<key_t> path;
+    EXPECT_EQ(487, query.path(2, 6, back_inserter(path)));
+    REQUIRE(4 == path.size());
+    EXPECT_EQ("Frankfürt", find_vertex(g, path[0])->name);
+    EXPECT_EQ("Würzburg", find_vertex(g, path[1])->name);
+    EXPECT_EQ("Nürnberg", find_vertex(g, path[2])->name);
+    EXPECT_EQ("München", find_vertex(g, path[3])->name);
+
+    // München has no outward edges
+    path.clear();
+    EXPECT_EQ(numeric_limits<int>::max(), query.path(6, 2, back_inserter(path)));
+    EXPECT_TRUE(path.empty());
+  }
+}
+
+TEST_CASE("csr distance table", "[csr][distance table]") {
+  using std::graph::build_contraction_hierarchy;
+  using std::graph::dijkstra_shortest_distances;
+  using std::graph::shortest_distance_table;
+  using key_t         = vertex_key_t<Graph>;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+
+  Graph g = create_germany_routes_graph();
+
+  // Frankfürt, Mannheim & Würzburg to all cities, including unreachable ones
+  vector<key_t> sources = {2, 5, 9};
+  vector<key_t> targets(size(g));
+  std::iota(targets.begin(), targets.end(), key_t(0));
+
+  vector<int> expect(sources.size() * targets.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    short_dists_t short_dists;
+    dijkstra_shortest_distances(g, find_vertex(g, sources[i]), back_inserter(short_dists), false, weight_fnc);
+    for (size_t j = 0; j < targets.size(); ++j)
+      expect[i * targets.size() + j] = short_dists[targets[j]].distance;
+  }
+  EXPECT_EQ(487, expect[0 * targets.size() + 6]);                        // Frankfürt --> München
+  EXPECT_EQ(numeric_limits<int>::max(), expect[2 * targets.size() + 5]); // Würzburg --> Mannheim
+
+  vector<int> table(expect.size());
+  shortest_distance_table(g, sources, targets, table.begin(), weight_fnc);
+  EXPECT_EQ(expect, table);
+
+  std::ranges::fill(table, 0);
+  shortest_distance_table(std::execution::par, g, sources, targets, table.begin(), weight_fnc);
+  EXPECT_EQ(expect, table);
+
+  auto ch = build_contraction_hierarchy(g, weight_fnc);
+  std::ranges::fill(table, 0);
+  shortest_distance_table(ch, sources, targets, table.begin());
+  EXPECT_EQ(expect, table);
+
+  std::ranges::fill(table, 0);
+  shortest_distance_table(std::execution::par, ch, sources, targets, table.begin());
+  EXPECT_EQ(expect, table);
+}
+
+TEST_CASE("csr all pairs shortest distances", "[csr][all pairs][distance]") {
+  using std::graph::bellman_ford_shortest_distances;
+  using std::graph::dijkstra_shortest_distances;
+  using std::graph::floyd_warshall_shortest_distances;
+  using std::graph::johnson_shortest_distances;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+
+  Graph        g = create_germany_routes_graph();
+  size_t const n = size(g);
+
+  vector<int> expect(n * n);
+  for (size_t i = 0; i < n; ++i) {
+    short_dists_t short_dists;
+    dijkstra_shortest_distances(g, g.begin() + i, back_inserter(short_dists), false, weight_fnc);
+    for (size_t j = 0; j < n; ++j)
+      expect[i * n + j] = short_dists[j].distance;
+  }
+  EXPECT_EQ(487, expect[2 * n + 6]);                        // Frankfürt --> München
+  EXPECT_EQ(numeric_limits<int>::max(), expect[9 * n + 5]); // Würzburg --> Mannheim
+
+  vector<int> dist(n * n);
+  EXPECT_FALSE(johnson_shortest_distances(g, dist.begin(), weight_fnc));
+  EXPECT_EQ(expect, dist);
+
+  std::ranges::fill(dist, 0);
+  EXPECT_FALSE(johnson_shortest_distances(std::execution::par, g, dist.begin(), weight_fnc));
+  EXPECT_EQ(expect, dist);
+
+  std::ranges::fill(dist, 0);
+  EXPECT_FALSE(floyd_warshall_shortest_distances(g, dist.begin(), weight_fnc, 3)); // partial tiles
+  EXPECT_EQ(expect, dist);
+
+  std::ranges::fill(dist, 0);
+  EXPECT_FALSE(floyd_warshall_shortest_distances(std::execution::par, g, dist.begin(), weight_fnc, 4));
+  EXPECT_EQ(expect, dist);
+
+  // negative weights without a cycle (the graph is acyclic)
+  auto        neg_weight_fnc = [](edge_value_t<Graph>& uv) -> int { return -uv.weight; };
+  vector<int> neg_expect(n * n);
+  for (size_t i = 0; i < n; ++i) {
+    short_dists_t short_dists;
+    bellman_ford_shortest_distances(g, g.begin() + i, back_inserter(short_dists), false, true, neg_weight_fnc);
+    for (size_t j = 0; j < n; ++j)
+      neg_expect[i * n + j] = short_dists[j].distance;
+  }
+  EXPECT_EQ(-675, neg_expect[2 * n + 6]); // Frankfürt --> München (longest path)
+
+  EXPECT_FALSE(johnson_shortest_distances(g, dist.begin(), neg_weight_fnc));
+  EXPECT_EQ(neg_expect, dist);
+  EXPECT_FALSE(floyd_warshall_shortest_distances(g, dist.begin(), neg_weight_fnc));
+  EXPECT_EQ(neg_expect, dist);
+}
+
+TEST_CASE("csr parallel warshall transitive closure", "[csr][warshall][transitive closure]") {
+  using std::graph::warshall_transitive_closure;
+  using std::graph::reaches;
+
+  using reachs_t      = reaches<Graph>;
+  using reaches_vec_t = vector<reachs_t>;
+  Graph g             = create_germany_routes_graph();
+
+  reaches_vec_t expected, reaches_vec;
+  warshall_transitive_closure(g, back_inserter(expected));
+  warshall_transitive_closure(std::execution::par, g, back_inserter(reaches_vec));
+  EXPECT_EQ(22, reaches_vec.size());
+  EXPECT_EQ(expected.size(), reaches_vec.size());
+  for (size_t i = 0; i < reaches_vec.size(); ++i) {
+    EXPECT_EQ(expected[i].from, reaches_vec[i].from);
+    EXPECT_EQ(expected[i].to, reaches_vec[i].to);
+  }
+}
+
+TEST_CASE("csr warshall transitive closure iterator", "[csr][warshall][transitive closure]") {
+  using std::graph::warshall_transitive_closure;
+  using std::graph::reaches;
+
+  using reachs_t      = reaches<Graph>;
+  using reaches_vec_t = vector<reachs_t>;
+  Graph g             = create_germany_routes_graph();
+
+  // Augsburg, Erfurt, Frankfürt, Karlsruhe, Kassel, Mannheim, München, Nürnberg, Stuttgart, Würzburg
+  vector<pair<size_t, size_t>> const expected = {{0, 6}, {2, 0}, {2, 1}, {2, 3}, {2, 4}, {2, 5}, {2, 6}, {2, 7},
+                                                 {2, 8}, {2, 9}, {3, 0}, {3, 6}, {4, 6}, {5, 0}, {5, 3}, {5, 6},
+                                                 {7, 6}, {7, 8}, {9, 1}, {9, 6}, {9, 7}, {9, 8}};
+  auto keys = [&g](reaches_vec_t const& reaches_vec) {
+    vector<pair<size_t, size_t>> result;
+    for (reachs_t const& r : reaches_vec)
+      result.push_back({static_cast<size_t>(r.from - g.begin()), static_cast<size_t>(r.to - g.begin())});
+    return result;
+  };
+
+  // written through a plain iterator, each row lands in its own element
+  reaches_vec_t reaches_vec(expected.size());
+  warshall_transitive_closure(g, reaches_vec.begin());
+  EXPECT_EQ(expected, keys(reaches_vec));
+
+  reaches_vec_t par_reaches_vec(expected.size());
+  warshall_transitive_closure(std::execution::par, g, par_reaches_vec.begin());
+  EXPECT_EQ(expected, keys(par_reaches_vec));
+}
+
+TEST_CASE("csr condensed transitive closure", "[csr][condensed][transitive closure]") {
+  using std::graph::warshall_transitive_closure;
+  using std::graph::condensed_transitive_closure;
+  using std::graph::condensed_closure;
+  using std::graph::reaches;
+
+  using reachs_t      = reaches<Graph>;
+  using reaches_vec_t = vector<reachs_t>;
+  Graph g             = create_germany_routes_graph();
+
+  auto keys = [&g](reaches_vec_t const& reaches_vec) {
+    vector<pair<size_t, size_t>> result;
+    for (reachs_t const& r : reaches_vec)
+      result.push_back({static_cast<size_t>(r.from - g.begin()), static_cast<size_t>(r.to - g.begin())});
+    std::ranges::sort(result);
+    return result;
+  };
+
+  reaches_vec_t expected, reaches_vec, par_reaches_vec;
+  warshall_transitive_closure(g, back_inserter(expected));
+  condensed_transitive_closure(g, back_inserter(reaches_vec));
+  condensed_transitive_closure(std::execution::par, g, back_inserter(par_reaches_vec));
+  EXPECT_EQ(22, reaches_vec.size());
+  EXPECT_EQ(keys(expected), keys(reaches_vec));
+  EXPECT_EQ(keys(expected), keys(par_reaches_vec));
+
+  // Frankfürt reaches everything except itself; München reaches nothing
+  condensed_closure<Graph> closure(g);
+  EXPECT_EQ(10, closure.components().components());
+  for (vertex_key_t<Graph> vkey = 0; vkey < 10; ++vkey) {
+    EXPECT_EQ(vkey != 2, closure.reaches(2, vkey));
+    EXPECT_FALSE(closure.reaches(6, vkey));
+  }
+  EXPECT_TRUE(closure.reaches(5, 0));  // Mannheim -> Augsburg
+  EXPECT_FALSE(closure.reaches(0, 5)); // Augsburg -> Mannheim
+}
+
+TEST_CASE("csr reachability index", "[csr][reachability]") {
+  using std::graph::condensed_closure;
+  using std::graph::reachability_index;
+
+  Graph                     g = create_germany_routes_graph();
+  condensed_closure<Graph>  closure(g);
+  reachability_index<Graph> index(g);
+  reachability_index<Graph> par_index(std::execution::par, g, 5);
+
+  reachability_index<Graph>::workspace ws(par_index);
+  for (vertex_key_t<Graph> ukey = 0; ukey < 10; ++ukey) {
+    for (vertex_key_t<Graph> vkey = 0; vkey < 10; ++vkey) {
+      EXPECT_EQ(closure.reaches(ukey, vkey), index.reaches(ukey, vkey));
+      EXPECT_EQ(closure.reaches(ukey, vkey), par_index.reaches(ukey, vkey, ws));
+    }
+  }
+  EXPECT_TRUE(index.reaches(2, 6));  // Frankfürt -> München
+  EXPECT_FALSE(index.reaches(6, 2)); // München -> Frankfürt
+  EXPECT_FALSE(index.reaches(4, 4)); // Kassel isn't on a cycle
+}
+
+TEST_CASE("csr page rank", "[csr][page rank][parallel]") {
+  using std::graph::page_rank;
+  using std::graph::personalized_page_rank;
+  Graph g = create_germany_routes_graph();
+
+  vector<double> ranks(size(g)), par_ranks(size(g));
+  size_t const   iterations = page_rank(g, ranks.begin());
+  EXPECT_TRUE(iterations > 1);
+  EXPECT_EQ(iterations, page_rank(std::execution::par, g, par_ranks.begin()));
+  double const total = std::accumulate(ranks.begin(), ranks.end(), 0.0);
+  EXPECT_TRUE(std::abs(total - 1.0) < 1e-9);
+  for (size_t i = 0; i < ranks.size(); ++i)
+    EXPECT_TRUE(std::abs(ranks[i] - par_ranks[i]) < 1e-12);
+
+  // Frankfürt has no incoming edges, so it only gets the restarts & the rank of München
+  EXPECT_TRUE(ranks[2] < ranks[6]);
+  auto const max_key = std::max_element(ranks.begin(), ranks.end()) - ranks.begin();
+  EXPECT_EQ(6, max_key); // München
+
+  // all restarts go to München, which has no outgoing edges, so it keeps all the rank
+  vector<double> personal(size(g), 0.0);
+  personal[6] = 1.0;
+  personalized_page_rank(g, personal.begin(), ranks.begin());
+  EXPECT_TRUE(std::abs(ranks[6] - 1.0) < 1e-6);
+  EXPECT_TRUE(std::abs(ranks[2]) < 1e-6);
+}
+
+TEST_CASE("csr forward push page rank", "[csr][page rank]") {
+  using std::graph::forward_push_page_rank;
+  using std::graph::personalized_page_rank;
+  using fp_t = forward_push_page_rank<Graph>;
+  Graph g    = create_germany_routes_graph();
+  fp_t  fp(g);
+
+  // Frankfürt, then München
+  vector<fp_t::value_type> top;
+  EXPECT_EQ(3, fp.top_k(2, 3, back_inserter(top), 0.85, 1e-6));
+  EXPECT_EQ(2, top[0].key);
+  EXPECT_EQ(6, top[1].key);
+  EXPECT_TRUE((top[0].rank > top[1].rank && top[1].rank >= top[2].rank));
+
+  vector<double> personal(size(g), 0.0), exact(size(g));
+  personal[2] = 1.0;
+  personalized_page_rank(g, personal.begin(), exact.begin(), 0.85, 1e-12, 1000);
+  fp_t::workspace ws(fp);
+  fp.push(2, ws, 0.85, 1e-6);
+  for (vertex_key_t<Graph> ukey = 0; ukey < size(g); ++ukey)
+    EXPECT_TRUE(std::abs(ws.estimate(ukey) - exact[ukey]) < 1e-4);
+
+  // München has no outgoing edges, so nothing else is reached
+  top.clear();
+  EXPECT_EQ(1, fp.top_k(6, 3, back_inserter(top), ws, 0.85, 1e-6));
+  EXPECT_EQ(6, top[0].key);
+  EXPECT_EQ(1, ws.touched());
+}
+
+TEST_CASE("csr max flow", "[csr][max flow][parallel]") {
+  using std::graph::push_relabel_max_flow;
+  using key_t = vertex_key_t<Graph>;
+  Graph g     = create_germany_routes_graph();
+
+  // Frankfürt to München through Mannheim (80), Würzburg & Nürnberg (103) and Kassel (173)
+  key_t const frankfurt = 2, munchen = 6;
+  vector<int> cut(size(g)), par_cut(size(g));
+  EXPECT_EQ(356, push_relabel_max_flow(g, frankfurt, munchen, cut.begin(), weight_fnc));
+  EXPECT_EQ(356, push_relabel_max_flow(std::execution::par, g, frankfurt, munchen, par_cut.begin(), weight_fnc));
+  EXPECT_EQ(cut, par_cut);
+
+  // the cut is Mannheim-Karlsruhe, Würzburg-Nürnberg & Frankfürt-Kassel. Erfurt & Stuttgart
+  // can't reach München, so they're on the source side.
+  // Augsburg, Erfurt, Frankfürt, Karlsruhe, Kassel, Mannheim, München, Nürnberg, Stuttgart, Würzburg
+  EXPECT_EQ(vector<int>({0, 1, 1, 0, 0, 1, 0, 0, 1, 1}), cut);
+
+  // nothing leaves München
+  EXPECT_EQ(0, push_relabel_max_flow(g, munchen, frankfurt, cut.begin(), weight_fnc));
+}
+
+TEST_CASE("csr stongly connected components", "[csr][components][connected]") {
+  using std::graph::strongly_connected_components;
+  using std::graph::condensation;
+  using key_t = vertex_key_t<Graph>;
+  Graph g     = create_dollar_graph();
+
+  // a1, a2, b1, b2, c1, c2
+  vector<uint32_t> comps(size(g));
+  EXPECT_EQ(5, strongly_connected_components(g, comps.begin()));
+  EXPECT_EQ(vector<uint32_t>({3, 4, 2, 2, 0, 1}), comps);
+
+  // numbered by the smallest key in each component
+  EXPECT_EQ(5, strongly_connected_components(std::execution::par, g, comps.begin()));
+  EXPECT_EQ(vector<uint32_t>({0, 1, 2, 2, 3, 4}), comps);
+
+  // components: c1, c2, {b1, b2}, a1, a2
+  condensation<Graph> cond(g);
+  EXPECT_EQ(6, cond.size());
+  EXPECT_EQ(5, cond.components());
+  EXPECT_EQ(2, cond.component(2));
+  EXPECT_EQ(2, cond.component(3));
+  EXPECT_EQ(vector<uint32_t>({2, 3}), vector<uint32_t>(cond.members(2).begin(), cond.members(2).end()));
+  EXPECT_EQ(vector<uint32_t>({0, 1}), vector<uint32_t>(cond.successors(2).begin(), cond.successors(2).end()));
+  EXPECT_EQ(vector<uint32_t>({2}), vector<uint32_t>(cond.successors(3).begin(), cond.successors(3).end()));
+  EXPECT_EQ(vector<uint32_t>({2}), vector<uint32_t>(cond.successors(4).begin(), cond.successors(4).end()));
+  EXPECT_TRUE(cond.successors(0).empty());
+  EXPECT_TRUE(cond.is_cyclic(2));
+  EXPECT_FALSE(cond.is_cyclic(3));
+
+  // a cycle of 1M vertices, and a chain of 1M vertices leading to it, is deeper than the call stack
+  key_t const             n = 1000000;
+  vector<Graph::edge_def> chain_edges;
+  for (key_t ukey = 0; ukey < 2 * n - 1; ++ukey)
+    chain_edges.push_back({ukey, ukey + 1, 1});
+  chain_edges.push_back({2 * n - 1, n, 1}); // close the cycle
+  Graph chain(vector<name_value>(), chain_edges);
+
+  vector<uint32_t> chain_comps(size(chain));
+  EXPECT_EQ(n + 1, strongly_connected_components(chain, chain_comps.begin()));
+  EXPECT_EQ(0, chain_comps[n]);
+  EXPECT_EQ(0, chain_comps[2 * n - 1]);
+  EXPECT_EQ(1, chain_comps[n - 1]);
+  EXPECT_EQ(n, chain_comps[0]);
+
+  EXPECT_EQ(n + 1, strongly_connected_components(std::execution::par, chain, chain_comps.begin()));
+  for (key_t ukey = 0; ukey < n; ++ukey)
+    EXPECT_EQ(ukey, chain_comps[ukey]);
+  EXPECT_EQ(n, chain_comps[n]);
+  EXPECT_EQ(n, chain_comps[2 * n - 1]);
+}
+
+TEST_CASE("csr connected components", "[csr][components][connected]") {
+  using std::graph::component;
+  using std::graph::connected_components;
+  using comp_t = component<UGraph>;
+
+  // components {0,1,2}, {3,4}, {5}, {6,7}
+  UGraph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {3, 4, 1}, {6, 7, 1}};
+  REQUIRE(8 == size(g));
+
+  vector<comp_t> comps;
+  connected_components(g, vertices(g), back_inserter(comps));
+  REQUIRE(size(g) == comps.size());
+  vector<uint32_t> serial(size(g));
+  for (comp_t& comp : comps)
+    serial[vertex_key(g, comp.vertex)] = comp.component_number;
+  EXPECT_EQ(vector<uint32_t>({0, 0, 0, 1, 1, 2, 3, 3}), serial);
+
+  // the component is the smallest vertex key in it
+  vector<uint32_t> par(size(g));
+  connected_components(std::execution::par, g, par.begin());
+  EXPECT_EQ(vector<uint32_t>({0, 0, 0, 3, 3, 5, 6, 6}), par);
+
+  std::ranges::fill(par, 99);
+  connected_components(std::execution::seq, g, par.begin(), 0); // no sampling rounds
+  EXPECT_EQ(vector<uint32_t>({0, 0, 0, 3, 3, 5, 6, 6}), par);
+
+  UGraph           germany = create_germany_routes_graph<UGraph>();
+  vector<uint32_t> germany_comps(size(germany), 99);
+  connected_components(std::execution::par, germany, germany_comps.begin());
+  EXPECT_TRUE(std::ranges::all_of(germany_comps, [](uint32_t c) { return c == 0; }));
+}
+
+TEST_CASE("csr incremental components", "[csr][components][incremental]") {
+  using std::graph::make_disjoint_set;
+  using std::graph::make_concurrent_disjoint_set;
+  using key_t = vertex_key_t<UGraph>;
+
+  // components {0,1,2}, {3,4}, {5}, {6,7}
+  UGraph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {3, 4, 1}, {6, 7, 1}};
+
+  auto ds = make_disjoint_set(g);
+  EXPECT_EQ(8, ds.size());
+  EXPECT_EQ(4, ds.components());
+  EXPECT_TRUE(ds.same_component(0, 2));
+  EXPECT_FALSE(ds.same_component(2, 3));
+  EXPECT_EQ(3, ds.component_size(1));
+  EXPECT_EQ(1, ds.component_size(5));
+
+  // stream edges one at a time, then in a batch
+  EXPECT_TRUE(ds.unite(4, 5));
+  EXPECT_FALSE(ds.unite(3, 5));
+  EXPECT_EQ(3, ds.component_size(3));
+  vector<pair<key_t, key_t>> batch = {{2, 3}, {0, 5}, {8, 9}};
+  ds.resize(10); // new vertices 8 & 9
+  EXPECT_EQ(2, ds.unite(batch));
+  EXPECT_EQ(3, ds.components());
+  EXPECT_EQ(6, ds.component_size(0));
+  EXPECT_TRUE(ds.same_component(1, 4));
+  EXPECT_FALSE(ds.same_component(1, 6));
+
+  auto cds = make_concurrent_disjoint_set(std::execution::par, g);
+  EXPECT_EQ(4, cds.components());
+  EXPECT_EQ(3, cds.component_size(2));
+  EXPECT_TRUE(cds.unite(4, 5));
+  cds.resize(10);
+  EXPECT_EQ(2, cds.unite(std::execution::par, batch));
+  EXPECT_EQ(3, cds.components());
+  EXPECT_EQ(6, cds.component_size(0));
+  EXPECT_TRUE(cds.same_component(1, 4));
+  EXPECT_FALSE(cds.same_component(1, 6));
+
+  UGraph germany    = create_germany_routes_graph<UGraph>();
+  auto   germany_ds = make_disjoint_set(germany);
+  EXPECT_EQ(1, germany_ds.components());
+  EXPECT_EQ(size(germany), germany_ds.component_size(0));
+}
+
+TEST_CASE("csr biconnected components", "[csr][components][biconnected]") {
+  using std::graph::biconnected_components;
+  using std::graph::articulation_points;
+  using std::graph::bridges;
+  using key_t = vertex_key_t<UGraph>;
+
+  // triangles {0,1,2} & {3,4,5} joined by the bridge 2-3, and the bridge 5-6
+  UGraph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 3, 1}, {3, 4, 1}, {4, 5, 1}, {5, 3, 1}, {5, 6, 1}};
+
+  vector<char> art(size(g));
+  EXPECT_EQ(3, articulation_points(g, art.begin()));
+  EXPECT_EQ(vector<char>({0, 0, 1, 1, 0, 1, 0}), art);
+
+  // the element for each edge of each vertex, in order
+  vector<pair<key_t, key_t>> incidences;
+  for (vertex_iterator_t<UGraph> u = g.begin(); u != g.end(); ++u)
+    for (auto uv = std::ranges::begin(edges(g, u)); uv != std::ranges::end(edges(g, u)); ++uv)
+      incidences.push_back({vertex_key(g, u), vertex_key(g, uv, vertex_key(g, u))});
+  REQUIRE(16 == incidences.size());
+
+  vector<uint32_t> comps(incidences.size());
+  vector<char>     is_bridge(incidences.size());
+  EXPECT_EQ(4, biconnected_components(g, comps.begin()));
+  EXPECT_EQ(2, bridges(g, is_bridge.begin()));
+
+  std::map<pair<key_t, key_t>, uint32_t> edge_comp;
+  for (size_t i = 0; i < incidences.size(); ++i) {
+    auto [ukey, vkey] = incidences[i];
+    pair<key_t, key_t> const e{std::min(ukey, vkey), std::max(ukey, vkey)};
+    if (edge_comp.contains(e))
+      EXPECT_EQ(edge_comp[e], comps[i]); // both elements of an edge are in the same component
+    edge_comp[e]           = comps[i];
+    bool const bridge_edge = (e.first == 2 && e.second == 3) || (e.first == 5 && e.second == 6);
+    EXPECT_EQ(bridge_edge, is_bridge[i] != 0);
+  }
+  auto comp_of = [&edge_comp](key_t ukey, key_t vkey) { return edge_comp.at({ukey, vkey}); };
+  EXPECT_EQ(comp_of(0, 1), comp_of(1, 2));
+  EXPECT_EQ(comp_of(0, 1), comp_of(0, 2));
+  EXPECT_EQ(comp_of(3, 4), comp_of(4, 5));
+  EXPECT_EQ(comp_of(3, 4), comp_of(3, 5));
+  EXPECT_NE(comp_of(0, 1), comp_of(3, 4));
+  EXPECT_NE(comp_of(0, 1), comp_of(2, 3));
+  EXPECT_NE(comp_of(3, 4), comp_of(5, 6));
+}
+
+TEST_CASE("csr triangles", "[csr][triangles][parallel]") {
+  using std::graph::triangle_count;
+  using std::graph::vertex_triangle_count;
+  using std::graph::clustering_coefficient;
+
+  // triangles {0,1,2} & {3,4,5} joined by 2-3, and 5-6; 0-1 twice & a self-loop at 4 don't add triangles
+  UGraph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 3, 1}, {3, 4, 1}, {4, 5, 1},
+           {5, 3, 1}, {5, 6, 1}, {1, 0, 1}, {4, 4, 1}};
+
+  EXPECT_EQ(2, triangle_count(g));
+  EXPECT_EQ(2, triangle_count(std::execution::par, g));
+
+  vector<int> counts(size(g)), par_counts(size(g));
+  EXPECT_EQ(2, vertex_triangle_count(g, counts.begin()));
+  EXPECT_EQ(2, vertex_triangle_count(std::execution::par, g, par_counts.begin()));
+  EXPECT_EQ(vector<int>({1, 1, 1, 1, 1, 1, 0}), counts);
+  EXPECT_EQ(counts, par_counts);
+
+  vector<double> coeffs(size(g));
+  EXPECT_EQ(2, clustering_coefficient(g, coeffs.begin()));
+  EXPECT_EQ(1.0, coeffs[0]);
+  EXPECT_EQ(1.0, coeffs[1]);
+  EXPECT_EQ(1.0 / 3.0, coeffs[2]); // 1 of the 3 pairs of 0, 1 & 3 is connected
+  EXPECT_EQ(1.0 / 3.0, coeffs[3]);
+  EXPECT_EQ(1.0, coeffs[4]);
+  EXPECT_EQ(1.0 / 3.0, coeffs[5]);
+  EXPECT_EQ(0.0, coeffs[6]);
+}
+
+TEST_CASE("csr k-core", "[csr][k-core][parallel]") {
+  using std::graph::core_numbers;
+  using std::graph::k_core;
+  using key_t = vertex_key_t<UGraph>;
+
+  // the clique {0,1,2,3}, the triangle {4,5,6} joined to it by 3-4, and 7 joined to 6
+  UGraph g{{0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {1, 2, 1}, {1, 3, 1}, {2, 3, 1},
+           {3, 4, 1}, {4, 5, 1}, {5, 6, 1}, {6, 4, 1}, {6, 7, 1}};
+
+  vector<key_t> cores(size(g)), par_cores(size(g));
+  EXPECT_EQ(3, core_numbers(g, cores.begin()));
+  EXPECT_EQ(3, core_numbers(std::execution::par, g, par_cores.begin()));
+  EXPECT_EQ(vector<key_t>({3, 3, 3, 3, 2, 2, 2, 1}), cores);
+  EXPECT_EQ(cores, par_cores);
+
+  auto          core3 = k_core(g, cores, 3);
+  vector<key_t> keys;
+  for (key_t const ukey : core3.vertex_keys())
+    keys.push_back(ukey);
+  EXPECT_EQ(vector<key_t>({0, 1, 2, 3}), keys);
+  EXPECT_EQ(3, std::ranges::distance(core3.vertex_edges(3))); // not 3-4
+
+  auto core2 = k_core(g, cores, 2);
+  EXPECT_EQ(4, std::ranges::distance(core2.vertex_edges(3)));
+  EXPECT_EQ(2, std::ranges::distance(core2.vertex_edges(6))); // not 6-7
+  EXPECT_FALSE(core2.contains(7));
+}
+
+TEST_CASE("csr minimum spanning tree", "[csr][mst][parallel]") {
+  using std::graph::kruskal_minimum_spanning_tree;
+  using std::graph::filter_kruskal_minimum_spanning_tree;
+  using std::graph::boruvka_minimum_spanning_tree;
+  using mst_edge = std::graph::spanning_tree_edge<UGraph, int>;
+
+  // two components: {0..5} with 4-5 & 5-3 tied, a self-loop at 2 and 0-1 twice (the lighter one is used), and {6,7}
+  UGraph g{{0, 1, 4}, {0, 2, 1}, {1, 2, 2}, {1, 3, 5}, {2, 3, 8}, {3, 4, 3}, {4, 5, 6},
+           {5, 3, 6}, {2, 2, 0}, {1, 0, 1}, {6, 7, 2}};
+  auto weight = [](edge_value_t<UGraph>& uv) { return uv.weight; };
+
+  vector<mst_edge> tree;
+  EXPECT_EQ(18, kruskal_minimum_spanning_tree(g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+  int total = 0;
+  for (mst_edge const& e : tree) {
+    EXPECT_EQ(e.weight, e.edge->weight);
+    total += e.weight;
+  }
+  EXPECT_EQ(18, total);
+
+  tree.clear();
+  EXPECT_EQ(18, kruskal_minimum_spanning_tree(std::execution::par, g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+  tree.clear();
+  EXPECT_EQ(18, filter_kruskal_minimum_spanning_tree(g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+  tree.clear();
+  EXPECT_EQ(18, boruvka_minimum_spanning_tree(std::execution::par, g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+}
+
+TEST_CASE("csr betweenness centrality", "[csr][betweenness][parallel]") {
+  using std::graph::betweenness_centrality;
+  using std::graph::dijkstra_betweenness_centrality;
+
+  // each pair is counted in both directions
+  UGraph         path{{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 1}};
+  vector<double> bc(size(path)), par_bc(size(path));
+  betweenness_centrality(path, bc.begin());
+  betweenness_centrality(std::execution::par, path, par_bc.begin());
+  EXPECT_EQ(vector<double>({0.0, 6.0, 8.0, 6.0, 0.0}), bc);
+  EXPECT_EQ(bc, par_bc);
+
+  // sampling all the vertices is exact, and no pivots give nothing
+  betweenness_centrality(std::execution::par, path, par_bc.begin(), size(path), 42);
+  EXPECT_EQ(bc, par_bc);
+  betweenness_centrality(path, bc.begin(), 0);
+  EXPECT_EQ(vector<double>(size(path), 0.0), bc);
+
+  // a square: unweighted, 0 & 2 are joined through 1 and 3; weighted, 0-3 is longer than 0-1-2-3
+  UGraph         square{{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 0, 4}};
+  vector<double> sq_bc(size(square));
+  betweenness_centrality(square, sq_bc.begin());
+  EXPECT_EQ(vector<double>({1.0, 1.0, 1.0, 1.0}), sq_bc);
+
+  auto weight = [](edge_value_t<UGraph>& uv) { return uv.weight; };
+  dijkstra_betweenness_centrality(square, sq_bc.begin(), weight);
+  EXPECT_EQ(vector<double>({0.0, 4.0, 4.0, 0.0}), sq_bc);
+  dijkstra_betweenness_centrality(std::execution::par, square, sq_bc.begin(), weight);
+  EXPECT_EQ(vector<double>({0.0, 4.0, 4.0, 0.0}), sq_bc);
+}
+
+TEST_CASE("csr communities", "[csr][community][parallel]") {
+  using std::graph::label_propagation;
+  using std::graph::synchronous_label_propagation;
+  using std::graph::louvain_communities;
+  using key_t = vertex_key_t<UGraph>;
+
+  // the cliques {0,1,2,3,4} & {5,6,7,8,9} joined by 4-5, and 10 with only a self-loop
+  UGraph g{{0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {0, 4, 1}, {1, 2, 1}, {1, 3, 1}, {1, 4, 1}, {2, 3, 1},
+           {2, 4, 1}, {3, 4, 1}, {5, 6, 1}, {5, 7, 1}, {5, 8, 1}, {5, 9, 1}, {6, 7, 1}, {6, 8, 1},
+           {6, 9, 1}, {7, 8, 1}, {7, 9, 1}, {8, 9, 1}, {4, 5, 1}, {10, 10, 1}};
+  vector<key_t> const expected({0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2});
+
+  vector<key_t> community(size(g));
+  EXPECT_EQ(3, label_propagation(g, community.begin()));
+  EXPECT_EQ(expected, community);
+  EXPECT_EQ(3, synchronous_label_propagation(g, community.begin()));
+  EXPECT_EQ(expected, community);
+  EXPECT_EQ(3, synchronous_label_propagation(std::execution::par, g, community.begin()));
+  EXPECT_EQ(expected, community);
+
+  auto weight = [](edge_value_t<UGraph>& uv) { return uv.weight; };
+  EXPECT_EQ(3, louvain_communities(g, community.begin(), weight));
+  EXPECT_EQ(expected, community);
+  EXPECT_EQ(3, louvain_communities(std::execution::par, g, community.begin(), weight));
+  EXPECT_EQ(expected, community);
+}
+
+TEST_CASE("csr coloring", "[csr][coloring][parallel]") {
+  using std::graph::greedy_coloring;
+  using std::graph::jones_plassmann_coloring;
+  using std::graph::speculative_coloring;
+  using std::graph::coloring_order;
+  using key_t = vertex_key_t<UGraph>;
+
+  // true if no two neighbors have the same color
+  auto proper = [](UGraph& g, vector<key_t> const& colors) {
+    for (vertex_iterator_t<UGraph> u = g.begin(); u != g.end(); ++u)
+      for (auto uv = std::ranges::begin(edges(g, u)); uv != std::ranges::end(edges(g, u)); ++uv)
+        if (colors[vertex_key(g, u)] == colors[vertex_key(g, uv, vertex_key(g, u))])
+          return false;
+    return true;
+  };
+
+  // the clique {0,1,2,3}, the triangle {4,5,6} joined to it by 3-4, and 7 joined to 6
+  UGraph g{{0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {1, 2, 1}, {1, 3, 1}, {2, 3, 1},
+           {3, 4, 1}, {4, 5, 1}, {5, 6, 1}, {6, 4, 1}, {6, 7, 1}};
+
+  vector<key_t> colors(size(g)), par_colors(size(g));
+  EXPECT_EQ(4, greedy_coloring(g, colors.begin(), coloring_order::natural));
+  EXPECT_EQ(vector<key_t>({0, 1, 2, 3, 0, 1, 2, 0}), colors);
+  for (coloring_order const order : {coloring_order::largest_first, coloring_order::smallest_last}) {
+    EXPECT_EQ(4, greedy_coloring(g, colors.begin(), order));
+    EXPECT_TRUE(proper(g, colors));
+  }
+
+  EXPECT_EQ(4, jones_plassmann_coloring(g, colors.begin()));
+  EXPECT_EQ(4, jones_plassmann_coloring(std::execution::par, g, par_colors.begin()));
+  EXPECT_TRUE(proper(g, colors));
+  EXPECT_EQ(colors, par_colors);
+
+  EXPECT_EQ(4, speculative_coloring(g, colors.begin()));
+  EXPECT_EQ(vector<key_t>({0, 1, 2, 3, 0, 1, 2, 0}), colors);
+  EXPECT_EQ(4, speculative_coloring(std::execution::par, g, par_colors.begin()));
+  EXPECT_TRUE(proper(g, par_colors));
+
+  // a crown: 2i is joined to 2j+1 for i != j, which natural order colors with a color per pair
+  UGraph crown{{0, 3, 1}, {0, 5, 1}, {0, 7, 1}, {2, 1, 1}, {2, 5, 1}, {2, 7, 1},
+               {4, 1, 1}, {4, 3, 1}, {4, 7, 1}, {6, 1, 1}, {6, 3, 1}, {6, 5, 1}};
+  EXPECT_EQ(4, greedy_coloring(crown, colors.begin(), coloring_order::natural));
+  EXPECT_EQ(2, greedy_coloring(crown, colors.begin(), coloring_order::smallest_last));
+  EXPECT_EQ(vector<key_t>({0, 1, 0, 1, 0, 1, 0, 1}), colors);
+}
@@ -2,10 +2,12 @@
 #include "graph/directed_adjacency_vector.hpp"
 #include "graph/range/depth_first_search.hpp"
 #include "graph/range/breadth_first_search.hpp"
+#include "graph/range/topological_sort.hpp"
 #include "graph/algorithm/components.hpp"
 #include "data_routes.hpp"
 #include "using_graph.hpp"
 #include <iostream>
+#include <execution>
 #include <catch2/catch.hpp>
 
 #define EXPECT_EQ(a, b) REQUIRE((a) == (b))
@@ -160,7 +162,7 @@ TEST_CASE("daa dollar stongly connected components", "[daa][dollar][components][
   EXPECT_EQ(6, size(g));
   EXPECT_EQ(6, size(edges(g)));
 
-  using comp_t  = std::component<DollarGraph>;
+  using comp_t  = std::graph::component<DollarGraph>;
   using comps_t = std::vector<comp_t>;
   comps_t comps;
 
@@ -174,10 +176,109 @@ TEST_CASE("daa dollar stongly connected components", "[daa][dollar][components][
   }
 
   /* Output
+    [0] c1
+    [1] c2
+    [2] b2
+    [2] b1
   */
 #  elif TEST_OPTION == TEST_OPTION_GEN
 #  elif TEST_OPTION == TEST_OPTION_TEST
+  REQUIRE(4 == comps.size());
+  EXPECT_EQ(0, comps[0].component_number);
+  EXPECT_EQ("c1", comps[0].vertex->name);
+  EXPECT_EQ(1, comps[1].component_number);
+  EXPECT_EQ("c2", comps[1].vertex->name);
+  EXPECT_EQ(2, comps[2].component_number);
+  EXPECT_EQ("b2", comps[2].vertex->name);
+  EXPECT_EQ(2, comps[3].component_number);
+  EXPECT_EQ("b1", comps[3].vertex->name);
 #  endif
 }
 
+TEST_CASE("daa dollar stongly connected components array", "[daa][dollar][components][connected]") {
+  DollarGraph g = dollar_directed_graph.create_graph();
+
+  // a1, a2, b1, b2, c1, c2
+  vector<uint32_t> comps(size(g));
+  EXPECT_EQ(5, strongly_connected_components(g, comps.begin()));
+  EXPECT_EQ(vector<uint32_t>({3, 4, 2, 2, 0, 1}), comps);
+}
+
+TEST_CASE("daa dollar parallel stongly connected components", "[daa][dollar][components][connected]") {
+  DollarGraph g = dollar_directed_graph.create_graph();
+
+  // a1, a2, b1, b2, c1, c2; numbered by the smallest key in each component
+  vector<uint32_t> comps(size(g));
+  EXPECT_EQ(5, strongly_connected_components(std::execution::par, g, comps.begin()));
+  EXPECT_EQ(vector<uint32_t>({0, 1, 2, 2, 3, 4}), comps);
+}
+
+TEST_CASE("daa dollar condensation", "[daa][dollar][components][connected]") {
+  DollarGraph                           g = dollar_directed_graph.create_graph();
+  std::graph::condensation<DollarGraph> cond(g);
+
+  // components: c1, c2, {b1, b2}, a1, a2
+  EXPECT_EQ(6, cond.size());
+  EXPECT_EQ(5, cond.components());
+  EXPECT_EQ(2, cond.component(2));
+  EXPECT_EQ(2, cond.component(3));
+  EXPECT_EQ(vector<uint32_t>({2, 3}), vector<uint32_t>(cond.members(2).begin(), cond.members(2).end()));
+  EXPECT_EQ(vector<uint32_t>({0, 1}), vector<uint32_t>(cond.successors(2).begin(), cond.successors(2).end()));
+  EXPECT_EQ(vector<uint32_t>({2}), vector<uint32_t>(cond.successors(3).begin(), cond.successors(3).end()));
+  EXPECT_EQ(vector<uint32_t>({2}), vector<uint32_t>(cond.successors(4).begin(), cond.successors(4).end()));
+  EXPECT_TRUE(cond.successors(0).empty());
+  EXPECT_TRUE(cond.is_cyclic(2));
+  EXPECT_FALSE(cond.is_cyclic(3));
+}
+
+TEST_CASE("daa dollar topological sort with cycle", "[daa][dollar][topological sort]") {
+  using std::graph::topological_sort_vertex_range;
+  using std::graph::topological_sort_levels;
+  DollarGraph g = dollar_directed_graph.create_graph();
+
+  // b1 <-> b2 is a cycle, so only a1 & a2 are sorted
+  topological_sort_vertex_range<DollarGraph> topo(g);
+  vector<vertex_key_t<DollarGraph>>          keys;
+  for (auto u = topo.begin(); u != topo.end(); ++u)
+    keys.push_back(static_cast<vertex_key_t<DollarGraph>>(u.operator->() - begin(g)));
+  EXPECT_EQ(vector<vertex_key_t<DollarGraph>>({0, 1}), keys);
+  EXPECT_TRUE(topo.has_cycle());
+
+  vector<uint32_t> order(size(g));
+  vector<size_t>   levels;
+  EXPECT_EQ(2, topological_sort_levels(std::execution::par, g, order.begin(), back_inserter(levels)));
+  EXPECT_EQ(vector<size_t>({2}), levels);
+  EXPECT_EQ(0, order[0]);
+  EXPECT_EQ(1, order[1]);
+}
+
+TEST_CASE("daa deep stongly connected components", "[daa][components][connected]") {
+  // a cycle of 1M vertices, and a chain of 1M vertices leading to it, is deeper than the call stack
+  using ChainGraph = std::graph::directed_adjacency_vector<empty_value, weight_value>;
+  using key_t      = vertex_key_t<ChainGraph>;
+  using chain_kv   = pair<ChainGraph::edge_key_type, int>;
+
+  key_t const      n = 1000000;
+  vector<chain_kv> chain_edges;
+  for (key_t ukey = 0; ukey < 2 * n - 1; ++ukey)
+    chain_edges.push_back({{ukey, ukey + 1}, 1});
+  chain_edges.push_back({{2 * n - 1, n}, 1}); // close the cycle
+  ChainGraph g(
+        chain_edges, [](const chain_kv& kv) { return kv.first; }, [](const chain_kv& kv) { return kv.second; });
+
+  vector<uint32_t> comps(size(g));
+  EXPECT_EQ(n + 1, strongly_connected_components(g, comps.begin()));
+  EXPECT_EQ(0, comps[n]);
+  EXPECT_EQ(0, comps[2 * n - 1]);
+  EXPECT_EQ(1, comps[n - 1]);
+  EXPECT_EQ(n, comps[0]);
+
+  vector<uint32_t> par_comps(size(g));
+  EXPECT_EQ(n + 1, strongly_connected_components(std::execution::par, g, par_comps.begin()));
+  for (key_t ukey = 0; ukey < n; ++ukey)
+    EXPECT_EQ(ukey, par_comps[ukey]);
+  EXPECT_EQ(n, par_comps[n]);
+  EXPECT_EQ(n, par_comps[2 * n - 1]);
+}
+
 #endif // CPO
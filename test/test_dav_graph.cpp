@@ -2,10 +2,22 @@
 #include "graph/directed_adjacency_vector.hpp"
 #include "graph/range/depth_first_search.hpp"
 #include "graph/range/breadth_first_search.hpp"
+#include "graph/range/topological_sort.hpp"
 #include "graph/algorithm/shortest_paths.hpp"
+#include "graph/algorithm/contraction_hierarchies.hpp"
+#include "graph/algorithm/distance_table.hpp"
+#include "graph/algorithm/all_pairs_shortest_paths.hpp"
+#include "graph/algorithm/k_shortest_paths.hpp"
 #include "graph/algorithm/transitive_closure.hpp"
+#include "graph/algorithm/reachability.hpp"
+#include "graph/algorithm/page_rank.hpp"
+#include "graph/algorithm/max_flow.hpp"
 #include "data_routes.hpp"
 #include <iostream>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <execution>
 #include <catch2/catch.hpp>
 #include <range/v3/action/sort.hpp>
 #include "using_graph.hpp"
@@ -979,6 +991,32 @@ TEST_CASE("cass bfs edge", "[dav][bfs][edge]") {
 #  endif
 }
 
+TEST_CASE("dav topological sort", "[dav][topological sort]") {
+  using std::graph::topological_sort_vertex_range;
+  using std::graph::topological_sort_levels;
+  Graph g = create_germany_routes_graph();
+
+  // every edge goes from an earlier vertex to a later one
+  topological_sort_vertex_range<Graph> topo(g);
+  vector<size_t>                       pos(size(g), size(g));
+  size_t                               i = 0;
+  for (auto u = topo.begin(); u != topo.end(); ++u)
+    pos[static_cast<size_t>(u.operator->() - begin(g))] = i++;
+  EXPECT_EQ(size(g), topo.visited());
+  EXPECT_FALSE(topo.has_cycle());
+  EXPECT_EQ(0, pos[2]); // Frankfürt
+  for (vertex_iterator_t<Graph> u = begin(g); u != end(g); ++u)
+    for (auto uv = std::ranges::begin(edges(g, u)); uv != std::ranges::end(edges(g, u)); ++uv)
+      EXPECT_TRUE(pos[vertex_key(g, u)] < pos[vertex_key(g, uv, u)]);
+
+  // Frankfürt; Kassel, Mannheim, Würzburg; Erfurt, Karlsruhe, Nürnberg; Augsburg, Stuttgart; München
+  vector<vtx_key_t> order(size(g));
+  vector<size_t>    levels;
+  EXPECT_EQ(10, topological_sort_levels(std::execution::par, g, order.begin(), back_inserter(levels)));
+  EXPECT_EQ(vector<vtx_key_t>({2, 4, 5, 9, 1, 3, 7, 0, 8, 6}), order);
+  EXPECT_EQ(vector<size_t>({1, 4, 7, 9, 10}), levels);
+}
+
 TEST_CASE("dav dijkstra distance", "[dav][dikjstra][distance]") {
   using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
   using short_dists_t = vector<short_dist_t>;
@@ -1180,6 +1218,55 @@ TEST_CASE("dav bellman-ford distance", "[dav][bellman-ford][distance]") {
 #  endif
 }
 
+TEST_CASE("dav spfa & parallel bellman-ford distance", "[dav][bellman-ford][spfa][parallel][distance]") {
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+  short_dists_t expect_dists, short_dists;
+
+  Graph                    g = create_germany_routes_graph();
+  vertex_iterator_t<Graph> u = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "Frankfürt"; });
+
+  auto weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+
+  auto expect_same = [&expect_dists, &short_dists]() {
+    REQUIRE(expect_dists.size() == short_dists.size());
+    for (size_t i = 0; i < expect_dists.size(); ++i) {
+      EXPECT_EQ(expect_dists[i].first, short_dists[i].first);
+      EXPECT_EQ(expect_dists[i].last, short_dists[i].last);
+      EXPECT_EQ(expect_dists[i].distance, short_dists[i].distance);
+    }
+  };
+
+  for (bool leaves_only : {false, true}) {
+    expect_dists.clear();
+    EXPECT_FALSE(bellman_ford_shortest_distances(g, u, back_inserter(expect_dists), leaves_only, true, weight_fnc));
+    EXPECT_EQ(leaves_only ? 3 : 10, expect_dists.size());
+
+    short_dists.clear();
+    EXPECT_FALSE(spfa_shortest_distances(g, u, back_inserter(short_dists), leaves_only, true, weight_fnc));
+    expect_same();
+
+    short_dists.clear();
+    EXPECT_FALSE(bellman_ford_shortest_distances(std::execution::par, g, u, back_inserter(short_dists), leaves_only,
+                                                 true, weight_fnc));
+    expect_same();
+  }
+
+  // negative weights are supported by all modes (germany routes is acyclic, so there are no negative edge cycles)
+  auto neg_weight_fnc = [](edge_value_t<Graph>& uv) -> int { return -uv.weight; };
+  expect_dists.clear();
+  EXPECT_FALSE(bellman_ford_shortest_distances(g, u, back_inserter(expect_dists), false, true, neg_weight_fnc));
+
+  short_dists.clear();
+  EXPECT_FALSE(spfa_shortest_distances(g, u, back_inserter(short_dists), false, true, neg_weight_fnc));
+  expect_same();
+
+  short_dists.clear();
+  EXPECT_FALSE(bellman_ford_shortest_distances(std::execution::par, g, u, back_inserter(short_dists), false, true,
+                                               neg_weight_fnc));
+  expect_same();
+}
+
 TEST_CASE("dav dijkstra shortest path", "[dav][dikjstra][path]") {
   using std::graph::dijkstra_shortest_paths;
   using std::graph::shortest_path;
@@ -1358,6 +1445,278 @@ TEST_CASE("dav dijkstra shortest path", "[dav][dikjstra][path]") {
 #  endif
 }
 
+TEST_CASE("dav dijkstra bounded", "[dav][dikjstra][bounded]") {
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+  using short_path_t  = shortest_path<vertex_iterator_t<Graph>, int>;
+  using short_paths_t = vector<short_path_t>;
+
+  Graph                    g = create_germany_routes_graph();
+  vertex_iterator_t<Graph> u = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "Frankfürt"; });
+
+  auto weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+
+  // within 250km of Frankfürt, nearest first
+  short_dists_t short_dists;
+  dijkstra_bounded_shortest_distances(g, u, back_inserter(short_dists), 250, numeric_limits<size_t>::max(),
+                                      weight_fnc);
+  REQUIRE(5 == short_dists.size());
+  EXPECT_EQ("Frankfürt", short_dists[0].last->name);
+  EXPECT_EQ(0, short_dists[0].distance);
+  EXPECT_EQ("Mannheim", short_dists[1].last->name);
+  EXPECT_EQ(85, short_dists[1].distance);
+  EXPECT_EQ("Karlsruhe", short_dists[2].last->name);
+  EXPECT_EQ(165, short_dists[2].distance);
+  EXPECT_EQ("Kassel", short_dists[3].last->name);
+  EXPECT_EQ(173, short_dists[3].distance);
+  EXPECT_EQ("Würzburg", short_dists[4].last->name);
+  EXPECT_EQ(217, short_dists[4].distance);
+
+  // 3 nearest, reusing a workspace
+  dijkstra_workspace<vertex_key_t<Graph>, int> ws(size(g));
+  short_dists.clear();
+  dijkstra_bounded_shortest_distances(ws, g, u, back_inserter(short_dists), numeric_limits<int>::max(), 3,
+                                      weight_fnc);
+  REQUIRE(3 == short_dists.size());
+  EXPECT_EQ("Karlsruhe", short_dists[2].last->name);
+
+  // within 350km; Nürnberg is reached through Würzburg
+  short_paths_t short_paths;
+  dijkstra_bounded_shortest_paths(ws, g, u, back_inserter(short_paths), 350, numeric_limits<size_t>::max(),
+                                  weight_fnc);
+  REQUIRE(6 == short_paths.size());
+  EXPECT_EQ(320, short_paths[5].distance);
+  REQUIRE(3 == short_paths[5].path.size());
+  EXPECT_EQ("Frankfürt", short_paths[5].path[0]->name);
+  EXPECT_EQ("Würzburg", short_paths[5].path[1]->name);
+  EXPECT_EQ("Nürnberg", short_paths[5].path[2]->name);
+}
+
+TEST_CASE("dav k shortest paths", "[dav][k shortest paths][path]") {
+  using short_path_t  = shortest_path<vertex_iterator_t<Graph>, int>;
+  using short_paths_t = vector<short_path_t>;
+
+  Graph                    g = create_germany_routes_graph();
+  vertex_iterator_t<Graph> u = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "Frankfürt"; });
+  vertex_iterator_t<Graph> v = std::ranges::find_if(g, [](vertex_t<Graph>& u2) { return u2.name == "München"; });
+
+  auto weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+
+  auto path_names = [](short_path_t const& spath) {
+    vector<string> names;
+    for (auto& w : spath.path)
+      names.push_back(w->name);
+    return names;
+  };
+
+  // only 3 paths exist
+  short_paths_t short_paths;
+  k_shortest_paths(g, u, v, back_inserter(short_paths), 5, weight_fnc);
+  REQUIRE(3 == short_paths.size());
+  EXPECT_EQ(487, short_paths[0].distance);
+  EXPECT_EQ(vector<string>({"Frankfürt", "Würzburg", "Nürnberg", "München"}), path_names(short_paths[0]));
+  EXPECT_EQ(499, short_paths[1].distance);
+  EXPECT_EQ(vector<string>({"Frankfürt", "Mannheim", "Karlsruhe", "Augsburg", "München"}), path_names(short_paths[1]));
+  EXPECT_EQ(675, short_paths[2].distance);
+  EXPECT_EQ(vector<string>({"Frankfürt", "Kassel", "München"}), path_names(short_paths[2]));
+
+  // the first agrees with dijkstra
+  short_paths.clear();
+  k_shortest_paths(g, u, v, back_inserter(short_paths), 1, weight_fnc);
+  REQUIRE(1 == short_paths.size());
+  EXPECT_EQ(487, short_paths[0].distance);
+
+  // unreachable
+  short_paths.clear();
+  k_shortest_paths(g, v, u, back_inserter(short_paths), 3, weight_fnc);
+  EXPECT_TRUE(short_paths.empty());
+}
+
+// Creates a directed n x n grid with edges to the right & down neighbors, with random weights
+// of [1,100]. Used for timing algorithms on a graph larger than the route data.
+using GridGraph = std::graph::directed_adjacency_vector<empty_value, weight_value>;
+static GridGraph create_grid_graph(size_t const n, unsigned const seed = 42) {
+  using key_t   = vertex_key_t<GridGraph>;
+  using grid_kv = pair<GridGraph::edge_key_type, int>;
+  std::mt19937                       gen(seed);
+  std::uniform_int_distribution<int> weight(1, 100);
+  vector<grid_kv>                    grid_edges;
+  for (size_t r = 0; r < n; ++r) {
+    for (size_t c = 0; c < n; ++c) {
+      key_t const ukey = static_cast<key_t>(r * n + c);
+      if (c + 1 < n)
+        grid_edges.push_back({{ukey, static_cast<key_t>(ukey + 1)}, weight(gen)});
+      if (r + 1 < n)
+        grid_edges.push_back({{ukey, static_cast<key_t>(ukey + n)}, weight(gen)});
+    }
+  }
+  return GridGraph(
+        grid_edges, [](const grid_kv& kv) { return kv.first; }, [](const grid_kv& kv) { return kv.second; });
+}
+
+// Hidden test: run with "[benchmark]" to compare the radix heap (integral distance) against
+// the priority_queue (floating-point distance) used by dijkstra_fn.
+TEST_CASE("dav dijkstra radix heap benchmark", "[.][dav][dikjstra][benchmark]") {
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  using int_dist_t = shortest_distance<vertex_iterator_t<GridGraph>, int>;
+  using dbl_dist_t = shortest_distance<vertex_iterator_t<GridGraph>, double>;
+
+  GridGraph                    g = create_grid_graph(500);
+  vertex_iterator_t<GridGraph> u = begin(g);
+  vector<int_dist_t>           int_dists;
+  vector<dbl_dist_t>           dbl_dists;
+  int_dists.reserve(size(g));
+  dbl_dists.reserve(size(g));
+
+  auto int_weight = [](edge_value_t<GridGraph>& uv) -> int { return uv.weight; };
+  auto dbl_weight = [](edge_value_t<GridGraph>& uv) -> double { return uv.weight; };
+
+  auto t0 = steady_clock::now();
+  dijkstra_shortest_distances(g, u, back_inserter(int_dists), false, int_weight);
+  auto t1 = steady_clock::now();
+  dijkstra_shortest_distances(g, u, back_inserter(dbl_dists), false, dbl_weight);
+  auto t2 = steady_clock::now();
+
+  cout << "dijkstra on " << size(g) << " vertices, " << size(edges(g)) << " edges\n"
+       << "  radix heap:     " << duration<double, std::milli>(t1 - t0).count() << "ms\n"
+       << "  priority_queue: " << duration<double, std::milli>(t2 - t1).count() << "ms\n";
+
+  REQUIRE(int_dists.size() == dbl_dists.size());
+  for (size_t i = 0; i < int_dists.size(); ++i)
+    EXPECT_EQ(static_cast<double>(int_dists[i].distance), dbl_dists[i].distance);
+}
+
+TEST_CASE("dav contraction hierarchy", "[dav][contraction hierarchy]") {
+  using std::graph::contraction_hierarchy_query;
+  using key_t         = vertex_key_t<Graph>;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+
+  Graph g          = create_germany_routes_graph();
+  auto  weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+
+  auto seq_ch = build_contraction_hierarchy(g, weight_fnc);
+  auto par_ch = build_contraction_hierarchy(std::execution::par, g, weight_fnc);
+  for (auto* ch : {&seq_ch, &par_ch}) {
+    contraction_hierarchy_query query(*ch);
+
+    // all distances agree with dijkstra
+    for (vertex_iterator_t<Graph> u = g.begin(); u != g.end(); ++u) {
+      short_dists_t short_dists;
+      dijkstra_shortest_distances(g, u, back_inserter(short_dists), false, weight_fnc);
+      for (short_dist_t& sd : short_dists)
+        EXPECT_EQ(sd.distance, query.distance(vertex_key(g, sd.first), vertex_key(g, sd.last)));
+    }
+
+    // Frankfürt --> München is 487km; paths are unpacked to the original edges
+    vector<key_t> path;
+    EXPECT_EQ(487, query.path(2, 6, back_inserter(path)));
+    REQUIRE(4 == path.size());
+    EXPECT_EQ("Frankfürt", find_vertex(g, path[0])->name);
+    EXPECT_EQ("Würzburg", find_vertex(g, path[1])->name);
+    EXPECT_EQ("Nürnberg", find_vertex(g, path[2])->name);
+    EXPECT_EQ("München", find_vertex(g, path[3])->name);
+
+    // München has no outward edges
+    path.clear();
+    EXPECT_EQ(numeric_limits<int>::max(), query.path(6, 2, back_inserter(path)));
+    EXPECT_TRUE(path.empty());
+  }
+}
+
+TEST_CASE("dav distance table", "[dav][distance table]") {
+  using key_t         = vertex_key_t<Graph>;
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+
+  Graph g          = create_germany_routes_graph();
+  auto  weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+
+  // Frankfürt, Mannheim & Würzburg to all cities, including unreachable ones
+  vector<key_t> sources = {2, 5, 9};
+  vector<key_t> targets(size(g));
+  std::iota(targets.begin(), targets.end(), key_t(0));
+
+  vector<int> expect(sources.size() * targets.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    short_dists_t short_dists;
+    dijkstra_shortest_distances(g, find_vertex(g, sources[i]), back_inserter(short_dists), false, weight_fnc);
+    for (size_t j = 0; j < targets.size(); ++j)
+      expect[i * targets.size() + j] = short_dists[targets[j]].distance;
+  }
+  EXPECT_EQ(487, expect[0 * targets.size() + 6]);                        // Frankfürt --> München
+  EXPECT_EQ(numeric_limits<int>::max(), expect[2 * targets.size() + 5]); // Würzburg --> Mannheim
+
+  vector<int> table(expect.size());
+  shortest_distance_table(g, sources, targets, table.begin(), weight_fnc);
+  EXPECT_EQ(expect, table);
+
+  std::ranges::fill(table, 0);
+  shortest_distance_table(std::execution::par, g, sources, targets, table.begin(), weight_fnc);
+  EXPECT_EQ(expect, table);
+
+  auto ch = build_contraction_hierarchy(g, weight_fnc);
+  std::ranges::fill(table, 0);
+  shortest_distance_table(ch, sources, targets, table.begin());
+  EXPECT_EQ(expect, table);
+
+  std::ranges::fill(table, 0);
+  shortest_distance_table(std::execution::par, ch, sources, targets, table.begin());
+  EXPECT_EQ(expect, table);
+}
+
+TEST_CASE("dav all pairs shortest distances", "[dav][all pairs][distance]") {
+  using short_dist_t  = shortest_distance<vertex_iterator_t<Graph>, int>;
+  using short_dists_t = vector<short_dist_t>;
+
+  Graph        g          = create_germany_routes_graph();
+  auto         weight_fnc = [](edge_value_t<Graph>& uv) -> int { return uv.weight; };
+  size_t const n          = size(g);
+
+  vector<int> expect(n * n);
+  for (size_t i = 0; i < n; ++i) {
+    short_dists_t short_dists;
+    dijkstra_shortest_distances(g, begin(g) + i, back_inserter(short_dists), false, weight_fnc);
+    for (size_t j = 0; j < n; ++j)
+      expect[i * n + j] = short_dists[j].distance;
+  }
+  EXPECT_EQ(487, expect[2 * n + 6]);                        // Frankfürt --> München
+  EXPECT_EQ(numeric_limits<int>::max(), expect[9 * n + 5]); // Würzburg --> Mannheim
+
+  vector<int> dist(n * n);
+  EXPECT_FALSE(johnson_shortest_distances(g, dist.begin(), weight_fnc));
+  EXPECT_EQ(expect, dist);
+
+  std::ranges::fill(dist, 0);
+  EXPECT_FALSE(johnson_shortest_distances(std::execution::par, g, dist.begin(), weight_fnc));
+  EXPECT_EQ(expect, dist);
+
+  std::ranges::fill(dist, 0);
+  EXPECT_FALSE(floyd_warshall_shortest_distances(g, dist.begin(), weight_fnc, 3)); // partial tiles
+  EXPECT_EQ(expect, dist);
+
+  std::ranges::fill(dist, 0);
+  EXPECT_FALSE(floyd_warshall_shortest_distances(std::execution::par, g, dist.begin(), weight_fnc, 4));
+  EXPECT_EQ(expect, dist);
+
+  // negative weights without a cycle (the graph is acyclic)
+  auto neg_weight_fnc = [](edge_value_t<Graph>& uv) -> int { return -uv.weight; };
+  vector<int> neg_expect(n * n);
+  for (size_t i = 0; i < n; ++i) {
+    short_dists_t short_dists;
+    bellman_ford_shortest_distances(g, begin(g) + i, back_inserter(short_dists), false, true, neg_weight_fnc);
+    for (size_t j = 0; j < n; ++j)
+      neg_expect[i * n + j] = short_dists[j].distance;
+  }
+  EXPECT_EQ(-675, neg_expect[2 * n + 6]); // Frankfürt --> München (longest path)
+
+  EXPECT_FALSE(johnson_shortest_distances(g, dist.begin(), neg_weight_fnc));
+  EXPECT_EQ(neg_expect, dist);
+  EXPECT_FALSE(floyd_warshall_shortest_distances(g, dist.begin(), neg_weight_fnc));
+  EXPECT_EQ(neg_expect, dist);
+}
+
 TEST_CASE("dav bellman-fort shortest path", "[dav][bellman-ford][path]") {
   using std::graph::bellman_ford_shortest_paths;
   using std::graph::shortest_path;
@@ -1802,4 +2161,165 @@ TEST_CASE("dav warshall transitive closure", "[dav][warshall][transitive closure
 #  endif
 }
 
+TEST_CASE("dav parallel warshall transitive closure", "[dav][warshall][transitive closure]") {
+  using std::graph::warshall_transitive_closure;
+  using std::graph::reaches;
+
+  using reachs_t      = reaches<Graph>;
+  using reaches_vec_t = vector<reachs_t>;
+  Graph g             = create_germany_routes_graph();
+
+  reaches_vec_t expected, reaches_vec;
+  warshall_transitive_closure(g, back_inserter(expected));
+  warshall_transitive_closure(std::execution::par, g, back_inserter(reaches_vec));
+  EXPECT_EQ(22, reaches_vec.size());
+  EXPECT_EQ(expected.size(), reaches_vec.size());
+  for (size_t i = 0; i < reaches_vec.size(); ++i) {
+    EXPECT_EQ(expected[i].from, reaches_vec[i].from);
+    EXPECT_EQ(expected[i].to, reaches_vec[i].to);
+  }
+}
+
+TEST_CASE("dav condensed transitive closure", "[dav][condensed][transitive closure]") {
+  using std::graph::warshall_transitive_closure;
+  using std::graph::condensed_transitive_closure;
+  using std::graph::condensed_closure;
+  using std::graph::reaches;
+
+  using reachs_t      = reaches<Graph>;
+  using reaches_vec_t = vector<reachs_t>;
+  Graph g             = create_germany_routes_graph();
+
+  auto keys = [&g](reaches_vec_t const& reaches_vec) {
+    vector<pair<size_t, size_t>> result;
+    for (reachs_t const& r : reaches_vec)
+      result.push_back({static_cast<size_t>(r.from - begin(g)), static_cast<size_t>(r.to - begin(g))});
+    std::ranges::sort(result);
+    return result;
+  };
+
+  reaches_vec_t expected, reaches_vec, par_reaches_vec;
+  warshall_transitive_closure(g, back_inserter(expected));
+  condensed_transitive_closure(g, back_inserter(reaches_vec));
+  condensed_transitive_closure(std::execution::par, g, back_inserter(par_reaches_vec));
+  EXPECT_EQ(22, reaches_vec.size());
+  EXPECT_EQ(keys(expected), keys(reaches_vec));
+  EXPECT_EQ(keys(expected), keys(par_reaches_vec));
+
+  // Frankfürt reaches everything except itself; München reaches nothing
+  condensed_closure<Graph> closure(g);
+  EXPECT_EQ(10, closure.components().components());
+  for (vertex_key_t<Graph> vkey = 0; vkey < 10; ++vkey) {
+    EXPECT_EQ(vkey != 2, closure.reaches(2, vkey));
+    EXPECT_FALSE(closure.reaches(6, vkey));
+  }
+  EXPECT_TRUE(closure.reaches(5, 0));  // Mannheim -> Augsburg
+  EXPECT_FALSE(closure.reaches(0, 5)); // Augsburg -> Mannheim
+}
+
+TEST_CASE("dav reachability index", "[dav][reachability]") {
+  using std::graph::condensed_closure;
+  using std::graph::reachability_index;
+
+  Graph                     g = create_germany_routes_graph();
+  condensed_closure<Graph>  closure(g);
+  reachability_index<Graph> index(g);
+  reachability_index<Graph> par_index(std::execution::par, g, 5);
+
+  reachability_index<Graph>::workspace ws(par_index);
+  for (vertex_key_t<Graph> ukey = 0; ukey < 10; ++ukey) {
+    for (vertex_key_t<Graph> vkey = 0; vkey < 10; ++vkey) {
+      EXPECT_EQ(closure.reaches(ukey, vkey), index.reaches(ukey, vkey));
+      EXPECT_EQ(closure.reaches(ukey, vkey), par_index.reaches(ukey, vkey, ws));
+    }
+  }
+  EXPECT_TRUE(index.reaches(2, 6));  // Frankfürt -> München
+  EXPECT_FALSE(index.reaches(6, 2)); // München -> Frankfürt
+  EXPECT_FALSE(index.reaches(4, 4)); // Kassel isn't on a cycle
+}
+
+TEST_CASE("dav page rank", "[dav][page rank][parallel]") {
+  using std::graph::page_rank;
+  using std::graph::personalized_page_rank;
+  Graph g = create_germany_routes_graph();
+
+  vector<double> ranks(size(g)), par_ranks(size(g));
+  size_t const   iterations = page_rank(g, ranks.begin());
+  EXPECT_TRUE(iterations > 1);
+  EXPECT_EQ(iterations, page_rank(std::execution::par, g, par_ranks.begin()));
+  double const total = std::accumulate(ranks.begin(), ranks.end(), 0.0);
+  EXPECT_TRUE(std::abs(total - 1.0) < 1e-9);
+  for (size_t i = 0; i < ranks.size(); ++i)
+    EXPECT_TRUE(std::abs(ranks[i] - par_ranks[i]) < 1e-12);
+
+  // Frankfürt has no incoming edges, so it only gets the restarts & the rank of München
+  EXPECT_TRUE(ranks[2] < ranks[6]);
+  auto const max_key = std::max_element(ranks.begin(), ranks.end()) - ranks.begin();
+  EXPECT_EQ(6, max_key); // München
+
+  // all restarts go to München, which has no outgoing edges, so it keeps all the rank
+  vector<double> personal(size(g), 0.0);
+  personal[6] = 1.0;
+  personalized_page_rank(g, personal.begin(), ranks.begin());
+  EXPECT_TRUE(std::abs(ranks[6] - 1.0) < 1e-6);
+  EXPECT_TRUE(std::abs(ranks[2]) < 1e-6);
+}
+
+TEST_CASE("dav forward push page rank", "[dav][page rank]") {
+  using std::graph::forward_push_page_rank;
+  using std::graph::personalized_page_rank;
+  using fp_t = forward_push_page_rank<Graph>;
+  Graph g = create_germany_routes_graph();
+  fp_t  fp(g);
+
+  // Frankfürt, then München
+  vector<fp_t::value_type> top;
+  EXPECT_EQ(3, fp.top_k(2, 3, back_inserter(top), 0.85, 1e-6));
+  EXPECT_EQ(2, top[0].key);
+  EXPECT_EQ(6, top[1].key);
+  EXPECT_TRUE((top[0].rank > top[1].rank && top[1].rank >= top[2].rank));
+
+  vector<double> personal(size(g), 0.0), exact(size(g));
+  personal[2] = 1.0;
+  personalized_page_rank(g, personal.begin(), exact.begin(), 0.85, 1e-12, 1000);
+  fp_t::workspace ws(fp);
+  fp.push(2, ws, 0.85, 1e-6);
+  for (vertex_key_t<Graph> ukey = 0; ukey < size(g); ++ukey)
+    EXPECT_TRUE(std::abs(ws.estimate(ukey) - exact[ukey]) < 1e-4);
+
+  // München has no outgoing edges, so nothing else is reached
+  top.clear();
+  EXPECT_EQ(1, fp.top_k(6, 3, back_inserter(top), ws, 0.85, 1e-6));
+  EXPECT_EQ(6, top[0].key);
+  EXPECT_EQ(1, ws.touched());
+}
+
+TEST_CASE("dav max flow", "[dav][max flow][parallel]") {
+  using std::graph::push_relabel_max_flow;
+  using key_t  = vertex_key_t<Graph>;
+  Graph g      = create_germany_routes_graph();
+  auto  key_of = [&g](string const& name) {
+    auto u = std::ranges::find_if(g, [&name](vertex_t<Graph>& u2) { return u2.name == name; });
+    return static_cast<key_t>(u - begin(g));
+  };
+  auto capacity = [](edge_value_t<Graph>& uv) { return uv.weight; };
+
+  // Frankfürt to München through Mannheim (80), Würzburg & Nürnberg (103) and Kassel (173)
+  key_t const frankfurt = key_of("Frankfürt"), munchen = key_of("München");
+  vector<int> cut(size(g)), par_cut(size(g));
+  EXPECT_EQ(356, push_relabel_max_flow(g, frankfurt, munchen, cut.begin(), capacity));
+  EXPECT_EQ(356, push_relabel_max_flow(std::execution::par, g, frankfurt, munchen, par_cut.begin(), capacity));
+  EXPECT_EQ(cut, par_cut);
+
+  // the cut is Mannheim-Karlsruhe, Würzburg-Nürnberg & Frankfürt-Kassel. Erfurt & Stuttgart
+  // can't reach München, so they're on the source side.
+  for (string const name : {"Frankfürt", "Mannheim", "Würzburg", "Erfurt", "Stuttgart"})
+    EXPECT_TRUE(cut[key_of(name)]);
+  for (string const name : {"Karlsruhe", "Augsburg", "Kassel", "Nürnberg", "München"})
+    EXPECT_FALSE(cut[key_of(name)]);
+
+  // nothing leaves München
+  EXPECT_EQ(0, push_relabel_max_flow(g, munchen, frankfurt, cut.begin(), capacity));
+}
+
 #endif // CPO
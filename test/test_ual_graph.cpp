@@ -3,9 +3,22 @@
 #include "graph/range/depth_first_search.hpp"
 #include "graph/range/breadth_first_search.hpp"
 #include "graph/algorithm/shortest_paths.hpp"
+#include "graph/algorithm/components.hpp"
+#include "graph/algorithm/incremental_components.hpp"
+#include "graph/algorithm/biconnected_components.hpp"
+#include "graph/algorithm/triangles.hpp"
+#include "graph/algorithm/k_core.hpp"
+#include "graph/algorithm/minimum_spanning_tree.hpp"
+#include "graph/algorithm/betweenness_centrality.hpp"
+#include "graph/algorithm/community.hpp"
+#include "graph/algorithm/coloring.hpp"
 #include "data_routes.hpp"
 #include "using_graph.hpp"
 #include <iostream>
+#include <map>
+#include <random>
+#include <chrono>
+#include <execution>
 #include <catch2/catch.hpp>
 
 
@@ -1539,4 +1552,365 @@ TEST_CASE("ual bellman-ford path", "[ual][bellman-ford][path]") {
 #  endif
 }
 
+TEST_CASE("ual connected components", "[ual][components][connected]") {
+  using std::graph::component;
+  using std::graph::connected_components;
+  using comp_t = component<Graph>;
+
+  // components {0,1,2}, {3,4}, {5}, {6,7}
+  Graph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {3, 4, 1}, {6, 7, 1}};
+  REQUIRE(8 == size(g));
+
+  vector<comp_t> comps;
+  connected_components(g, vertices(g), back_inserter(comps));
+  REQUIRE(size(g) == comps.size());
+  vector<uint32_t> serial(size(g));
+  for (comp_t& comp : comps)
+    serial[vertex_key(g, comp.vertex)] = comp.component_number;
+  EXPECT_EQ(vector<uint32_t>({0, 0, 0, 1, 1, 2, 3, 3}), serial);
+
+  // the component is the smallest vertex key in it
+  vector<uint32_t> par(size(g));
+  connected_components(std::execution::par, g, par.begin());
+  EXPECT_EQ(vector<uint32_t>({0, 0, 0, 3, 3, 5, 6, 6}), par);
+
+  std::ranges::fill(par, 99);
+  connected_components(std::execution::seq, g, par.begin(), 0); // no sampling rounds
+  EXPECT_EQ(vector<uint32_t>({0, 0, 0, 3, 3, 5, 6, 6}), par);
+
+  Graph            germany = create_germany_routes_graph();
+  vector<uint32_t> germany_comps(size(germany), 99);
+  connected_components(std::execution::par, germany, germany_comps.begin());
+  EXPECT_TRUE(std::ranges::all_of(germany_comps, [](uint32_t c) { return c == 0; }));
+}
+
+TEST_CASE("ual incremental components", "[ual][components][incremental]") {
+  using std::graph::make_disjoint_set;
+  using std::graph::make_concurrent_disjoint_set;
+  using key_t = vertex_key_t<Graph>;
+
+  // components {0,1,2}, {3,4}, {5}, {6,7}
+  Graph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {3, 4, 1}, {6, 7, 1}};
+
+  auto ds = make_disjoint_set(g);
+  EXPECT_EQ(8, ds.size());
+  EXPECT_EQ(4, ds.components());
+  EXPECT_TRUE(ds.same_component(0, 2));
+  EXPECT_FALSE(ds.same_component(2, 3));
+  EXPECT_EQ(3, ds.component_size(1));
+  EXPECT_EQ(1, ds.component_size(5));
+
+  // stream edges one at a time, then in a batch
+  EXPECT_TRUE(ds.unite(4, 5));
+  EXPECT_FALSE(ds.unite(3, 5));
+  EXPECT_EQ(3, ds.component_size(3));
+  vector<pair<key_t, key_t>> batch = {{2, 3}, {0, 5}, {8, 9}};
+  ds.resize(10); // new vertices 8 & 9
+  EXPECT_EQ(2, ds.unite(batch));
+  EXPECT_EQ(3, ds.components());
+  EXPECT_EQ(6, ds.component_size(0));
+  EXPECT_TRUE(ds.same_component(1, 4));
+  EXPECT_FALSE(ds.same_component(1, 6));
+
+  auto cds = make_concurrent_disjoint_set(std::execution::par, g);
+  EXPECT_EQ(4, cds.components());
+  EXPECT_EQ(3, cds.component_size(2));
+  EXPECT_TRUE(cds.unite(4, 5));
+  cds.resize(10);
+  EXPECT_EQ(2, cds.unite(std::execution::par, batch));
+  EXPECT_EQ(3, cds.components());
+  EXPECT_EQ(6, cds.component_size(0));
+  EXPECT_TRUE(cds.same_component(1, 4));
+  EXPECT_FALSE(cds.same_component(1, 6));
+
+  Graph germany    = create_germany_routes_graph();
+  auto  germany_ds = make_disjoint_set(germany);
+  EXPECT_EQ(1, germany_ds.components());
+  EXPECT_EQ(size(germany), germany_ds.component_size(0));
+}
+
+TEST_CASE("ual biconnected components", "[ual][components][biconnected]") {
+  using std::graph::biconnected_components;
+  using std::graph::articulation_points;
+  using std::graph::bridges;
+  using key_t = vertex_key_t<Graph>;
+
+  // triangles {0,1,2} & {3,4,5} joined by the bridge 2-3, and the bridge 5-6
+  Graph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 3, 1}, {3, 4, 1}, {4, 5, 1}, {5, 3, 1}, {5, 6, 1}};
+
+  vector<char> art(size(g));
+  EXPECT_EQ(3, articulation_points(g, art.begin()));
+  EXPECT_EQ(vector<char>({0, 0, 1, 1, 0, 1, 0}), art);
+
+  // the element for each edge of each vertex, in order
+  vector<pair<key_t, key_t>> incidences;
+  for (vertex_iterator_t<Graph> u = begin(g); u != end(g); ++u)
+    for (auto uv = std::ranges::begin(edges(g, u)); uv != std::ranges::end(edges(g, u)); ++uv)
+      incidences.push_back({vertex_key(g, u), vertex_key(g, uv, vertex_key(g, u))});
+  REQUIRE(16 == incidences.size());
+
+  vector<uint32_t> comps(incidences.size());
+  vector<char>     is_bridge(incidences.size());
+  EXPECT_EQ(4, biconnected_components(g, comps.begin()));
+  EXPECT_EQ(2, bridges(g, is_bridge.begin()));
+
+  std::map<pair<key_t, key_t>, uint32_t> edge_comp;
+  for (size_t i = 0; i < incidences.size(); ++i) {
+    auto [ukey, vkey] = incidences[i];
+    pair<key_t, key_t> const e{std::min(ukey, vkey), std::max(ukey, vkey)};
+    if (edge_comp.contains(e))
+      EXPECT_EQ(edge_comp[e], comps[i]); // both elements of an edge are in the same component
+    edge_comp[e]           = comps[i];
+    bool const bridge_edge = (e.first == 2 && e.second == 3) || (e.first == 5 && e.second == 6);
+    EXPECT_EQ(bridge_edge, is_bridge[i] != 0);
+  }
+  auto comp_of = [&edge_comp](key_t ukey, key_t vkey) { return edge_comp.at({ukey, vkey}); };
+  EXPECT_EQ(comp_of(0, 1), comp_of(1, 2));
+  EXPECT_EQ(comp_of(0, 1), comp_of(0, 2));
+  EXPECT_EQ(comp_of(3, 4), comp_of(4, 5));
+  EXPECT_EQ(comp_of(3, 4), comp_of(3, 5));
+  EXPECT_NE(comp_of(0, 1), comp_of(3, 4));
+  EXPECT_NE(comp_of(0, 1), comp_of(2, 3));
+  EXPECT_NE(comp_of(3, 4), comp_of(5, 6));
+}
+
+// Hidden test: run with "[benchmark]" to compare the serial connected components against the
+// parallel Afforest implementation on a random graph with 1M vertices and 4M edges.
+TEST_CASE("ual connected components benchmark", "[.][ual][components][benchmark]") {
+  using std::graph::component;
+  using std::graph::connected_components;
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  using key_t  = vertex_key_t<Graph>;
+  using ekv_t  = pair<Graph::edge_key_type, int>;
+  using comp_t = component<Graph>;
+
+  size_t const                         n = 1000000;
+  std::mt19937                         gen(42);
+  std::uniform_int_distribution<key_t> key(0, static_cast<key_t>(n - 1));
+  vector<ekv_t>                        rand_edges;
+  rand_edges.reserve(4 * n);
+  for (size_t i = 0; i < 4 * n; ++i)
+    rand_edges.push_back({{key(gen), key(gen)}, 1});
+  Graph g(
+        rand_edges, [](const ekv_t& kv) { return kv.first; }, [](const ekv_t& kv) { return kv.second; });
+
+  vector<comp_t> comps;
+  comps.reserve(size(g));
+  vector<uint32_t> par(size(g));
+
+  auto t0 = steady_clock::now();
+  connected_components(g, vertices(g), back_inserter(comps));
+  auto t1 = steady_clock::now();
+  connected_components(std::execution::par, g, par.begin());
+  auto t2 = steady_clock::now();
+
+  cout << "connected components on " << size(g) << " vertices, " << size(edges(g)) << " edges\n"
+       << "  serial:   " << duration<double, std::milli>(t1 - t0).count() << "ms\n"
+       << "  afforest: " << duration<double, std::milli>(t2 - t1).count() << "ms\n";
+
+  // same partition: each serial component maps to exactly one afforest component
+  REQUIRE(size(g) == comps.size());
+  vector<uint32_t> comp_map(comps.back().component_number + 1, numeric_limits<uint32_t>::max());
+  for (comp_t& comp : comps) {
+    uint32_t& mapped = comp_map[comp.component_number];
+    if (mapped == numeric_limits<uint32_t>::max())
+      mapped = par[vertex_key(g, comp.vertex)];
+    EXPECT_EQ(mapped, par[vertex_key(g, comp.vertex)]);
+  }
+}
+
+TEST_CASE("ual triangles", "[ual][triangles][parallel]") {
+  using std::graph::triangle_count;
+  using std::graph::vertex_triangle_count;
+  using std::graph::clustering_coefficient;
+
+  // triangles {0,1,2} & {3,4,5} joined by 2-3, and 5-6; 0-1 twice & a self-loop at 4 don't add triangles
+  Graph g{{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {2, 3, 1}, {3, 4, 1}, {4, 5, 1},
+          {5, 3, 1}, {5, 6, 1}, {1, 0, 1}, {4, 4, 1}};
+
+  EXPECT_EQ(2, triangle_count(g));
+  EXPECT_EQ(2, triangle_count(std::execution::par, g));
+
+  vector<int> counts(size(g)), par_counts(size(g));
+  EXPECT_EQ(2, vertex_triangle_count(g, counts.begin()));
+  EXPECT_EQ(2, vertex_triangle_count(std::execution::par, g, par_counts.begin()));
+  EXPECT_EQ(vector<int>({1, 1, 1, 1, 1, 1, 0}), counts);
+  EXPECT_EQ(counts, par_counts);
+
+  vector<double> coeffs(size(g));
+  EXPECT_EQ(2, clustering_coefficient(g, coeffs.begin()));
+  EXPECT_EQ(1.0, coeffs[0]);
+  EXPECT_EQ(1.0, coeffs[1]);
+  EXPECT_EQ(1.0 / 3.0, coeffs[2]); // 1 of the 3 pairs of 0, 1 & 3 is connected
+  EXPECT_EQ(1.0 / 3.0, coeffs[3]);
+  EXPECT_EQ(1.0, coeffs[4]);
+  EXPECT_EQ(1.0 / 3.0, coeffs[5]);
+  EXPECT_EQ(0.0, coeffs[6]);
+}
+
+TEST_CASE("ual k-core", "[ual][k-core][parallel]") {
+  using std::graph::core_numbers;
+  using std::graph::k_core;
+  using key_t = vertex_key_t<Graph>;
+
+  // the clique {0,1,2,3}, the triangle {4,5,6} joined to it by 3-4, and 7 joined to 6
+  Graph g{{0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {1, 2, 1}, {1, 3, 1}, {2, 3, 1},
+          {3, 4, 1}, {4, 5, 1}, {5, 6, 1}, {6, 4, 1}, {6, 7, 1}};
+
+  vector<key_t> cores(size(g)), par_cores(size(g));
+  EXPECT_EQ(3, core_numbers(g, cores.begin()));
+  EXPECT_EQ(3, core_numbers(std::execution::par, g, par_cores.begin()));
+  EXPECT_EQ(vector<key_t>({3, 3, 3, 3, 2, 2, 2, 1}), cores);
+  EXPECT_EQ(cores, par_cores);
+
+  auto          core3 = k_core(g, cores, 3);
+  vector<key_t> keys;
+  for (key_t const ukey : core3.vertex_keys())
+    keys.push_back(ukey);
+  EXPECT_EQ(vector<key_t>({0, 1, 2, 3}), keys);
+  EXPECT_EQ(3, std::ranges::distance(core3.vertex_edges(3))); // not 3-4
+
+  auto core2 = k_core(g, cores, 2);
+  EXPECT_EQ(4, std::ranges::distance(core2.vertex_edges(3)));
+  EXPECT_EQ(2, std::ranges::distance(core2.vertex_edges(6))); // not 6-7
+  EXPECT_FALSE(core2.contains(7));
+}
+
+TEST_CASE("ual minimum spanning tree", "[ual][mst][parallel]") {
+  using std::graph::kruskal_minimum_spanning_tree;
+  using std::graph::filter_kruskal_minimum_spanning_tree;
+  using std::graph::boruvka_minimum_spanning_tree;
+  using mst_edge = std::graph::spanning_tree_edge<Graph, int>;
+
+  // two components: {0..5} with 4-5 & 5-3 tied, a self-loop at 2 and 0-1 twice (the lighter one is used), and {6,7}
+  Graph g{{0, 1, 4}, {0, 2, 1}, {1, 2, 2}, {1, 3, 5}, {2, 3, 8}, {3, 4, 3}, {4, 5, 6},
+          {5, 3, 6}, {2, 2, 0}, {1, 0, 1}, {6, 7, 2}};
+  auto weight = [](edge_value_t<Graph>& uv) { return uv.weight; };
+
+  vector<mst_edge> tree;
+  EXPECT_EQ(18, kruskal_minimum_spanning_tree(g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+  int total = 0;
+  for (mst_edge const& e : tree) {
+    EXPECT_EQ(e.weight, e.edge->weight);
+    total += e.weight;
+  }
+  EXPECT_EQ(18, total);
+
+  tree.clear();
+  EXPECT_EQ(18, kruskal_minimum_spanning_tree(std::execution::par, g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+  tree.clear();
+  EXPECT_EQ(18, filter_kruskal_minimum_spanning_tree(g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+  tree.clear();
+  EXPECT_EQ(18, boruvka_minimum_spanning_tree(std::execution::par, g, back_inserter(tree), weight));
+  EXPECT_EQ(6, tree.size());
+}
+
+TEST_CASE("ual betweenness centrality", "[ual][betweenness][parallel]") {
+  using std::graph::betweenness_centrality;
+  using std::graph::dijkstra_betweenness_centrality;
+
+  // each pair is counted in both directions
+  Graph          path{{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 4, 1}};
+  vector<double> bc(size(path)), par_bc(size(path));
+  betweenness_centrality(path, bc.begin());
+  betweenness_centrality(std::execution::par, path, par_bc.begin());
+  EXPECT_EQ(vector<double>({0.0, 6.0, 8.0, 6.0, 0.0}), bc);
+  EXPECT_EQ(bc, par_bc);
+
+  // sampling all the vertices is exact, and no pivots give nothing
+  betweenness_centrality(std::execution::par, path, par_bc.begin(), size(path), 42);
+  EXPECT_EQ(bc, par_bc);
+  betweenness_centrality(path, bc.begin(), 0);
+  EXPECT_EQ(vector<double>(size(path), 0.0), bc);
+
+  // a square: unweighted, 0 & 2 are joined through 1 and 3; weighted, 0-3 is longer than 0-1-2-3
+  Graph          square{{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 0, 4}};
+  vector<double> sq_bc(size(square));
+  betweenness_centrality(square, sq_bc.begin());
+  EXPECT_EQ(vector<double>({1.0, 1.0, 1.0, 1.0}), sq_bc);
+
+  auto weight = [](edge_value_t<Graph>& uv) { return uv.weight; };
+  dijkstra_betweenness_centrality(square, sq_bc.begin(), weight);
+  EXPECT_EQ(vector<double>({0.0, 4.0, 4.0, 0.0}), sq_bc);
+  dijkstra_betweenness_centrality(std::execution::par, square, sq_bc.begin(), weight);
+  EXPECT_EQ(vector<double>({0.0, 4.0, 4.0, 0.0}), sq_bc);
+}
+
+TEST_CASE("ual communities", "[ual][community][parallel]") {
+  using std::graph::label_propagation;
+  using std::graph::synchronous_label_propagation;
+  using std::graph::louvain_communities;
+  using key_t = vertex_key_t<Graph>;
+
+  // the cliques {0,1,2,3,4} & {5,6,7,8,9} joined by 4-5, and 10 with only a self-loop
+  Graph g{{0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {0, 4, 1}, {1, 2, 1}, {1, 3, 1}, {1, 4, 1}, {2, 3, 1},
+          {2, 4, 1}, {3, 4, 1}, {5, 6, 1}, {5, 7, 1}, {5, 8, 1}, {5, 9, 1}, {6, 7, 1}, {6, 8, 1},
+          {6, 9, 1}, {7, 8, 1}, {7, 9, 1}, {8, 9, 1}, {4, 5, 1}, {10, 10, 1}};
+  vector<key_t> const expected({0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 2});
+
+  vector<key_t> community(size(g));
+  EXPECT_EQ(3, label_propagation(g, community.begin()));
+  EXPECT_EQ(expected, community);
+  EXPECT_EQ(3, synchronous_label_propagation(g, community.begin()));
+  EXPECT_EQ(expected, community);
+  EXPECT_EQ(3, synchronous_label_propagation(std::execution::par, g, community.begin()));
+  EXPECT_EQ(expected, community);
+
+  auto weight = [](edge_value_t<Graph>& uv) { return uv.weight; };
+  EXPECT_EQ(3, louvain_communities(g, community.begin(), weight));
+  EXPECT_EQ(expected, community);
+  EXPECT_EQ(3, louvain_communities(std::execution::par, g, community.begin(), weight));
+  EXPECT_EQ(expected, community);
+}
+
+TEST_CASE("ual coloring", "[ual][coloring][parallel]") {
+  using std::graph::greedy_coloring;
+  using std::graph::jones_plassmann_coloring;
+  using std::graph::speculative_coloring;
+  using std::graph::coloring_order;
+  using key_t = vertex_key_t<Graph>;
+
+  // true if no two neighbors have the same color
+  auto proper = [](Graph& g, vector<key_t> const& colors) {
+    for (vertex_iterator_t<Graph> u = begin(g); u != end(g); ++u)
+      for (auto uv = std::ranges::begin(edges(g, u)); uv != std::ranges::end(edges(g, u)); ++uv)
+        if (colors[vertex_key(g, u)] == colors[vertex_key(g, uv, vertex_key(g, u))])
+          return false;
+    return true;
+  };
+
+  // the clique {0,1,2,3}, the triangle {4,5,6} joined to it by 3-4, and 7 joined to 6
+  Graph g{{0, 1, 1}, {0, 2, 1}, {0, 3, 1}, {1, 2, 1}, {1, 3, 1}, {2, 3, 1},
+          {3, 4, 1}, {4, 5, 1}, {5, 6, 1}, {6, 4, 1}, {6, 7, 1}};
+
+  vector<key_t> colors(size(g)), par_colors(size(g));
+  EXPECT_EQ(4, greedy_coloring(g, colors.begin(), coloring_order::natural));
+  EXPECT_EQ(vector<key_t>({0, 1, 2, 3, 0, 1, 2, 0}), colors);
+  for (coloring_order const order : {coloring_order::largest_first, coloring_order::smallest_last}) {
+    EXPECT_EQ(4, greedy_coloring(g, colors.begin(), order));
+    EXPECT_TRUE(proper(g, colors));
+  }
+
+  EXPECT_EQ(4, jones_plassmann_coloring(g, colors.begin()));
+  EXPECT_EQ(4, jones_plassmann_coloring(std::execution::par, g, par_colors.begin()));
+  EXPECT_TRUE(proper(g, colors));
+  EXPECT_EQ(colors, par_colors);
+
+  EXPECT_EQ(4, speculative_coloring(g, colors.begin()));
+  EXPECT_EQ(vector<key_t>({0, 1, 2, 3, 0, 1, 2, 0}), colors);
+  EXPECT_EQ(4, speculative_coloring(std::execution::par, g, par_colors.begin()));
+  EXPECT_TRUE(proper(g, par_colors));
+
+  // a crown: 2i is joined to 2j+1 for i != j, which natural order colors with a color per pair
+  Graph crown{{0, 3, 1}, {0, 5, 1}, {0, 7, 1}, {2, 1, 1}, {2, 5, 1}, {2, 7, 1},
+              {4, 1, 1}, {4, 3, 1}, {4, 7, 1}, {6, 1, 1}, {6, 3, 1}, {6, 5, 1}};
+  EXPECT_EQ(4, greedy_coloring(crown, colors.begin(), coloring_order::natural));
+  EXPECT_EQ(2, greedy_coloring(crown, colors.begin(), coloring_order::smallest_last));
+  EXPECT_EQ(vector<key_t>({0, 1, 0, 1, 0, 1, 0, 1}), colors);
+}
+
 #endif // CPO